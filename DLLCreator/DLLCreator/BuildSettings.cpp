@@ -0,0 +1,330 @@
+#include "BuildSettings.h"
+
+#include "../Utils/Process.h"
+#include "../Utils/Json.h"
+
+#include <algorithm> /* std::min, std::max */
+#include <chrono> /* std::chrono::seconds */
+#include <cstdlib> /* std::getenv, std::strtoull */
+#include <filesystem> /* std::filesystem::path */
+#include <fstream> /* std::ifstream */
+#include <iostream> /* std::cout */
+#include <sstream> /* std::istringstream */
+#include <thread> /* std::thread::hardware_concurrency */
+#include <utility> /* std::pair */
+
+namespace DLL
+{
+	namespace
+	{
+		/* Runs one of the small commands of a build tool, which should never take long, and collects what it prints.
+		Returns false and fills in error if it could not be run or failed */
+		bool RunTool(const std::vector<std::string>& arguments, const std::vector<std::string>& environment, std::vector<std::string>& lines, std::string& error)
+		{
+			Utils::Process process{};
+
+			if (!process.Start(arguments, {}, environment, error))
+			{
+				return false;
+			}
+
+			const Utils::Process::Result result(process.Wait([&lines](const std::string_view line)
+				{
+					lines.emplace_back(line);
+				}, std::chrono::seconds(10)));
+
+			if (result.ExitCode != 0)
+			{
+				error = arguments[0] + " " + arguments[1] + (result.bTimedOut ? " did not finish" : " failed with exit code " + std::to_string(result.ExitCode));
+				return false;
+			}
+
+			return true;
+		}
+
+		/* The major and minor version program --version prints first, 0.0 if it could not be run */
+		std::pair<int, int> ReadVersion(const std::string& program)
+		{
+			std::vector<std::string> lines{};
+
+			if (std::string error{}; !RunTool({ program, "--version" }, {}, lines, error) || lines.empty())
+			{
+				return {};
+			}
+
+			/* "1.13.1" for Ninja, "GNU Make 4.4.1" for make */
+			const size_t start(lines.front().find_first_of("0123456789"));
+
+			if (start == std::string::npos)
+			{
+				return {};
+			}
+
+			std::pair<int, int> version{};
+			char dot{};
+
+			std::istringstream stream(lines.front().substr(start));
+			stream >> version.first >> dot >> version.second;
+
+			return version;
+		}
+
+		/* The value of a variable in the CMake cache of a build folder, empty if the folder was never configured or it is not there */
+		std::string ReadCacheVariable(const std::string& buildPath, const std::string& key)
+		{
+			std::ifstream cache(std::filesystem::path(buildPath) / "CMakeCache.txt");
+
+			for (std::string line{}; std::getline(cache, line);)
+			{
+				if (line.compare(0, key.size(), key) == 0)
+				{
+					return line.substr(key.size());
+				}
+			}
+
+			return {};
+		}
+
+		/* The counts of every kind of source in one of the sccache statistics, { "counts": { "C/C++": 12 } } */
+		size_t SumCounts(const Utils::Json::Value* pStatistic)
+		{
+			size_t sum{};
+
+			if (const Utils::Json::Value* pCounts = pStatistic != nullptr ? pStatistic->Find("counts") : nullptr)
+			{
+				for (const auto& [kind, count] : pCounts->GetObject())
+				{
+					sum += static_cast<size_t>(count.GetNumber());
+				}
+			}
+
+			return sum;
+		}
+
+		/* What CMake ends up using when no generator is passed */
+		std::string GetImplicitGenerator()
+		{
+			if (const char* const pGenerator = std::getenv("CMAKE_GENERATOR"); pGenerator != nullptr && *pGenerator != '\0')
+			{
+				return pGenerator;
+			}
+
+#ifdef _WIN32
+			return "Visual Studio";
+#else
+			return "Unix Makefiles";
+#endif
+		}
+
+		/* Multi-config generators pick the configuration at build time, the others need CMAKE_BUILD_TYPE at configure time */
+		bool IsMultiConfig(const std::string& generator)
+		{
+			return generator.compare(0, 13, "Visual Studio") == 0 || generator == "Xcode" || generator == "Ninja Multi-Config";
+		}
+	}
+
+	BuildSettings::BuildSettings(const size_t nrOfJobs, const size_t nrOfConcurrentBuilds)
+		: NrOfConcurrentBuilds(std::max<size_t>(nrOfConcurrentBuilds, 1))
+	{
+		/* Ninja starts compiling sooner than make and keeps every core busy. On Windows it needs the compiler environment
+		of a Developer Command Prompt, without cl in PATH the Visual Studio generator is the one that works.
+		CMAKE_GENERATOR is what the user picked, so that is left alone */
+		const char* const pGenerator(std::getenv("CMAKE_GENERATOR"));
+
+		if ((pGenerator == nullptr || *pGenerator == '\0') && !Utils::FindProgram("ninja").empty())
+		{
+#ifdef _WIN32
+			if (!Utils::FindProgram("cl").empty())
+#endif
+			{
+				DefaultGenerator = "Ninja";
+			}
+		}
+
+		if (nrOfJobs > 0)
+		{
+			NrOfJobs = nrOfJobs;
+		}
+		else
+		{
+			NrOfJobs = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+			/* More compiles than fit in memory swap, which is slower than running fewer of them */
+			if (const uint64_t availableMemory(Utils::GetAvailableMemory()); availableMemory > 0)
+			{
+				NrOfJobs = std::max<size_t>(std::min<uint64_t>(NrOfJobs, availableMemory / MemoryPerCompile), 1);
+			}
+		}
+
+		/* With fewer jobs than builds every build gets one job anyway, a jobserver would not have any slots to hand out */
+		if (NrOfConcurrentBuilds == 1 || NrOfJobs <= NrOfConcurrentBuilds)
+		{
+			return;
+		}
+
+		bNinjaJoinsJobServer = !DefaultGenerator.empty() && ReadVersion("ninja") >= std::make_pair(1, 13);
+#ifndef _WIN32
+		/* The make CMake picks for Unix Makefiles, it looks for gmake first */
+		const std::string make(!Utils::FindProgram("gmake").empty() ? "gmake" : "make");
+		bMakeJoinsJobServer = ReadVersion(make) >= std::make_pair(4, 4);
+#endif
+
+		if (bNinjaJoinsJobServer || bMakeJoinsJobServer)
+		{
+			if (std::string error{}; !JobServer.Create(NrOfJobs - NrOfConcurrentBuilds, error))
+			{
+				std::cout << "The builds get an even part of the jobs instead of sharing them, " << error << "\n";
+			}
+		}
+	}
+
+	BuildSettings::Commands BuildSettings::GetCommands(const std::string& sourcePath, const std::string& buildPath, const std::string& generator) const
+	{
+		Commands commands{};
+		commands.Configure = { "cmake", "-S", sourcePath, "-B", buildPath };
+		commands.Build = { "cmake", "--build", buildPath, "--config", "Release" };
+
+		std::string usedGenerator(generator);
+
+		/* Only a generator the manifest asks for is passed to a build folder that was configured before, CMake says what to do when they differ */
+		if (!usedGenerator.empty())
+		{
+			commands.Configure.insert(commands.Configure.end(), { "-G", usedGenerator });
+		}
+		else if (usedGenerator = ReadCacheVariable(buildPath, "CMAKE_GENERATOR:INTERNAL="); usedGenerator.empty())
+		{
+			if (!DefaultGenerator.empty())
+			{
+				usedGenerator = DefaultGenerator;
+				commands.Configure.insert(commands.Configure.end(), { "-G", usedGenerator });
+			}
+			else
+			{
+				usedGenerator = GetImplicitGenerator();
+			}
+		}
+
+		if (!IsMultiConfig(usedGenerator))
+		{
+			commands.Configure.push_back("-DCMAKE_BUILD_TYPE=Release");
+		}
+
+		const bool bJoinsJobServer(JobServer.IsCreated() &&
+			((usedGenerator.compare(0, 5, "Ninja") == 0 && bNinjaJoinsJobServer) || (usedGenerator == "Unix Makefiles" && bMakeJoinsJobServer)));
+
+		if (bJoinsJobServer)
+		{
+			/* Without -j the build tool takes its jobs from the jobserver */
+			commands.BuildEnvironment.push_back("MAKEFLAGS=" + JobServer.GetMakeFlags());
+			commands.Description = usedGenerator + ", " + std::to_string(NrOfJobs) + " jobs shared with the other builds";
+		}
+		else
+		{
+			const size_t nrOfBuildJobs(std::max<size_t>(NrOfJobs / NrOfConcurrentBuilds, 1));
+
+			commands.Build.insert(commands.Build.end(), { "--parallel", std::to_string(nrOfBuildJobs) });
+			commands.Description = usedGenerator + ", " + std::to_string(nrOfBuildJobs) + (nrOfBuildJobs == 1 ? " job" : " jobs");
+		}
+
+		return commands;
+	}
+	bool CompilerCache::Find(const std::string& buildPath, const std::string& directory, CompilerCache& cache)
+	{
+		/* Where find_program() in the root CMake file found it */
+		const std::string programPath(ReadCacheVariable(buildPath, "CompilerCache:FILEPATH="));
+
+		if (programPath.empty() || programPath.find("NOTFOUND") != std::string::npos)
+		{
+			return false;
+		}
+
+		const std::string name(std::filesystem::path(programPath).stem().string());
+
+		cache.ProgramPath = programPath;
+		cache.Name = name.find("sccache") != std::string::npos ? "sccache" : "ccache";
+		cache.Directory = directory;
+
+		return true;
+	}
+
+	std::string CompilerCache::GetEnvironment() const
+	{
+		return (Name == "sccache" ? "SCCACHE_DIR=" : "CCACHE_DIR=") + Directory;
+	}
+
+	bool CompilerCache::ZeroStatistics(std::string& error) const
+	{
+		std::vector<std::string> lines{};
+		return RunTool({ ProgramPath, "--zero-stats" }, { GetEnvironment() }, lines, error);
+	}
+
+	bool CompilerCache::ReadStatistics(Statistics& statistics, std::string& error) const
+	{
+		statistics = Statistics{};
+		std::vector<std::string> lines{};
+
+		if (Name == "sccache")
+		{
+			if (!RunTool({ ProgramPath, "--show-stats", "--stats-format=json" }, { GetEnvironment() }, lines, error))
+			{
+				return false;
+			}
+
+			std::string text{};
+			for (const std::string& line : lines)
+			{
+				text.append(line + "\n");
+			}
+
+			Utils::Json::Value document{};
+
+			if (!Utils::Json::Parse(text, document, error))
+			{
+				return false;
+			}
+
+			const Utils::Json::Value* pStatistics(document.Find("stats"));
+
+			if (pStatistics == nullptr)
+			{
+				error = "sccache printed no statistics";
+				return false;
+			}
+
+			statistics.NrOfHits = SumCounts(pStatistics->Find("cache_hits"));
+			statistics.NrOfMisses = SumCounts(pStatistics->Find("cache_misses"));
+
+			return true;
+		}
+
+		/* One "name<TAB>value" line per counter, older versions of ccache call the hits cache_hit_direct and cache_hit_preprocessed */
+		if (!RunTool({ ProgramPath, "--print-stats" }, { GetEnvironment() }, lines, error))
+		{
+			return false;
+		}
+
+		for (const std::string& line : lines)
+		{
+			const size_t tab(line.find('\t'));
+
+			if (tab == std::string::npos)
+			{
+				continue;
+			}
+
+			const std::string counter(line.substr(0, tab));
+			const size_t value(static_cast<size_t>(std::strtoull(line.c_str() + tab + 1, nullptr, 10)));
+
+			if (counter == "direct_cache_hit" || counter == "preprocessed_cache_hit" || counter == "cache_hit_direct" || counter == "cache_hit_preprocessed")
+			{
+				statistics.NrOfHits += value;
+			}
+			else if (counter == "cache_miss")
+			{
+				statistics.NrOfMisses += value;
+			}
+		}
+
+		return true;
+	}
+}
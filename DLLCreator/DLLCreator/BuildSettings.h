@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../Utils/JobServer.h"
+
+#include <cstdint> /* uint64_t */
+#include <string> /* std::string */
+#include <vector> /* std::vector */
+
+namespace DLL
+{
+	/* How the CMake builds of one run are generated and how many compile jobs they may run, shared by every project built in it */
+	class BuildSettings final
+	{
+	public:
+		/* What to run for the CMake configure and build of one project */
+		struct Commands final
+		{
+			std::vector<std::string> Configure{};
+			std::vector<std::string> Build{};
+			std::vector<std::string> BuildEnvironment{}; /* "NAME=value", on top of the environment of this process */
+			std::string Description{}; /* the generator and the jobs, for the output */
+		};
+
+		/* Looks for Ninja and works out how many compile jobs the builds may run: nrOfJobs, or when that is 0 one per hardware thread,
+		but never more than there is available memory for. nrOfConcurrentBuilds is how many projects may build at the same time,
+		builds that can join a jobserver share the jobs through one, the others get an even part of them */
+		BuildSettings(const size_t nrOfJobs, const size_t nrOfConcurrentBuilds);
+
+		BuildSettings(const BuildSettings&) = delete;
+		BuildSettings(BuildSettings&&) noexcept = delete;
+		BuildSettings& operator=(const BuildSettings&) = delete;
+		BuildSettings& operator=(BuildSettings&&) noexcept = delete;
+
+		/* generator is what the manifest asks for, empty to use Ninja when it was found and the default of CMake otherwise.
+		Without one, a build folder that was configured before keeps its generator, CMake refuses to switch */
+		Commands GetCommands(const std::string& sourcePath, const std::string& buildPath, const std::string& generator) const;
+
+		size_t GetNumberOfJobs() const { return NrOfJobs; }
+
+		/* What a single compile is assumed to need, a translation unit of a big C++ project easily takes this much */
+		inline static constexpr uint64_t MemoryPerCompile{ uint64_t(1) << 30 };
+
+	private:
+		std::string DefaultGenerator{}; /* "Ninja" if it was found, empty for the default of CMake */
+		size_t NrOfJobs{};
+		size_t NrOfConcurrentBuilds{};
+		bool bNinjaJoinsJobServer{}; /* Ninja 1.13 and up */
+		bool bMakeJoinsJobServer{}; /* GNU make 4.4 and up, older ones only know the jobserver through inherited pipes */
+		Utils::JobServer JobServer{};
+	};
+
+	/* The ccache or sccache a configured build folder compiles through, as the root CMake file picked it.
+	The cache keeps its files in a folder of the project, so it is not shared with other projects and what it counts is this project alone.
+	sccache is the exception: one server does the caching for every build, it keeps the folder and the counts the first build gave it */
+	class CompilerCache final
+	{
+	public:
+		struct Statistics final
+		{
+			size_t NrOfHits{};
+			size_t NrOfMisses{};
+		};
+
+		/* Returns false if the build folder at buildPath does not compile through a compiler cache.
+		directory is where the cache keeps its files */
+		static bool Find(const std::string& buildPath, const std::string& directory, CompilerCache& cache);
+
+		/* "ccache" or "sccache" */
+		const std::string& GetName() const { return Name; }
+		/* What the environment of the build needs to point the cache at its folder */
+		std::string GetEnvironment() const;
+
+		/* Both return false and fill in error if the cache could not be run */
+		bool ZeroStatistics(std::string& error) const;
+		bool ReadStatistics(Statistics& statistics, std::string& error) const;
+
+	private:
+		std::string ProgramPath{};
+		std::string Name{};
+		std::string Directory{};
+	};
+}
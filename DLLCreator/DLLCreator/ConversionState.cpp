@@ -0,0 +1,203 @@
+#include "ConversionState.h"
+
+#include "../Utils/Utils.h"
+#include "../Utils/FileIO.h"
+#include "../Utils/Hash.h"
+#include "../Utils/Json.h"
+
+#include <algorithm> /* std::sort */
+#include <charconv> /* std::from_chars, std::to_chars */
+#include <system_error> /* std::error_code */
+#include <vector> /* std::vector */
+
+namespace DLL
+{
+	namespace
+	{
+		/* Json numbers are doubles, which can not hold 64 bits, so every 64 bit value is stored as a hexadecimal string */
+		std::string ToHex(const uint64_t value)
+		{
+			char buffer[16]{};
+			const std::to_chars_result result(std::to_chars(buffer, buffer + sizeof(buffer), value, 16));
+			return std::string(buffer, result.ptr);
+		}
+
+		bool FromHex(const Utils::Json::Value* pValue, uint64_t& value)
+		{
+			if (pValue == nullptr || !pValue->IsString())
+			{
+				return false;
+			}
+
+			const std::string& text(pValue->GetString());
+			const std::from_chars_result result(std::from_chars(text.data(), text.data() + text.size(), value, 16));
+			return result.ec == std::errc{} && result.ptr == text.data() + text.size();
+		}
+
+		bool GetFileTimes(const std::filesystem::path& filePath, uint64_t& size, int64_t& modifiedTime)
+		{
+			std::error_code error{};
+
+			size = std::filesystem::file_size(filePath, error);
+
+			if (error)
+			{
+				return false;
+			}
+
+			modifiedTime = std::filesystem::last_write_time(filePath, error).time_since_epoch().count();
+			return !error;
+		}
+	}
+
+	bool ConversionState::Load(const std::string& statePath, ConversionState& state, std::string& error)
+	{
+		state.Files.clear();
+
+		/* No state just means nothing was converted yet */
+		std::error_code existsError{};
+		if (!std::filesystem::exists(statePath, existsError))
+		{
+			return true;
+		}
+
+		std::basic_string<BYTE> fileContents{};
+
+		if (!Utils::IO::ReadFile(statePath, fileContents))
+		{
+			error = "could not read " + statePath;
+			return false;
+		}
+
+		Utils::Json::Value document{};
+
+		if (!Utils::Json::Parse(Utils::IO::ConvertToRegularString(fileContents), document, error))
+		{
+			return false;
+		}
+
+		/* A state of an older version describes output this version would not produce */
+		if (const Utils::Json::Value* pVersion = document.Find("version"); pVersion == nullptr || pVersion->GetNumber() != Version)
+		{
+			return true;
+		}
+
+		const Utils::Json::Value* pFiles(document.Find("files"));
+
+		if (pFiles == nullptr || !pFiles->IsArray())
+		{
+			error = "\"files\" must be an array";
+			return false;
+		}
+
+		for (const Utils::Json::Value& file : pFiles->GetArray())
+		{
+			const Utils::Json::Value* pPath(file.Find("path"));
+			const Utils::Json::Value* pSize(file.Find("size"));
+			FileState fileState{};
+			uint64_t modifiedTime{};
+
+			if (pPath == nullptr || !pPath->IsString() || pSize == nullptr || !pSize->IsNumber() ||
+				!FromHex(file.Find("modified"), modifiedTime) || !FromHex(file.Find("hash"), fileState.Hash) || !FromHex(file.Find("decision"), fileState.DecisionHash))
+			{
+				state.Files.clear();
+				error = "every entry in \"files\" needs a path, size, modified, hash and decision";
+				return false;
+			}
+
+			fileState.Size = static_cast<uint64_t>(pSize->GetNumber());
+			fileState.ModifiedTime = static_cast<int64_t>(modifiedTime);
+
+			state.Files.emplace(pPath->GetString(), fileState);
+		}
+
+		return true;
+	}
+
+	bool ConversionState::Save(const std::string& statePath) const
+	{
+		/* Sorted, so the same state always gives the same file */
+		std::vector<const std::pair<const std::string, FileState>*> files{};
+		files.reserve(Files.size());
+
+		for (const auto& file : Files)
+		{
+			files.push_back(&file);
+		}
+
+		std::sort(files.begin(), files.end(), [](const auto* pA, const auto* pB)->bool
+			{
+				return pA->first < pB->first;
+			});
+
+		Utils::Json::Value fileArray(Utils::Json::Value::MakeArray());
+
+		for (const auto* pFile : files)
+		{
+			Utils::Json::Value file(Utils::Json::Value::MakeObject());
+			file.Set("path", Utils::Json::Value::MakeString(pFile->first));
+			file.Set("size", Utils::Json::Value::MakeNumber(static_cast<double>(pFile->second.Size)));
+			file.Set("modified", Utils::Json::Value::MakeString(ToHex(static_cast<uint64_t>(pFile->second.ModifiedTime))));
+			file.Set("hash", Utils::Json::Value::MakeString(ToHex(pFile->second.Hash)));
+			file.Set("decision", Utils::Json::Value::MakeString(ToHex(pFile->second.DecisionHash)));
+
+			fileArray.Append(std::move(file));
+		}
+
+		Utils::Json::Value document(Utils::Json::Value::MakeObject());
+		document.Set("version", Utils::Json::Value::MakeNumber(Version));
+		document.Set("files", std::move(fileArray));
+
+		const std::string contents(Utils::Json::Write(document));
+		return Utils::IO::WriteFileIfChanged(statePath, std::basic_string_view<BYTE>(reinterpret_cast<const BYTE*>(contents.data()), contents.size())) != Utils::IO::WriteResult::Failed;
+	}
+
+	bool ConversionState::IsUpToDate(const std::string& relativePath, const std::filesystem::path& filePath, const std::optional<uint64_t> decisionHash) const
+	{
+		const auto cIt(Files.find(relativePath));
+
+		if (cIt == Files.cend() || (decisionHash && *decisionHash != cIt->second.DecisionHash))
+		{
+			return false;
+		}
+
+		uint64_t size{};
+		int64_t modifiedTime{};
+
+		if (!GetFileTimes(filePath, size, modifiedTime) || size != cIt->second.Size)
+		{
+			return false;
+		}
+
+		if (modifiedTime == cIt->second.ModifiedTime)
+		{
+			return true;
+		}
+
+		/* Touched, but maybe not changed */
+		const Utils::IO::MappedFile file(Utils::IO::MapFile(filePath.string()));
+		return file.IsValid() && Utils::IO::Hash(file.View()) == cIt->second.Hash;
+	}
+
+	void ConversionState::Record(const std::string& relativePath, const std::filesystem::path& filePath, const std::basic_string_view<unsigned char /* BYTE */> contents, const uint64_t decisionHash)
+	{
+		FileState fileState{};
+
+		/* Without a timestamp the file just gets hashed next time */
+		GetFileTimes(filePath, fileState.Size, fileState.ModifiedTime);
+
+		fileState.Size = contents.size();
+		fileState.Hash = Utils::IO::Hash(contents);
+		fileState.DecisionHash = decisionHash;
+
+		Files.insert_or_assign(relativePath, fileState);
+	}
+
+	void ConversionState::Refresh(const std::string& relativePath, const std::filesystem::path& filePath)
+	{
+		if (const auto it(Files.find(relativePath)); it != Files.end())
+		{
+			GetFileTimes(filePath, it->second.Size, it->second.ModifiedTime);
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint> /* uint64_t, int64_t */
+#include <filesystem> /* std::filesystem::path */
+#include <optional> /* std::optional */
+#include <string> /* std::string */
+#include <string_view> /* std::basic_string_view */
+#include <unordered_map> /* std::unordered_map */
+
+namespace DLL
+{
+	/* A file as a previous conversion left it behind */
+	struct FileState final
+	{
+		uint64_t Size{};
+		int64_t ModifiedTime{}; /* in the ticks of std::filesystem::file_time_type */
+		uint64_t Hash{}; /* of the contents after the conversion */
+		uint64_t DecisionHash{}; /* of what the conversion did to it */
+	};
+
+	/* Remembers which files a conversion already rewrote, so converting the same project again only redoes files that
+	changed since. Stored as JSON next to the output, it is only a cache: a missing or unreadable state means everything gets redone */
+	class ConversionState final
+	{
+	public:
+		/* Returns false and fills in error if the state file exists but could not be read, state is empty then */
+		static bool Load(const std::string& statePath, ConversionState& state, std::string& error);
+		bool Save(const std::string& statePath) const;
+
+		/* True if the file is still exactly what the last conversion left behind. The size and timestamp are checked first,
+		only a file whose timestamp moved gets read. Without decisionHash it does not matter what was done to the file */
+		bool IsUpToDate(const std::string& relativePath, const std::filesystem::path& filePath, const std::optional<uint64_t> decisionHash) const;
+
+		/* Remembers contents as what the conversion left behind at filePath */
+		void Record(const std::string& relativePath, const std::filesystem::path& filePath, const std::basic_string_view<unsigned char /* BYTE */> contents, const uint64_t decisionHash);
+
+		/* Takes over the current timestamp of a file IsUpToDate() said was unchanged, so it does not get read again next time */
+		void Refresh(const std::string& relativePath, const std::filesystem::path& filePath);
+
+	private:
+		/* Bumped whenever the conversion starts to produce something different, which throws away older states */
+		inline constexpr static int Version{ 1 };
+
+		std::unordered_map<std::string, FileState> Files{}; /* relative to the root, '/' separated */
+	};
+}
@@ -1,31 +1,205 @@
 #include "DLLCreator.h"
+#include "Presets.h"
 
 #include "../Utils/Utils.h"
+#include "../Utils/FileIO.h"
+#include "../Utils/ByteSearch.h"
+#include "../Utils/EditList.h"
+#include "../Utils/LineIndex.h"
+#include "../Utils/HeaderParser.h"
+#include "../Utils/ExportAnalysis.h"
+#include "../Utils/SymbolReader.h"
+#include "../Utils/ThreadPool.h"
+#include "../Utils/Hash.h"
+#include "../Utils/Json.h"
+#include "../Utils/Process.h"
 
 #include <iostream> /* std::cout, std::cin */
-#include <algorithm> /* std::sort */
+#include <sstream> /* std::istringstream, std::ostringstream */
+#include <algorithm> /* std::sort, std::find_if, std::copy_if, std::partial_sort */
+#include <chrono> /* std::chrono::steady_clock */
+#include <iomanip> /* std::setprecision */
+#include <numeric> /* std::iota */
+#include <thread> /* std::thread::hardware_concurrency */
+#include <iterator> /* std::back_inserter */
 #include <assert.h> /* assert() */
-#include <deque> /* std::deque */
+#include <cctype> /* std::isdigit */
+#include <cstdint> /* int8_t, uintmax_t */
 #include <memory> /* std::unique_ptr */
-#include <bitset> /* std::bitset */
-#include <regex>
-
-/* Windows specific includes */
-#include <fileapi.h> /* CreateFileA() */
-#include <errhandlingapi.h> /* GetLastError() */
-#include <handleapi.h> /* INVALID_HANDLE_VALUE */
-// #include <tchar.h> /* _tcscmp() */
-
-#undef max
+#include <ranges> /* std::views::reverse */
+#include <stdexcept> /* std::runtime_error */
 
 namespace DLL
 {
+	namespace
+	{
+		/* True if text holds macro at offset, followed by whitespace */
+		bool HasMacroAt(const std::string_view text, const size_t offset, const std::basic_string<BYTE>& macro)
+		{
+			const std::string_view macroText(reinterpret_cast<const char*>(macro.data()), macro.size());
+
+			return offset + macroText.size() < text.size() && text.substr(offset, macroText.size()) == macroText &&
+				std::isspace(static_cast<unsigned char>(text[offset + macroText.size()]));
+		}
+
+		/* Just add the macro after the first class or struct that is not nested in another one, unless an earlier conversion already did.
+		Returns that class, or nullptr if there is none */
+		const Utils::Cpp::Declaration* AddClassExport(const std::string_view text, const std::vector<Utils::Cpp::Declaration>& declarations, const std::basic_string<BYTE>& apiMacro, Utils::IO::EditList& edits)
+		{
+			using namespace Utils::IO;
+
+			const auto cIt(std::find_if(declarations.cbegin(), declarations.cend(), [](const Utils::Cpp::Declaration& declaration)->bool
+				{
+					return declaration.Type != Utils::Cpp::DeclarationType::Function && declaration.Depth == 0 &&
+						!HasAnySpecifier(declaration.Specifiers, Utils::Cpp::Specifier::Template | Utils::Cpp::Specifier::Internal);
+				}));
+
+			if (cIt == declarations.cend())
+			{
+				return nullptr;
+			}
+
+			if (!HasMacroAt(text, cIt->KeywordEnd + 1, apiMacro))
+			{
+				edits.Insert(cIt->KeywordEnd, " "_byte + apiMacro);
+			}
+
+			return &*cIt;
+		}
+
+		std::vector<Utils::Cpp::Declaration> GetFunctions(const std::vector<Utils::Cpp::Declaration>& declarations)
+		{
+			std::vector<Utils::Cpp::Declaration> functions{};
+
+			std::copy_if(declarations.cbegin(), declarations.cend(), std::back_inserter(functions), [](const Utils::Cpp::Declaration& declaration)->bool
+				{
+					return declaration.Type == Utils::Cpp::DeclarationType::Function && !HasAnySpecifier(declaration.Specifiers, Utils::Cpp::Specifier::Template);
+				});
+
+			return functions;
+		}
+
+		/* The macro goes after class or struct of every class AnalyzeExports() picked, and in front of every function it picked */
+		void AddAnalyzedExports(const std::string_view text, const std::vector<Utils::Cpp::Declaration>& declarations, const std::vector<Utils::Cpp::ExportKind>& kinds,
+			const std::basic_string<BYTE>& apiMacro, Utils::IO::EditList& edits)
+		{
+			using namespace Utils::IO;
+
+			for (size_t i{}; i < declarations.size(); ++i)
+			{
+				if (kinds[i] == Utils::Cpp::ExportKind::Class && !HasMacroAt(text, declarations[i].KeywordEnd + 1, apiMacro))
+				{
+					edits.Insert(declarations[i].KeywordEnd, " "_byte + apiMacro);
+				}
+				else if (kinds[i] == Utils::Cpp::ExportKind::Function && !HasMacroAt(text, declarations[i].Begin, apiMacro))
+				{
+					edits.Insert(declarations[i].Begin, apiMacro + " "_byte);
+				}
+			}
+		}
+
+		/* The include goes on a line of its own after #pragma once, or at the top of the file without one.
+		It ends the way the line in front of it does (\r\n or \n). A header that already includes the API file is left alone */
+		void AddAPIInclude(const std::basic_string<BYTE>& include, const std::basic_string<BYTE>& fileContents, Utils::IO::EditList& edits)
+		{
+			using namespace Utils::IO;
+
+			const std::basic_string<BYTE> pragmaOnce("#pragma once"_byte);
+
+			if (FindSubstring(fileContents, include) != NotFound)
+			{
+				return;
+			}
+
+			if (fileContents.empty())
+			{
+				edits.Insert(0, include + "\n"_byte);
+				return;
+			}
+
+			const LineIndex lines(fileContents);
+			const size_t pragmaPos(FindSubstring(fileContents, pragmaOnce));
+			const size_t line(pragmaPos != NotFound ? lines.FindLine(pragmaPos) : 0);
+
+			const std::basic_string<BYTE> newLine(lines.GetLine(line).ends_with("\r\n"_byte) ? "\r\n"_byte : "\n"_byte);
+
+			if (pragmaPos == NotFound)
+			{
+				edits.Insert(0, include + newLine);
+			}
+			else if (lines.GetLine(line).ends_with('\n'))
+			{
+				edits.Insert(lines.GetLineEnd(line), include + newLine);
+			}
+			else
+			{
+				/* #pragma once is the last line, without a line break to put the include after */
+				edits.Insert(fileContents.size(), newLine + include + newLine);
+			}
+		}
+
+		/* Compiler, linker and CMake diagnostics, as GCC, Clang, MSVC and CMake print them */
+		void CountDiagnostics(const std::string_view line, size_t& nrOfWarnings, size_t& nrOfErrors)
+		{
+			constexpr std::string_view warnings[]{ "warning:", "warning C", "warning LNK", "CMake Warning" };
+			constexpr std::string_view errors[]{ "error:", "error C", "error LNK", "CMake Error" };
+
+			const auto contains([line](const std::string_view pattern)->bool
+				{
+					return line.find(pattern) != std::string_view::npos;
+				});
+
+			if (std::any_of(std::cbegin(errors), std::cend(errors), contains))
+			{
+				++nrOfErrors;
+			}
+			else if (std::any_of(std::cbegin(warnings), std::cend(warnings), contains))
+			{
+				++nrOfWarnings;
+			}
+		}
+
+		/* Everything that decides how RewriteHeader() changes a header, so a header is redone when any of it changes */
+		uint64_t GetDecisionHash(const HeaderDecision& decision, const std::basic_string<BYTE>& apiMacro, const std::basic_string<BYTE>& include, const uint64_t symbolsHash)
+		{
+			using namespace Utils::IO;
+
+			const BYTE separator{};
+			Hasher hasher{};
+
+			hasher.Update(apiMacro);
+			hasher.Update(&separator, 1);
+			hasher.Update(include);
+			hasher.Update(&separator, 1);
+
+			if (decision.bAnalyze)
+			{
+				hasher.Update("analyze"_byte);
+				hasher.Update(reinterpret_cast<const BYTE*>(&symbolsHash), sizeof(symbolsHash));
+			}
+			else if (decision.bExportClass)
+			{
+				hasher.Update("class"_byte);
+			}
+			else
+			{
+				for (const std::string& function : decision.Functions)
+				{
+					hasher.Update(reinterpret_cast<const BYTE*>(function.data()), function.size());
+					hasher.Update(&separator, 1);
+				}
+			}
+
+			return hasher.Digest();
+		}
+	}
+
 	DLLCreator::DLLCreator(const std::string& rootPath, const std::string& outputPath)
 		: RootPath(Utils::IO::ConvertToByteString(rootPath))
 		, ProjectName(Utils::IO::ConvertToByteString(rootPath))
 		, OutputPath{ outputPath }
 	{
-		ProjectName = ProjectName.substr(ProjectName.find_last_of('\\') + 1, ProjectName.size() - ProjectName.find_last_of('\\'));
+		ProjectName = ProjectName.substr(ProjectName.find_last_of(Utils::IO::ConvertToByteString("\\/")) + 1);
 
 		for (auto& c : ProjectName)
 		{
@@ -41,82 +215,255 @@ namespace DLL
 		{
 			assert(std::filesystem::exists(outputPath) && "The path to the output is invalid!");
 		}
+
+		/* The state of this project lives next to its output, the conversion itself must never pick it up */
+		const std::string stateFileName(Utils::IO::ConvertToRegularString(ProjectName) + ".DLLCreatorState.json");
+		StatePath = (std::filesystem::path(outputPath.empty() ? rootPath : outputPath) / stateFileName).string();
+		Classifier.Exclude(stateFileName);
 	}
 
-	void DLLCreator::Convert()
+	DLLCreator::DLLCreator(const Manifest& manifest, const size_t nrOfThreads)
+		: DLLCreator(manifest.RootPath, manifest.OutputPath)
+	{
+		BatchManifest = manifest;
+		NrOfThreads = nrOfThreads;
+
+		for (const std::string& pattern : manifest.Exclusions)
+		{
+			Classifier.Exclude(pattern);
+		}
+	}
+
+	bool DLLCreator::Convert(const BuildSettings& build)
+	{
+		try
+		{
+			GenerateFiles();
+		}
+		catch (const std::exception& exception)
+		{
+			std::cout << "Could not convert " << Utils::IO::ConvertToRegularString(ProjectName) << ": " << exception.what() << "\n";
+			return false;
+		}
+
+		std::string error{};
+
+		if (!RunCMake(build, error))
+		{
+			std::cout << "Could not build " << Utils::IO::ConvertToRegularString(ProjectName) << ": " << error << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	void DLLCreator::GenerateFiles()
 	{
 		/* [TODO]: Do all of this with Qt */
+		using Utils::Trace::ScopedTimer;
+
+		ConvertStart = Utils::Trace::Clock::now();
+
+		/* Step 0: Find out what an earlier conversion already did, a state that can not be read just means everything gets redone */
+		{
+			const ScopedTimer timer(Trace, "Load state", "step", Statistics.StateTime);
+
+			if (std::string error{}; !ConversionState::Load(StatePath, State, error))
+			{
+				std::cout << "Ignoring " << StatePath << ": " << error << "\n";
+			}
+		}
 
 		/* Step 1: Get all folders and files in this root directory */
-		GetAllFilesAndDirectories();
+		{
+			const ScopedTimer timer(Trace, "Scan", "step", Statistics.ScanTime);
+			GetAllFilesAndDirectories();
+		}
 
 		/* Step 2: Ask user which files and folders need to be included in the DLL build */
-		FilterFilesAndDirectories();
+		{
+			const ScopedTimer timer(Trace, "Filter", "step", Statistics.FilterTime);
+
+			if (BatchManifest)
+			{
+				/* The manifest already lists them */
+				for (const HeaderDecision& header : BatchManifest->Headers)
+				{
+					FilteredFilePaths.push_back((std::filesystem::path(Utils::IO::ConvertToRegularString(RootPath)) / header.Path).make_preferred().string());
+				}
+
+				/* And what the built libraries define, for the headers that get analyzed */
+				LoadSymbols();
+			}
+			else
+			{
+				FilterFilesAndDirectories();
+			}
+		}
 
 		/* Step 3: Find the .vcxproj file and define the preprocessor definition in it */
-		DefinePreprocessorMacro();
+		{
+			const ScopedTimer timer(Trace, "Project", "step", Statistics.ProjectTime);
+			DefinePreprocessorMacro();
+		}
 
 		/* Step 4: Create the API file that defines the macro */
-		CreateAPIFile();
+		{
+			const ScopedTimer timer(Trace, "API file", "step", Statistics.APIFileTime);
+			CreateAPIFile();
+		}
 
 		/* Step 5: Go through every filtered header file and start adding the include and the generated macro */
-		AddMacroToFilteredHeaderFiles();
+		{
+			const ScopedTimer timer(Trace, "Headers", "step", Statistics.HeaderTime);
+			AddMacroToFilteredHeaderFiles();
+		}
 
 		/* Step 6: Now that the macro and include has been added, generate CMake files */
-		GenerateCMakeFiles();
+		{
+			const ScopedTimer timer(Trace, "CMake files", "step", Statistics.CMakeGenerationTime);
+			GenerateCMakeFiles();
+		}
+
+		{
+			const ScopedTimer timer(Trace, "Save state", "step", Statistics.StateTime);
+
+			[[maybe_unused]] const bool bStateSaved(State.Save(StatePath));
+			assert(bStateSaved && "DLLCreator::Convert() > The conversion state could not be written to!");
+		}
+
+		std::cout << "Wrote " << NrOfWrittenFiles << " files of " << Utils::IO::ConvertToRegularString(ProjectName) << ", " << NrOfUnchangedFiles << " were already up to date\n";
+
+		GenerateEnd = Utils::Trace::Clock::now();
+	}
+
+	bool DLLCreator::RunCMake(const BuildSettings& build, std::string& error)
+	{
+		Statistics.CMakeQueueTime = Utils::Trace::Clock::now() - GenerateEnd;
 
 		/* Step 7: Execute CMake */
-		ExecuteCMake();
+		const bool bSucceeded(BatchManifest && !BatchManifest->bExecuteCMake ? true : ExecuteCMake(build, error));
+
+		const Utils::Trace::Clock::time_point end(Utils::Trace::Clock::now());
+
+		/* The whole conversion, with the totals the per file events add up to */
+		if (Trace.IsEnabled())
+		{
+			using Utils::Json::Value;
+
+			Value args(Value::MakeObject());
+			args.Set("scannedFiles", Value::MakeNumber(static_cast<double>(Statistics.NrOfScannedFiles)));
+			args.Set("rewrittenHeaders", Value::MakeNumber(static_cast<double>(Statistics.NrOfRewrittenHeaders)));
+			args.Set("bytesRead", Value::MakeNumber(static_cast<double>(Statistics.NrOfBytesRead)));
+			args.Set("bytesWritten", Value::MakeNumber(static_cast<double>(Statistics.NrOfBytesWritten)));
+			args.Set("writtenFiles", Value::MakeNumber(static_cast<double>(NrOfWrittenFiles)));
+			args.Set("unchangedFiles", Value::MakeNumber(static_cast<double>(NrOfUnchangedFiles)));
+			args.Set("compilerCacheHits", Value::MakeNumber(static_cast<double>(Statistics.NrOfCompilerCacheHits)));
+			args.Set("compilerCacheMisses", Value::MakeNumber(static_cast<double>(Statistics.NrOfCompilerCacheMisses)));
+			args.Set("precompilingLibraries", Value::MakeNumber(static_cast<double>(Statistics.NrOfPrecompilingLibraries)));
+			args.Set("linesToParse", Value::MakeNumber(static_cast<double>(Statistics.NrOfLinesToParse)));
+			args.Set("precompiledLinesToParse", Value::MakeNumber(static_cast<double>(Statistics.NrOfPrecompiledLinesToParse)));
+			args.Set("unitySources", Value::MakeNumber(static_cast<double>(Statistics.NrOfUnitySources)));
+			args.Set("unityBatches", Value::MakeNumber(static_cast<double>(Statistics.NrOfUnityBatches)));
+
+			Trace.AddEvent("Convert", "conversion", ConvertStart, end, std::move(args));
+		}
+
+		PrintSummary(end - ConvertStart);
+
+		return bSucceeded;
+	}
+
+	void DLLCreator::EnableTrace()
+	{
+		Trace.Enable(Utils::IO::ConvertToRegularString(ProjectName));
+	}
+
+	void DLLCreator::PrintSummary(const Utils::Trace::Clock::duration totalTime) const
+	{
+		const auto toMilliseconds([](const Utils::Trace::Clock::duration duration)->double
+			{
+				return std::chrono::duration<double, std::milli>(duration).count();
+			});
+
+		/* One write, so projects converted in parallel do not interleave */
+		std::ostringstream summary{};
+		summary << std::fixed << std::setprecision(2);
+		summary << "Converted " << Utils::IO::ConvertToRegularString(ProjectName) << " in " << toMilliseconds(totalTime) << " ms:"
+			<< " scan " << toMilliseconds(Statistics.ScanTime)
+			<< ", filter " << toMilliseconds(Statistics.FilterTime)
+			<< ", project " << toMilliseconds(Statistics.ProjectTime)
+			<< ", API file " << toMilliseconds(Statistics.APIFileTime)
+			<< ", headers " << toMilliseconds(Statistics.HeaderTime)
+			<< " (" << Statistics.NrOfRewrittenHeaders << " rewritten, " << toMilliseconds(Statistics.ReadTime) << " reading, " << toMilliseconds(Statistics.RewriteTime) << " parsing)"
+			<< ", CMake files " << toMilliseconds(Statistics.CMakeGenerationTime)
+			<< ", CMake queue " << toMilliseconds(Statistics.CMakeQueueTime)
+			<< ", CMake configure " << toMilliseconds(Statistics.CMakeConfigureTime)
+			<< ", CMake build " << toMilliseconds(Statistics.CMakeBuildTime)
+			<< ", state " << toMilliseconds(Statistics.StateTime) << " ms;"
+			<< " " << Statistics.NrOfScannedFiles << " files scanned, " << Statistics.NrOfBytesRead << " bytes read, " << Statistics.NrOfBytesWritten << " bytes written\n";
+
+		std::cout << summary.str();
+	}
+
+	bool DLLCreator::ReadInputFile(const std::string& filePath, std::basic_string<unsigned char /* BYTE */>& contents, Utils::Trace::Clock::duration& readTime) const
+	{
+		const Utils::Trace::Clock::time_point begin(Utils::Trace::Clock::now());
+		const bool bRead(Utils::IO::ReadFile(filePath, contents));
+		const Utils::Trace::Clock::time_point end(Utils::Trace::Clock::now());
+
+		readTime += end - begin;
+
+		if (Trace.IsEnabled())
+		{
+			using Utils::Json::Value;
+
+			Value args(Value::MakeObject());
+			args.Set("file", Value::MakeString(GetRelativePath(filePath)));
+			args.Set("bytes", Value::MakeNumber(static_cast<double>(contents.size())));
+
+			Trace.AddEvent("Read", "io", begin, end, std::move(args));
+		}
+
+		return bRead;
 	}
 
 	void DLLCreator::GetAllFilesAndDirectories()
 	{
-		/* Step 1 */
-		const std::filesystem::path path(Utils::IO::ConvertToRegularString(RootPath));
+		/* Step 1: walk the whole tree once, every later step only looks at the index */
+		[[maybe_unused]] const bool bIndexed(Index.Build(std::filesystem::path(Utils::IO::ConvertToRegularString(RootPath)), Classifier, NrOfThreads));
+		assert(bIndexed && "DLLCreator::GetAllFilesAndDirectories() > The root could not be read!");
 
-		for (const auto& entry : std::filesystem::directory_iterator(path))
+		for (size_t node{}; node < Index.GetNumberOfNodes(); ++node)
+		{
+			Statistics.NrOfScannedFiles += Index.IsRegularFile(node) ? 1 : 0;
+		}
+
+		for (const size_t entry : Index.GetChildren(Utils::IO::FileIndex::Root))
 		{
 			PathEntries.push_back(entry);
 		}
 
-		/* First all files, then all directories */
-		std::sort(PathEntries.begin(), PathEntries.end(), [](const auto& a, const auto& b)->bool
+		/* First all files, then all directories, both sorted on name */
+		std::stable_sort(PathEntries.begin(), PathEntries.end(), [this](const size_t a, const size_t b)->bool
 			{
 				/* Files => Directories */
-				return static_cast<int>(a.is_directory()) < static_cast<int>(b.is_directory());
+				return static_cast<int>(Index.IsDirectory(a)) < static_cast<int>(Index.IsDirectory(b));
 
 				/* Directories => Files */
-				//return static_cast<int>(a.is_directory()) > static_cast<int>(b.is_directory());
+				//return static_cast<int>(Index.IsDirectory(a)) > static_cast<int>(Index.IsDirectory(b));
 			});
 
 		/* Exclude certain files we know should not be converted already */
-		PathEntries.erase(std::remove_if(PathEntries.begin(), PathEntries.end(), [](const std::filesystem::directory_entry& entry)
-			{
-				const std::string path(entry.path().string());
-
-				return path.find(".sln") != std::string::npos ||
-					path.find(".vcxproj.user") != std::string::npos ||
-					path.find(".vcxproj.filters") != std::string::npos ||
-					path.find(".rar") != std::string::npos ||
-					path.find(".zip") != std::string::npos ||
-					path.find(".txt") != std::string::npos ||
-					path.find(".props") != std::string::npos ||
-					path.find(".bin") != std::string::npos ||
-					path.find(".exe") != std::string::npos ||
-					// path.find(".lib") != std::string::npos ||
-					// path.find(".dll") != std::string::npos ||
-					// path.find(".cpp") != std::string::npos ||
-					path.find(".vs") != std::string::npos ||
-					path.find("x64") != std::string::npos ||
-					path.find("Release") != std::string::npos ||
-					path.find("Debug") != std::string::npos ||
-					path.find("x86") != std::string::npos;
+		PathEntries.erase(std::remove_if(PathEntries.begin(), PathEntries.end(), [this](const size_t entry)
+			{
+				return Classifier.IsExcluded(Index.GetKind(entry));
 			}), PathEntries.end());
 
 		/* Testing */
-		//for (const std::filesystem::directory_entry& entry : PathEntries)
+		//for (const size_t entry : PathEntries)
 		//{
-		//	if (entry.is_directory())
+		//	if (Index.IsDirectory(entry))
 		//	{
 		//		std::cout << "Directory:\t";
 		//	}
@@ -125,7 +472,7 @@ namespace DLL
 		//		std::cout << "File:\t\t";
 		//	}
 
-		//	std::cout << entry.path().string() << "\n";
+		//	std::cout << Index.GetPath(entry).string() << "\n";
 		//}
 	}
 
@@ -134,14 +481,12 @@ namespace DLL
 		using namespace Utils;
 		using namespace IO;
 
-		for (const std::filesystem::directory_entry& entry : PathEntries)
+		for (const size_t entry : PathEntries)
 		{
-			const std::string path(entry.path().string());
+			const std::string path(Index.GetPath(entry).string());
 
 			/* Don't show .cpp, .lib or .dll files */
-			if (path.find(".cpp") != std::string::npos ||
-				path.find(".lib") != std::string::npos ||
-				path.find(".dll") != std::string::npos)
+			if (Index.HasAnyKind(entry, FileKind::Source | FileKind::StaticLibrary | FileKind::DynamicLibrary))
 			{
 				continue;
 			}
@@ -149,9 +494,9 @@ namespace DLL
 			ClearConsole();
 			std::cout << "Select which files should be readied for a .dll conversion. This should only be headers!\n";
 
-			if (entry.is_directory())
+			if (Index.IsDirectory(entry))
 			{
-				std::cout << "Directory:\t" << entry.path().string() << "\nEnter Directory? Y/N >> ";
+				std::cout << "Directory:\t" << path << "\nEnter Directory? Y/N >> ";
 
 				std::string userInput(ReadUserInput());
 
@@ -160,7 +505,7 @@ namespace DLL
 					ClearConsole();
 
 					std::cout << "Incorrect input: input must be Y or N!\n";
-					std::cout << "Directory:\t" << entry.path().string() << "\nEnter Directory? Y/N >> ";
+					std::cout << "Directory:\t" << path << "\nEnter Directory? Y/N >> ";
 
 					userInput = ReadUserInput();
 				}
@@ -172,7 +517,7 @@ namespace DLL
 			}
 			else
 			{
-				std::cout << "File:\t\t" << entry.path().string() << "\nShould file be converted? Y/N >> ";
+				std::cout << "File:\t\t" << path << "\nShould file be converted? Y/N >> ";
 
 				std::string userInput(ReadUserInput());
 
@@ -181,14 +526,14 @@ namespace DLL
 					ClearConsole();
 
 					std::cout << "Incorrect input: input must be Y or N!\n";
-					std::cout << "File:\t\t" << entry.path().string() << "\nShould file be converted? Y/N >> ";
+					std::cout << "File:\t\t" << path << "\nShould file be converted? Y/N >> ";
 
 					userInput = ReadUserInput();
 				}
 
 				if (userInput == "Y")
 				{
-					FilteredFilePaths.push_back(entry.path().string());
+					FilteredFilePaths.push_back(path);
 				}
 			}
 		}
@@ -199,6 +544,51 @@ namespace DLL
 		//}
 	}
 
+	void DLLCreator::LoadSymbols()
+	{
+		using namespace Utils;
+		using namespace IO;
+
+		Hasher hasher{};
+
+		for (const std::string& symbolFile : BatchManifest->SymbolFiles)
+		{
+			const std::string filePath((std::filesystem::path(ConvertToRegularString(RootPath)) / symbolFile).string());
+			const MappedFile file(MapFile(filePath));
+
+			/* Without symbols every declared function is taken for defined, so a missing file only makes the analysis less strict */
+			if (!file.IsValid())
+			{
+				std::cout << "Could not read the symbols in " << filePath << "\n";
+				continue;
+			}
+
+			/* Mapped, so for a library only the pages of its symbol index actually get read */
+			Statistics.NrOfBytesRead += file.Size();
+
+			/* A library or object file is read through its symbol table, which for a big library is a tiny part of the file.
+			Anything else is a list of symbols */
+			if (std::vector<std::string_view> symbols{}; ReadDefinedSymbols(file.View(), symbols))
+			{
+				for (const std::string_view symbol : symbols)
+				{
+					Symbols.AddSymbol(symbol);
+
+					hasher.Update(reinterpret_cast<const BYTE*>(symbol.data()), symbol.size());
+					hasher.Update(reinterpret_cast<const BYTE*>("\n"), 1);
+				}
+			}
+			else
+			{
+				Symbols.AddSymbolList(std::string_view(reinterpret_cast<const char*>(file.View().data()), file.View().size()));
+				hasher.Update(file.View());
+			}
+		}
+
+		/* Part of the decision of every analyzed header, so new symbols redo them */
+		SymbolsHash = hasher.Digest();
+	}
+
 	void DLLCreator::DefinePreprocessorMacro()
 	{
 		using namespace Utils;
@@ -208,111 +598,84 @@ namespace DLL
 
 		std::string vcxprojFilePath = FindVcxprojFilePath();
 
-		/* open the vcxproj file */
-		HANDLE vcxProjFile(
-			CreateFileA(vcxprojFilePath.c_str(),
-				GENERIC_READ | GENERIC_WRITE,
-				FILE_SHARE_READ | FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_EXISTING,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
+		/* Nothing to do if the vcxproj is still what the last conversion made of it */
+		const std::string relativeVcxprojPath(GetRelativePath(vcxprojFilePath));
+		const uint64_t decisionHash(Hash(std::basic_string_view<BYTE>(PreproExportMacro, ExportMacroLength)));
 
-		assert(vcxProjFile != INVALID_HANDLE_VALUE);
+		if (State.IsUpToDate(relativeVcxprojPath, vcxprojFilePath, decisionHash))
+		{
+			State.Refresh(relativeVcxprojPath, vcxprojFilePath);
+			++NrOfUnchangedFiles;
+			return;
+		}
 
-		std::basic_string<BYTE> fileContents{};
+		const std::basic_string<BYTE> preprocessorDef("<PreprocessorDefinitions>"_byte);
+		const std::basic_string<BYTE> configurationDef("<ConfigurationType>"_byte);
+		const std::basic_string<BYTE> dynamicLibrary("DynamicLibrary"_byte);
 
-		/* Read the file into a buffer */
-		const DWORD fileSize(GetFileSize(vcxProjFile, nullptr));
-		fileContents.resize(fileSize);
+		/* A definitions line an earlier conversion already added the macro to */
+		const std::basic_string<BYTE> firstExportDef(">"_byte + PreproExportMacro);
+		const std::basic_string<BYTE> exportDef(";"_byte + PreproExportMacro);
 
-		DWORD readBytes{};
-		assert(ReadFile(vcxProjFile, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::DefinePreprocessorMacros() > File could not be read!");
+		/* Every edit is recorded against the original file and applied in a single pass afterwards */
+		EditList edits{};
+		size_t nrOfPreprocessorDefinitions{}, nrOfConfigurations{};
 
-		const size_t count = std::count(fileContents.cbegin(), fileContents.cend(), '\n');
-		std::deque<size_t> preproInsertLocations{};
-		std::deque<size_t> nrOfConfigurations{};
+		std::basic_string<BYTE> fileContents{};
 
-		const std::basic_string<BYTE> preprocessorDef("<PreprocessorDefinitions>"_byte);
-		const std::basic_string<BYTE> configurationDef("<ConfigurationType>"_byte);
+		{ /* Scope-lock the mapping, it has to be released before the vcxproj gets overwritten */
+			const MappedFile vcxprojFile(MapFile(vcxprojFilePath));
+			assert(vcxprojFile.IsValid() && "DLLCreator::DefinePreprocessorMacros() > File could not be read!");
 
-		std::basic_string<BYTE> currentConfiguration{};
+			Statistics.NrOfBytesRead += vcxprojFile.Size();
 
-		size_t previousNewLine{};
-		for (size_t i{}; i < count; ++i)
-		{
-			const size_t nextNewLine(fileContents.find('\n', previousNewLine));
-			const std::basic_string<BYTE> line(fileContents.substr(previousNewLine, nextNewLine + 1 - previousNewLine));
+			/* Scan the mapped file line by line, every line is a view into the mapping so no line is ever copied */
+			const std::basic_string_view<BYTE> fileView(vcxprojFile.View());
+			const LineIndex lines(fileView);
 
-			{ /* Scope-lock the using directives */
+			for (size_t i{}; i < lines.GetNumberOfLines(); ++i)
+			{
+				const std::basic_string_view<BYTE> line(lines.GetLine(i));
+				const size_t lineStart(lines.GetLineStart(i));
 
-				if (line.find(preprocessorDef) != std::string::npos)
+				if (FindSubstring(line, preprocessorDef) != NotFound)
 				{
 					const size_t moduloPos(line.find_last_of(';'));
 
-					assert(moduloPos != std::string::npos && "DLLCreator::DefinePreprocessorMacros() > % was not found in the Preprocessor line!");
+					assert(moduloPos != std::basic_string_view<BYTE>::npos && "DLLCreator::DefinePreprocessorMacros() > % was not found in the Preprocessor line!");
 
-					preproInsertLocations.push_back(moduloPos + previousNewLine + 1);
-				}
-				else if (const size_t configurationPos{ line.find(configurationDef) }; configurationPos != std::string::npos)
-				{
-					nrOfConfigurations.push_back(configurationPos + previousNewLine);
-
-					if (currentConfiguration.empty())
+					if (FindSubstring(line, firstExportDef) == NotFound && FindSubstring(line, exportDef) == NotFound)
 					{
-						currentConfiguration = line.substr(line.find_first_of('>') + 1, line.find_last_of('<') - line.find_first_of('>') - 1);
+						edits.Insert(moduloPos + lineStart + 1, std::basic_string_view<BYTE>(PreproExportMacro, ExportMacroLength));
 					}
-				}
-			}
 
-			previousNewLine = nextNewLine + 1;
-		}
-
-		assert(nrOfConfigurations.size() == preproInsertLocations.size());
-
-		for (size_t i{}; i < preproInsertLocations.size();)
-		{
-			fileContents.insert(preproInsertLocations[i], PreproExportMacro);
+					++nrOfPreprocessorDefinitions;
+				}
+				else if (FindSubstring(line, configurationDef) != NotFound)
+				{
+					/* Replace whatever is between the tags with DynamicLibrary */
+					const size_t configurationBegin(line.find_first_of('>') + 1);
+					const size_t configurationEnd(line.find_last_of('<'));
 
-			for (size_t j{ i }; j < preproInsertLocations.size(); ++j)
-			{
-				preproInsertLocations[j] += ExportMacroLength;
+					edits.Replace(configurationBegin + lineStart, configurationEnd - configurationBegin, dynamicLibrary);
+					++nrOfConfigurations;
+				}
 			}
 
-			preproInsertLocations.pop_front();
-		}
+			assert(nrOfConfigurations == nrOfPreprocessorDefinitions);
 
-		for (size_t i{}; i < nrOfConfigurations.size(); ++i)
-		{
-			fileContents.replace(fileContents.find(currentConfiguration), currentConfiguration.size(), "DynamicLibrary"_byte);
+			/* Only now copy the file, once, with every edit applied */
+			fileContents = edits.Apply(fileView);
 		}
 
-		DWORD bytesWritten{};
 #ifdef WRITE_TO_TEST_FILE
-		/* open the test file */
-		HANDLE testFile(
-			CreateFileA("Test.txt",
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(testFile != INVALID_HANDLE_VALUE);
-
-		assert(WriteFile(testFile, fileContents.data(), static_cast<DWORD>(fileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::DefinePreprocessorMacros() > The vcxproj could not be written to!");
-		assert(CloseHandle(testFile) != 0 && "DLLCreator::DefinePreprocessorMacros() > Handle to file could not be closed!");
+		[[maybe_unused]] const bool bWritten(WriteOutputFile("Test.txt", fileContents));
 #else
-		SetFilePointer(vcxProjFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(vcxProjFile);
-
-		assert(WriteFile(vcxProjFile, fileContents.data(), static_cast<DWORD>(fileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::DefinePreprocessorMacros() > The vcxproj could not be written to!");
+		[[maybe_unused]] const bool bWritten(WriteOutputFile(vcxprojFilePath, fileContents));
 #endif
+		assert(bWritten && "DLLCreator::DefinePreprocessorMacros() > The vcxproj could not be written to!");
 
-		assert(CloseHandle(vcxProjFile) != 0 && "DLLCreator::DefinePreprocessorMacros() > Handle to file could not be closed!");
+		State.Record(relativeVcxprojPath, vcxprojFilePath, fileContents, decisionHash);
 	}
 
 	void DLLCreator::CreateAPIFile()
@@ -323,41 +686,55 @@ namespace DLL
 		/* Make the API file in the Root Directory */
 		std::basic_string<BYTE> api{};
 
+		const std::basic_string<BYTE> apiBaseName(RootPath.substr(RootPath.find_last_of("\\/"_byte) + 1) + "_API"_byte);
+
 		/* Make sure there is no file already with the apiFileName */
 		int counter{};
 		bool bShouldLoop(true);
 		do
 		{
-			api = RootPath.substr(RootPath.find_last_of('\\') + 1, RootPath.size() - RootPath.find_last_of('\\')) +
-				"_API"_byte;
+			api = apiBaseName;
+
+			if (counter == 1)
+			{
+				api.append("_CUSTOMTOOL"_byte);
+			}
+			else if (counter > 1)
+			{
+				api.append("_CUSTOMTOOL"_byte.append(ConvertToByteString(std::to_string(counter - 1))));
+			}
 
-			const auto cIt(std::find_if(PathEntries.cbegin(), PathEntries.cend(), [&api](const std::filesystem::directory_entry& entry)
+			const auto cIt(std::find_if(PathEntries.cbegin(), PathEntries.cend(), [this, &api](const size_t entry)
 				{
-					return ConvertToByteString(entry.path().string()).find(api) != std::string::npos;
+					return ConvertToByteString(Index.GetPath(entry).string()).find(api) != std::string::npos;
 				}));
 
-			/* The file already exists, ask the user if it can be overwritten */
+			/* The file already exists, ask the user (or the manifest) if it can be overwritten */
 			if (cIt != PathEntries.cend())
 			{
-				ClearConsole();
+				bool bCanOverwrite{};
+
+				if (BatchManifest)
+				{
+					bCanOverwrite = BatchManifest->bOverwriteAPIFile;
+				}
+				else
+				{
+					ClearConsole();
+
+					std::cout << "The file: " << api.c_str() <<
+						" already exists, but the program wants to use this name. Can the file be overwritten? Y/N >> ";
 
-				std::cout << "The file: " << api.c_str() <<
-					" already exists, but the program wants to use this name. Can the file be overwritten? Y/N >> ";
+					bCanOverwrite = ReadUserInput("Y");
+				}
 
-				if (ReadUserInput("Y"))
+				if (bCanOverwrite)
 				{
 					bShouldLoop = false;
 				}
 				else
 				{
-					if (counter > 0)
-					{
-						api.append("_CUSTOMTOOL"_byte.append(ConvertToByteString(std::to_string(0))));
-					}
-					else
-					{
-						api.append("_CUSTOMTOOL"_byte);
-					}
+					++counter;
 				}
 			}
 			else
@@ -380,25 +757,10 @@ namespace DLL
 			using namespace Utils;
 			using namespace IO;
 			APIFileName = api.append(".h"_byte);
-			APIFileNamePath = RootPath + "\\"_byte + APIFileName;
+			APIFileNamePath = ConvertToByteString((std::filesystem::path(ConvertToRegularString(RootPath)) / ConvertToRegularString(APIFileName)).string());
 		}
 
-		/* Now open the actual file and write the contents */
-		HANDLE apiFile(
-			CreateFileA(ConvertToRegularString(APIFileNamePath).c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(apiFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(apiFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(apiFile);
-
+		/* Now write the contents of the actual file */
 		const std::basic_string<BYTE> apiContents(
 			std::basic_string<BYTE>("#pragma once\n\n"_byte) +
 			std::basic_string<BYTE>("#ifdef _WIN32\n"_byte) +
@@ -411,10 +773,8 @@ namespace DLL
 			std::basic_string<BYTE>("\t#define "_byte) + APIMacro + "\n"_byte +
 			std::basic_string<BYTE>("#endif"_byte));
 
-		DWORD bytesWritten{};
-		assert(WriteFile(apiFile, apiContents.c_str(), static_cast<DWORD>(apiContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::CreateAPIFile() > The API file could not be written to!");
-
-		assert(CloseHandle(apiFile) != 0 && "DLLCreator::CreateAPIFile() > Handle to file could not be closed!");
+		[[maybe_unused]] const bool bWritten(WriteOutputFile(ConvertToRegularString(APIFileNamePath), apiContents));
+		assert(bWritten && "DLLCreator::CreateAPIFile() > The API file could not be written to!");
 	}
 
 	void DLLCreator::AddMacroToFilteredHeaderFiles()
@@ -422,250 +782,606 @@ namespace DLL
 		using namespace Utils;
 		using namespace IO;
 
+		/* Every header is independent when the manifest makes the decisions */
+		if (BatchManifest)
+		{
+			RewriteFilteredHeaderFiles();
+			return;
+		}
+
+		ClearConsole();
+
+		std::cout << "What every header exports:\n";
+
 		int fileCounter{};
 		for (const std::string& entry : FilteredFilePaths)
 		{
-			/* print file contents */
+			/* The same decision a manifest asking for the analysis would make */
+			const std::string relativePath(GetRelativePath(entry));
+			const std::basic_string<BYTE> include(GetAPIInclude(entry));
+			const uint64_t decisionHash(GetDecisionHash(HeaderDecision{ relativePath, false, {}, true }, APIMacro, include, SymbolsHash));
 
-			/* open the header */
-			HANDLE header(
-				CreateFileA(entry.c_str(),
-					GENERIC_READ | GENERIC_WRITE,
-					FILE_SHARE_READ | FILE_SHARE_WRITE,
-					nullptr,
-					OPEN_EXISTING,
-					FILE_ATTRIBUTE_NORMAL,
-					nullptr)
-			);
-
-			assert(header != INVALID_HANDLE_VALUE);
+			/* Converted before and not touched since */
+			if (State.IsUpToDate(relativePath, entry, decisionHash))
+			{
+				State.Refresh(relativePath, entry);
+				++NrOfUnchangedFiles;
+				++fileCounter;
+				continue;
+			}
 
+			/* Read the header into a buffer, one that can not be read is left as it is */
 			std::basic_string<BYTE> fileContents{};
 
-			/* Read the file into a buffer */
-			const DWORD fileSize(GetFileSize(header, nullptr));
-			fileContents.resize(fileSize);
-
-			DWORD readBytes{};
-			assert(ReadFile(header, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > File could not be read!");
+			if (!ReadInputFile(entry, fileContents, Statistics.ReadTime))
+			{
+				std::cout << "Could not read " << relativePath << ", it is left as it is\n";
+				++fileCounter;
+				continue;
+			}
 
-			ClearConsole();
+			Statistics.NrOfBytesRead += fileContents.size();
+			const Utils::Trace::Clock::time_point rewriteStart(Utils::Trace::Clock::now());
 
-			/* Print file contents */
-			std::cout << fileContents.c_str();
+			/* Every edit is recorded against the original header and applied in a single pass afterwards */
+			EditList edits{};
 
-			std::cout << "\nShould class be fully exported? Y/N >> ";
+			/* One pass over the header finds every class and function declaration */
+			const std::string_view text(reinterpret_cast<const char*>(fileContents.data()), fileContents.size());
+			std::vector<Cpp::Declaration> declarations{};
+			Cpp::ParseDeclarations(text, declarations);
 
-			const size_t count = std::count(fileContents.cbegin(), fileContents.cend(), '\n');
+			std::vector<Cpp::ExportKind> kinds{};
+			Cpp::AnalyzeExports(text, declarations, &Symbols, kinds);
 
-			std::cout << "\n--------------\n";
+			/* Members follow their class, so only what is declared at namespace scope is worth showing */
+			std::cout << "\n" << relativePath << "\n";
 
-			size_t previousNewLine{};
-			/* Just add the macro after the class declaration */
-			if (ReadUserInput("Y"))
+			for (size_t i{}; i < declarations.size(); ++i)
 			{
-				for (size_t i{}; i < count; ++i)
+				if (declarations[i].Depth == 0)
 				{
-					size_t nextNewLine(fileContents.find('\n', previousNewLine));
-					const std::basic_string<BYTE> line(fileContents.substr(previousNewLine, nextNewLine + 1 - previousNewLine));
+					std::cout << "\t" << text.substr(declarations[i].NameBegin, declarations[i].NameEnd - declarations[i].NameBegin) << ": " << Cpp::GetExportKindName(kinds[i]) << "\n";
+				}
+			}
 
-					enum class ClassType : uint8_t
-					{
-						Class = 0,
-						Struct = 1
-					};
-					std::bitset<2> classFlag{};
+			AddAnalyzedExports(text, declarations, kinds, APIMacro, edits);
+			AddAPIInclude(include, fileContents, edits);
+
+			fileContents = edits.Apply(fileContents);
+
+			const Utils::Trace::Clock::time_point rewriteEnd(Utils::Trace::Clock::now());
+			Statistics.RewriteTime += rewriteEnd - rewriteStart;
+			++Statistics.NrOfRewrittenHeaders;
 
-					size_t classTypeIndex{};
+			if (Trace.IsEnabled())
+			{
+				Json::Value args(Json::Value::MakeObject());
+				args.Set("file", Json::Value::MakeString(relativePath));
+
+				Trace.AddEvent("Rewrite", "header", rewriteStart, rewriteEnd, std::move(args));
+			}
 
-					{ /* Scope-lock using directives */
-						using namespace Utils;
-						using namespace IO;
+			WriteHeaderFile(entry, fileContents, fileCounter++);
 
-						if (classTypeIndex = line.find("class"_byte); classTypeIndex != std::string::npos)
+			State.Record(relativePath, entry, fileContents, decisionHash);
+		}
+	}
+
+	void DLLCreator::RewriteFilteredHeaderFiles()
+	{
+		using namespace Utils;
+		using namespace IO;
+		using Clock = Utils::Trace::Clock;
+
+		/* One header being rewritten, filled in by a worker and written out by this thread */
+		struct HeaderJob final
+		{
+			std::basic_string<BYTE> Contents{};
+			uint64_t DecisionHash{};
+			std::vector<std::string> UndefinedExports{}; /* exported by the manifest, but not defined by the libraries it lists */
+			bool bUpToDate{}; /* converted before with the same decision and not touched since, so not read at all */
+			bool bReadFailed{}; /* nothing gets written for it */
+			size_t NrOfBytesRead{};
+			Clock::duration ReadTime{};
+			Clock::duration RewriteTime{}; /* parsing and editing */
+			Clock::duration WriteTime{};
+		};
+
+		/* Headers are rewritten in windows, so at most this many bytes of headers are held in memory at once */
+		constexpr uintmax_t maxBytesInFlight{ 64 * 1024 * 1024 };
+
+		const Clock::time_point start(Clock::now());
+
+		const size_t nrOfHeaders(FilteredFilePaths.size());
+		assert(nrOfHeaders == BatchManifest->Headers.size() && "DLLCreator::RewriteFilteredHeaderFiles() > Every filtered header should come from the manifest!");
+		const size_t nrOfHardwareThreads(std::max<size_t>(std::thread::hardware_concurrency(), 1));
+		const size_t nrOfThreads(std::max<size_t>(std::min(NrOfThreads == 0 ? nrOfHardwareThreads : NrOfThreads, nrOfHeaders), 1));
+
+		/* A single thread rewrites on this thread, without a pool */
+		std::unique_ptr<ThreadPool> pThreadPool(nrOfThreads > 1 ? std::make_unique<ThreadPool>(nrOfThreads) : nullptr);
+
+		/* Every job only writes to its own slot, so no locking is needed */
+		std::vector<HeaderJob> jobs(nrOfHeaders);
+		size_t nrOfUpToDateHeaders{};
+		std::string unreadHeaders{};
+
+		size_t windowBegin{};
+		while (windowBegin < nrOfHeaders)
+		{
+			size_t windowEnd(windowBegin);
+			uintmax_t bytesInFlight{};
+
+			/* A window always takes at least one header, so a header larger than the budget still gets rewritten */
+			while (windowEnd < nrOfHeaders && (windowEnd == windowBegin || bytesInFlight < maxBytesInFlight))
+			{
+				std::error_code error{};
+				const uintmax_t fileSize(std::filesystem::file_size(FilteredFilePaths[windowEnd], error));
+				bytesInFlight += error ? 0 : fileSize;
+
+				const auto rewrite([this, &jobs, i = windowEnd]()
+					{
+						const Clock::time_point checkStart(Clock::now());
+
+						/* The state is only read while the workers run, so it needs no locking */
+						jobs[i].DecisionHash = GetDecisionHash(BatchManifest->Headers[i], APIMacro, GetAPIInclude(FilteredFilePaths[i]), SymbolsHash);
+						jobs[i].bUpToDate = State.IsUpToDate(BatchManifest->Headers[i].Path, FilteredFilePaths[i], jobs[i].DecisionHash);
+
+						if (jobs[i].bUpToDate)
 						{
-							classFlag.set(static_cast<std::underlying_type_t<ClassType>>(ClassType::Class));
+							jobs[i].RewriteTime = Clock::now() - checkStart;
+							return;
 						}
-						else if (classTypeIndex = line.find("struct"_byte); classTypeIndex != std::string::npos)
+
+						if (!ReadInputFile(FilteredFilePaths[i], jobs[i].Contents, jobs[i].ReadTime))
 						{
-							classFlag.set(static_cast<std::underlying_type_t<ClassType>>(ClassType::Struct));
+							jobs[i].bReadFailed = true;
+							return;
 						}
-					}
 
-					if (classFlag.any())
-					{
-						assert(classTypeIndex != std::string::npos && "DLLCreator::AddMacroToFilteredHeaderFiles() > struct/class could not be found!");
+						jobs[i].NrOfBytesRead = jobs[i].Contents.size();
+						const Clock::time_point rewriteStart(Clock::now());
+
+						/* FilteredFilePaths was built from the manifest headers, in the same order */
+						jobs[i].Contents = RewriteHeader(FilteredFilePaths[i], BatchManifest->Headers[i], jobs[i].Contents, jobs[i].UndefinedExports);
 
-						/* make sure we add the macro after the class/struct */
-						/* add macro to the buffer */
+						const Clock::time_point rewriteEnd(Clock::now());
+						jobs[i].RewriteTime = rewriteEnd - rewriteStart;
+
+						if (Trace.IsEnabled())
 						{
-							using namespace Utils;
-							using namespace IO;
-
-							if (classFlag.test(static_cast<std::underlying_type_t<ClassType>>(ClassType::Class)))
-							{
-								/* + 5 == length of 'class' */
-								constexpr size_t classLen{ 5 };
-								fileContents.insert(previousNewLine + classTypeIndex + classLen, " "_byte + APIMacro);
-								nextNewLine += classLen + 1;
-							}
-							else
-							{
-								/* + 6 == length of 'struct' */
-								constexpr size_t structLen{ 6 };
-								fileContents.insert(previousNewLine + classTypeIndex + structLen, " "_byte + APIMacro);
-								nextNewLine += structLen + 1;
-							}
+							Json::Value args(Json::Value::MakeObject());
+							args.Set("file", Json::Value::MakeString(BatchManifest->Headers[i].Path));
+
+							Trace.AddEvent("Rewrite", "header", rewriteStart, rewriteEnd, std::move(args));
 						}
+					});
 
-						break;
-					}
+				if (pThreadPool)
+				{
+					pThreadPool->Submit(rewrite);
+				}
+				else
+				{
+					rewrite();
+				}
+
+				++windowEnd;
+			}
 
-					previousNewLine = nextNewLine + 1;
+			if (pThreadPool)
+			{
+				pThreadPool->Wait();
+			}
+
+			/* Written in manifest order, so the result does not depend on which worker finished first */
+			for (size_t i(windowBegin); i < windowEnd; ++i)
+			{
+				const Clock::time_point writeStart(Clock::now());
+
+				if (jobs[i].bUpToDate)
+				{
+					State.Refresh(BatchManifest->Headers[i].Path, FilteredFilePaths[i]);
+					++NrOfUnchangedFiles;
+					++nrOfUpToDateHeaders;
 				}
+				else if (jobs[i].bReadFailed)
+				{
+					unreadHeaders.append((unreadHeaders.empty() ? "" : ", ") + BatchManifest->Headers[i].Path);
+				}
+				else
+				{
+					Statistics.NrOfBytesRead += jobs[i].NrOfBytesRead;
+					Statistics.ReadTime += jobs[i].ReadTime;
+					Statistics.RewriteTime += jobs[i].RewriteTime;
+					++Statistics.NrOfRewrittenHeaders;
+
+					WriteHeaderFile(FilteredFilePaths[i], jobs[i].Contents, static_cast<int>(i));
+					State.Record(BatchManifest->Headers[i].Path, FilteredFilePaths[i], jobs[i].Contents, jobs[i].DecisionHash);
+				}
+
+				jobs[i].WriteTime = Clock::now() - writeStart;
+
+				/* Release the header, only its timings are kept */
+				std::basic_string<BYTE>().swap(jobs[i].Contents);
 			}
-			else
+
+			windowBegin = windowEnd;
+		}
+
+		/* Report the headers that took the longest, as one write so projects converted in parallel do not interleave */
+		const auto toMilliseconds([](const Clock::duration duration)->double
 			{
-				std::cout << "\nWhat functions should be exported? Print the numbers. E.g. 0,1,3,5. Write NONE if no functions should be converted\n";
+				return std::chrono::duration<double, std::milli>(duration).count();
+			});
 
-				/* Get all functions from a file */
-				/* [CRINGE]: This is way too simple at the moment, complicated files containing templates and comments will not be parsed correctly */
-				const std::regex functionFinder{ "\\s*((?:\\w*(?:[:]{2})*)\\s*\\w*\\s*\\w*[&*]{0,2}\\s*\\w+\\(.*\\))" };
+		std::vector<size_t> slowestHeaders(nrOfHeaders);
+		std::iota(slowestHeaders.begin(), slowestHeaders.end(), size_t{});
 
-				std::smatch matches{};
-				std::vector<std::string> functions{};
+		const size_t nrOfReportedHeaders(std::min<size_t>(nrOfHeaders, 5));
+		std::partial_sort(slowestHeaders.begin(), slowestHeaders.begin() + nrOfReportedHeaders, slowestHeaders.end(), [&jobs](const size_t a, const size_t b)->bool
+			{
+				return jobs[a].ReadTime + jobs[a].RewriteTime + jobs[a].WriteTime > jobs[b].ReadTime + jobs[b].RewriteTime + jobs[b].WriteTime;
+			});
 
-				std::string convertedFileContents(Utils::IO::ConvertToRegularString(fileContents));
-				size_t counter{};
-				while (std::regex_search(convertedFileContents, matches, functionFinder)) /* Temp strings are not allowed */
-				{
-					std::string match(matches.str());
-					match.erase(match.begin(), std::find_if(match.begin(), match.end(), [](const char c)->bool
-						{
-							return !std::isspace(c);
-						}));
+		std::ostringstream report{};
+		report << std::fixed << std::setprecision(2);
+		report << "Rewrote " << nrOfHeaders - nrOfUpToDateHeaders << " headers of " << ConvertToRegularString(ProjectName) << " (" << nrOfUpToDateHeaders << " up to date) on " << nrOfThreads << " threads in " << toMilliseconds(Clock::now() - start) << " ms\n";
+
+		for (size_t i{}; i < nrOfReportedHeaders; ++i)
+		{
+			const HeaderJob& job(jobs[slowestHeaders[i]]);
+
+			report << "\t" << toMilliseconds(job.ReadTime) << " ms read, " << toMilliseconds(job.RewriteTime) << " ms rewrite, " << toMilliseconds(job.WriteTime) << " ms write: " << GetRelativePath(FilteredFilePaths[slowestHeaders[i]]) << "\n";
+		}
+
+		/* These will fail to link once the .dll gets built */
+		for (size_t i{}; i < nrOfHeaders; ++i)
+		{
+			for (const std::string& name : jobs[i].UndefinedExports)
+			{
+				report << "Exported, but not defined by any of the libraries: " << name << " in " << BatchManifest->Headers[i].Path << "\n";
+			}
+		}
+
+		std::cout << report.str();
+
+		/* The other headers are written, but the project will not build without these */
+		if (!unreadHeaders.empty())
+		{
+			throw std::runtime_error("could not read " + unreadHeaders);
+		}
+	}
+
+	std::basic_string<unsigned char /* BYTE */> DLLCreator::RewriteHeader(const std::string& entry, const HeaderDecision& decision, const std::basic_string<unsigned char /* BYTE */>& fileContents,
+		std::vector<std::string>& undefinedExports) const
+	{
+		using namespace Utils;
+		using namespace IO;
+
+		/* Every edit is recorded against the original header and applied in a single pass afterwards */
+		EditList edits{};
 
-					/* store the function for later */
-					functions.push_back(match);
+		/* One pass over the header finds every class and function declaration */
+		const std::string_view text(reinterpret_cast<const char*>(fileContents.data()), fileContents.size());
+		std::vector<Cpp::Declaration> declarations{};
+		Cpp::ParseDeclarations(text, declarations);
 
-					/* Print the function */
-					std::cout << std::to_string(counter++) << ". " << match << "\n";
+		if (decision.bAnalyze)
+		{
+			std::vector<Cpp::ExportKind> kinds{};
+			Cpp::AnalyzeExports(text, declarations, &Symbols, kinds);
 
-					convertedFileContents = matches.suffix();
+			AddAnalyzedExports(text, declarations, kinds, APIMacro, edits);
+		}
+		else if (decision.bExportClass)
+		{
+			/* The analysis leaves out what the libraries do not define, decisions from the manifest only get checked */
+			if (const Cpp::Declaration* pClass = AddClassExport(text, declarations, APIMacro, edits); pClass != nullptr && !Symbols.IsEmpty())
+			{
+				const std::string_view name(text.substr(pClass->NameBegin, pClass->NameEnd - pClass->NameBegin));
+
+				if (!Symbols.DefinesMembersOf(name))
+				{
+					undefinedExports.emplace_back(name);
 				}
+			}
+		}
+		else
+		{
+			/* The manifest names the functions, find the matching declarations */
+			for (const Cpp::Declaration& function : GetFunctions(declarations))
+			{
+				const std::string_view name(text.substr(function.NameBegin, function.NameEnd - function.NameBegin));
 
-				const std::string input(Utils::IO::ReadUserInput());
+				if (std::find(decision.Functions.cbegin(), decision.Functions.cend(), name) == decision.Functions.cend())
+				{
+					continue;
+				}
 
-				if (input != "NONE")
+				if (!HasMacroAt(text, function.Begin, APIMacro))
 				{
-					const std::vector<size_t> selectedFunctions(GetNumbersFromCSVString(input));
+					/* insert the macro before this function */
+					edits.Insert(function.Begin, APIMacro + " "_byte);
+				}
 
-					for (const size_t i : selectedFunctions)
-					{
-						if (i < functions.size())
-						{
-							/* insert the macro before this function */
-							fileContents.insert(fileContents.find(ConvertToByteString(functions[i])), APIMacro + " "_byte);
-						}
-					}
+				/* Operators are mangled into codes, so they can not be looked up by name */
+				if (!Symbols.IsEmpty() && name.substr(0, 8) != "operator" && !Symbols.DefinesFunction(name))
+				{
+					undefinedExports.emplace_back(name);
 				}
 			}
+		}
+
+		AddAPIInclude(GetAPIInclude(entry), fileContents, edits);
+
+		return edits.Apply(fileContents);
+	}
+
+	std::basic_string<unsigned char /* BYTE */> DLLCreator::GetAPIInclude(const std::string& entry) const
+	{
+		using namespace Utils::IO;
+
+		/* We also need to add the include to the API file */
+		const size_t directoriesDeep(GetNumberOfDirectoriesDeep(entry));
+		std::basic_string<BYTE> include{ "#include \""_byte };
+
+		for (size_t i{}; i < directoriesDeep; ++i)
+		{
+			include.append("../"_byte);
+		}
+
+		include.append(APIFileName + "\""_byte);
+
+		return include;
+	}
+
+	void DLLCreator::GenerateCMakeFiles()
+	{
+		ClearConsole();
+
+		if (!BatchManifest || BatchManifest->bPrecompiledHeaders)
+		{
+			HeaderPlanner.emplace(Index, [this](const std::string& filePath, std::basic_string<BYTE>& contents)->bool
+				{
+					return ReadSourceFile(filePath, contents);
+				});
+		}
+
+		for (const size_t entry : PathEntries)
+		{
+			GenerateSubDirectoryCMakeFiles(entry);
+		}
+
+		/* Generate the Root CMake file after everything else, because we need the set variables in the sub directories */
+		GenerateRootCMakeFile();
+
+		HeaderPlanner.reset();
+
+		if (Statistics.NrOfPrecompilingLibraries > 1)
+		{
+			const uint64_t nrOfSavedLines(Statistics.NrOfLinesToParse - Statistics.NrOfPrecompiledLinesToParse);
+
+			std::ostringstream report{};
+			report << std::fixed << std::setprecision(1);
+			report << "Precompiled headers for " << Statistics.NrOfPrecompilingLibraries << " libraries of " << Utils::IO::ConvertToRegularString(ProjectName) << ": about "
+				<< nrOfSavedLines << " of " << Statistics.NrOfLinesToParse << " lines less to parse ("
+				<< 100.0 * static_cast<double>(nrOfSavedLines) / static_cast<double>(Statistics.NrOfLinesToParse) << "%)\n";
+			std::cout << report.str();
+		}
+	}
+
+	std::string DLLCreator::GetPrecompiledHeaders(const std::string& libName, const std::vector<size_t>& sources)
+	{
+		if (!HeaderPlanner)
+		{
+			return std::string{};
+		}
+
+		const PrecompiledHeaderPlan plan(HeaderPlanner->Plan(sources));
+
+		Statistics.NrOfLinesToParse += plan.NrOfLinesBefore;
+		Statistics.NrOfPrecompiledLinesToParse += plan.NrOfLinesAfter;
+
+		if (plan.Headers.empty())
+		{
+			return std::string{};
+		}
+
+		++Statistics.NrOfPrecompilingLibraries;
+
+		std::string headers{};
+		for (const std::string& header : plan.Headers)
+		{
+			headers.append("\"" + header + "\" ");
+		}
+
+		const uint64_t nrOfSavedLines(plan.NrOfLinesBefore - plan.NrOfLinesAfter);
+
+		std::ostringstream report{};
+		report << std::fixed << std::setprecision(1);
+		report << "Precompiling " << plan.Headers.size() << " headers for " << libName << ": " << headers << "about "
+			<< nrOfSavedLines << " of " << plan.NrOfLinesBefore << " lines less to parse ("
+			<< 100.0 * static_cast<double>(nrOfSavedLines) / static_cast<double>(plan.NrOfLinesBefore) << "%)\n";
+		std::cout << report.str();
+
+		return headers;
+	}
 
-			/* We also need to add the include to the API file */
-			const size_t directoriesDeep(GetNumberOfDirectoriesDeep(entry));
-			std::basic_string<BYTE> include{ "#include \""_byte };
+	void DLLCreator::GetUnityBatches(const std::string& libName, const std::vector<size_t>& sources, std::string& unitySources, std::string& unityBatches)
+	{
+		if (!BatchManifest || !BatchManifest->bUnityBuild)
+		{
+			return;
+		}
 
-			for (size_t i{}; i < directoriesDeep; ++i)
+		/* One batch per hardware thread keeps every core busy, unless the manifest knows better */
+		const size_t nrOfBatches(BatchManifest->NrOfUnityBatches > 0 ? BatchManifest->NrOfUnityBatches : std::max<size_t>(std::thread::hardware_concurrency(), 1));
+
+		const UnityBuildPlan plan(PlanUnityBuild(Index, sources, nrOfBatches, [this](const std::string& filePath, std::basic_string<BYTE>& contents)->bool
 			{
-				include.append("../"_byte);
-			}
+				return ReadSourceFile(filePath, contents);
+			}));
 
-			include.append(APIFileName + "\""_byte);
+		std::ostringstream report{};
 
-			const std::basic_string<BYTE> pragmaOnce("#pragma once"_byte);
-			/* Check if the file contains a #pragma once */
-			if (size_t pragmaPos = fileContents.find(pragmaOnce); pragmaPos != std::string::npos)
+		if (plan.Sources.empty())
+		{
+			report << "No unity build for " << libName << ", it has fewer than " << MinNrOfUnitySources << " sources that can be compiled together";
+		}
+		else
+		{
+			Statistics.NrOfUnitySources += plan.Sources.size();
+			Statistics.NrOfUnityBatches += plan.NrOfBatches;
+
+			for (size_t i{}; i < plan.Sources.size(); ++i)
 			{
-				fileContents.insert(pragmaPos + pragmaOnce.size() + 1, include);
+				unitySources.append(std::string(Index.GetName(plan.Sources[i])) + " ");
+				unityBatches.append(std::to_string(plan.Batches[i]) + " ");
 			}
-			else
+
+			report << "Unity build of " << libName << ": " << plan.Sources.size() << " sources in " << plan.NrOfBatches << " batches of "
+				<< plan.NrOfBytesInSmallestBatch << " to " << plan.NrOfBytesInLargestBatch << " bytes";
+		}
+
+		for (size_t i{}; i < plan.Exclusions.size(); ++i)
+		{
+			report << (i == 0 ? ", compiled on their own: " : ", ") << Index.GetName(plan.Exclusions[i].Source) << " (" << plan.Exclusions[i].Reason << ")";
+		}
+
+		report << "\n";
+		std::cout << report.str();
+	}
+
+	bool DLLCreator::ReadSourceFile(const std::string& filePath, std::basic_string<BYTE>& contents)
+	{
+		const bool bRead(ReadInputFile(filePath, contents, Statistics.ReadTime));
+		Statistics.NrOfBytesRead += contents.size();
+		return bRead;
+	}
+
+	bool DLLCreator::ExecuteCMake(const BuildSettings& build, std::string& error)
+	{
+		using namespace Utils;
+		using namespace IO;
+		using Clock = Utils::Trace::Clock;
+
+		const std::string rootPath(ConvertToRegularString(RootPath));
+		const std::string projectName(ConvertToRegularString(ProjectName));
+
+		/* The build and the compiler cache go into the output folder, if there is one */
+		const std::filesystem::path outputDirectory(OutputPath.empty() ? rootPath : OutputPath);
+		const std::string buildPath((outputDirectory / "DLL_BUILD").string());
+		const std::string cacheDirectory((outputDirectory / "DLL_CACHE").string());
+
+		if (std::error_code createError{}; !std::filesystem::create_directories(buildPath, createError) && createError)
+		{
+			error = "could not create " + buildPath + ": " + createError.message();
+			return false;
+		}
+
+		BuildSettings::Commands commands(build.GetCommands(rootPath, buildPath, BatchManifest ? BatchManifest->Generator : std::string{}));
+
+		std::cout << "Building " << projectName << " with " << commands.Description << "\n";
+
+		const Clock::duration timeout(BatchManifest ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(BatchManifest->CMakeTimeout)) : Clock::duration::zero());
+		const std::string linePrefix("[" + projectName + "] ");
+
+		/* Returns false and fills in error if the stage could not be started, failed or ran out of time */
+		const auto runStage([&](const char* pName, const std::vector<std::string>& arguments, const std::vector<std::string>& environment, Clock::duration& time)->bool
 			{
-				/* just insert at the top of the file */
-				fileContents.insert(0, include);
-			}
+				const Utils::Trace::ScopedTimer timer(Trace, std::string("CMake ") + pName, "step", time);
+
+				Process process{};
 
-#if WRITE_TO_TEST_FILE
-			/* open the altered header */
-			HANDLE newHeader(
-				CreateFileA((std::string("Test") + std::to_string(fileCounter++) + ".txt").c_str(),
-					GENERIC_WRITE,
-					FILE_SHARE_WRITE,
-					nullptr,
-					OPEN_ALWAYS,
-					FILE_ATTRIBUTE_NORMAL,
-					nullptr)
-			);
+				if (!process.Start(arguments, rootPath, environment, error))
+				{
+					return false;
+				}
+
+				/* Streamed as it comes in, every line in one write so projects building in parallel do not interleave within a line */
+				size_t nrOfWarnings{}, nrOfErrors{};
+
+				const Process::Result result(process.Wait([&](const std::string_view line)
+					{
+						CountDiagnostics(line, nrOfWarnings, nrOfErrors);
+						std::cout << (linePrefix + std::string(line) + "\n");
+					}, timeout));
+
+				std::ostringstream report{};
+				report << std::fixed << std::setprecision(2);
+				report << "CMake " << pName << " of " << projectName << ": exit code " << result.ExitCode << " after " << std::chrono::duration<double, std::milli>(result.Duration).count() << " ms, "
+					<< nrOfWarnings << " warnings, " << nrOfErrors << " errors\n";
+				std::cout << report.str();
+
+				if (result.bTimedOut)
+				{
+					std::ostringstream timeoutError{};
+					timeoutError << "CMake " << pName << " did not finish within " << BatchManifest->CMakeTimeout << " seconds";
+					error = timeoutError.str();
+					return false;
+				}
 
-			assert(newHeader != INVALID_HANDLE_VALUE);
+				if (result.ExitCode != 0)
+				{
+					error = std::string("CMake ") + pName + " failed with exit code " + std::to_string(result.ExitCode);
+					return false;
+				}
 
-			SetFilePointer(newHeader, 0, nullptr, FILE_BEGIN);
-			SetEndOfFile(newHeader);
+				return true;
+			});
+
+		if (!runStage("configure", commands.Configure, {}, Statistics.CMakeConfigureTime))
+		{
+			return false;
+		}
 
-			DWORD bytesWritten{};
-			assert(WriteFile(newHeader, fileContents.c_str(), static_cast<DWORD>(fileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-			assert(CloseHandle(newHeader) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > Handle to file could not be closed!");
-#else
-			SetFilePointer(header, 0, nullptr, FILE_BEGIN);
-			SetEndOfFile(header);
+		/* The configure found the compiler cache, if there is one. Its counts start from zero so they end up being those of this build */
+		CompilerCache compilerCache{};
+		const bool bHasCompilerCache(CompilerCache::Find(buildPath, cacheDirectory, compilerCache));
 
-			DWORD bytesWritten{};
-			assert(WriteFile(header, fileContents.c_str(), static_cast<DWORD>(fileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-#endif
+		if (bHasCompilerCache)
+		{
+			commands.BuildEnvironment.push_back(compilerCache.GetEnvironment());
 
-			assert(CloseHandle(header) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > Handle to file could not be closed!");
+			if (std::string cacheError{}; !compilerCache.ZeroStatistics(cacheError))
+			{
+				std::cout << "Could not reset the statistics of " << compilerCache.GetName() << ": " << cacheError << "\n";
+			}
 		}
-	}
 
-	void DLLCreator::GenerateCMakeFiles()
-	{
-		Utils::IO::ClearConsole();
+		const bool bIsBuilt(runStage("build", commands.Build, commands.BuildEnvironment, Statistics.CMakeBuildTime));
 
-		for (const std::filesystem::directory_entry& entry : PathEntries)
+		if (bHasCompilerCache)
 		{
-			GenerateSubDirectoryCMakeFiles(entry);
-		}
+			CompilerCache::Statistics cacheStatistics{};
 
-		/* Generate the Root CMake file after everything else, because we need the set variables in the sub directories */
-		GenerateRootCMakeFile();
-	}
+			if (std::string cacheError{}; compilerCache.ReadStatistics(cacheStatistics, cacheError))
+			{
+				Statistics.NrOfCompilerCacheHits = cacheStatistics.NrOfHits;
+				Statistics.NrOfCompilerCacheMisses = cacheStatistics.NrOfMisses;
 
-	void DLLCreator::ExecuteCMake()
-	{
-		using namespace Utils;
-		using namespace IO;
+				const size_t nrOfCompiles(cacheStatistics.NrOfHits + cacheStatistics.NrOfMisses);
 
-		const std::string rootPath(ConvertToRegularString(RootPath));
+				std::ostringstream report{};
+				report << std::fixed << std::setprecision(2);
+				report << compilerCache.GetName() << " of " << projectName << ": " << cacheStatistics.NrOfHits << " hits, " << cacheStatistics.NrOfMisses << " misses";
 
-		if (OutputPath.empty())
-		{
-			system(
-				((("cd ") + rootPath) + " && " +
-					"mkdir DLL_BUILD && " +
-					"cd DLL_BUILD && " +
-					"cmake .. && "
-					"cmake --build . --config Release"
-					).c_str());
-		}
-		else
-		{
-			system(
-				((("cd ") + rootPath) + " && " +
-					"mkdir DLL_BUILD && " +
-					"cd DLL_BUILD && " +
-					"cmake .. && "
-					"cmake --build . --config Release " + OutputPath
-					).c_str());
+				if (nrOfCompiles > 0)
+				{
+					report << ", " << 100.0 * static_cast<double>(cacheStatistics.NrOfHits) / static_cast<double>(nrOfCompiles) << "% hit rate";
+				}
+
+				report << "\n";
+				std::cout << report.str();
+			}
+			else
+			{
+				std::cout << "Could not read the statistics of " << compilerCache.GetName() << ": " << cacheError << "\n";
+			}
 		}
+
+		return bIsBuilt;
 	}
 
 	void DLLCreator::GenerateRootCMakeFile()
@@ -673,58 +1389,16 @@ namespace DLL
 		using namespace Utils;
 		using namespace IO;
 
-		/* open the preset file */
-		HANDLE cmakeRootPresetFile(
-			CreateFileA("Resources/CMakeRootPreset.txt",
-				GENERIC_READ,
-				FILE_SHARE_READ,
-				nullptr,
-				OPEN_EXISTING,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeRootPresetFile != INVALID_HANDLE_VALUE);
-
-		std::basic_string<BYTE> fileContents{};
-
-		/* Read the file into a buffer */
-		const DWORD fileSize(GetFileSize(cmakeRootPresetFile, nullptr));
-		fileContents.resize(fileSize);
-
-		DWORD readBytes{};
-		assert(ReadFile(cmakeRootPresetFile, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::GenerateRootCMakeFile() > File could not be read!");
-		assert(CloseHandle(cmakeRootPresetFile) != 0 && "DLLCreator::GenerateRootCMakeFile() > Handle to file could not be closed!");
-
-		std::string convertedFileContents(ConvertToRegularString(fileContents));
-
-		/* Substitute the version in */
-		const std::regex versionMajorRegex("<VERSION_MAJOR>");
-		const std::regex versionMinorRegex("<VERSION_MINOR>");
-		const std::regex projectNameRegex("<PROJECT_NAME>");
-		const std::regex subDirectoriesRegex("<SUBDIRECTORIES>");
-		const std::regex librariesRegex("<LIBRARIES>");
-		const std::regex includesRegex("<INCLUDES>");
-		const std::regex dllsRegex("<DLLS>");
-		const std::regex apiFileRegex("<API_FILE>");
-
-		convertedFileContents = std::regex_replace(convertedFileContents, versionMajorRegex, "3");
-		convertedFileContents = std::regex_replace(convertedFileContents, versionMinorRegex, "10");
-		convertedFileContents = std::regex_replace(convertedFileContents, projectNameRegex, ConvertToRegularString(ProjectName));
-		convertedFileContents = std::regex_replace(convertedFileContents, apiFileRegex, ConvertToRegularString(APIFileName));
-
 		/* Add sub directories */
 		std::string subDirectories{};
 		/* Loop over all sub directories, and add them as sub directories */
-		for (const std::filesystem::directory_entry& subD : PathEntries)
+		for (const size_t subD : PathEntries)
 		{
-			if (subD.is_directory())
+			if (Index.IsDirectory(subD))
 			{
-				const std::string path(subD.path().string());
-				subDirectories.append(path.substr(path.find_last_of('\\') + 1, path.size() - path.find_last_of('\\')) + " ");
+				subDirectories.append(std::string(Index.GetName(subD)) + " ");
 			}
 		}
-		convertedFileContents = std::regex_replace(convertedFileContents, subDirectoriesRegex, subDirectories);
 
 		/* Add libraries */
 		std::string libraries{};
@@ -732,7 +1406,6 @@ namespace DLL
 		{
 			libraries.append(lib + " ");
 		}
-		convertedFileContents = std::regex_replace(convertedFileContents, librariesRegex, libraries);
 
 		/* Add includes */
 		std::string includes{};
@@ -740,7 +1413,6 @@ namespace DLL
 		{
 			includes.append(include + " ");
 		}
-		convertedFileContents = std::regex_replace(convertedFileContents, includesRegex, includes);
 
 		/* Add dlls */
 		std::string dlls{};
@@ -748,30 +1420,21 @@ namespace DLL
 		{
 			dlls.append(dll + " ");
 		}
-		convertedFileContents = std::regex_replace(convertedFileContents, dllsRegex, dlls);
+
+		const std::string projectName(ConvertToRegularString(ProjectName));
+		const std::string apiFileName(ConvertToRegularString(APIFileName));
+
+		/* The compiler caches CMake looks for, in order of preference */
+		const std::string compilerCaches(BatchManifest ? BatchManifest->CompilerCache : "ccache sccache");
+
+		/* Fill in the root preset, the CMake version is 3.10 */
+		Presets::RootTemplate.Render({ "3", "10", projectName, subDirectories, libraries, includes, dlls, apiFileName, compilerCaches }, CMakeFileContents);
 
 		/* make a new root file */
-		HANDLE cmakeRootFile(
-			CreateFileA((ConvertToRegularString(RootPath) + "\\CMakeLists.txt").c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeRootFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(cmakeRootFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(cmakeRootFile);
-
-		DWORD bytesWritten{};
-		assert(WriteFile(cmakeRootFile, convertedFileContents.c_str(), static_cast<DWORD>(convertedFileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-		assert(CloseHandle(cmakeRootFile) != 0 && "DLLCreator::GenerateRootCMakeFile() > Handle to file could not be closed!");
+		WriteCMakeFile(ConvertToRegularString(RootPath), CMakeFileContents);
 	}
 
-	void DLLCreator::GenerateSubDirectoryCMakeFiles(const std::filesystem::directory_entry& entry)
+	void DLLCreator::GenerateSubDirectoryCMakeFiles(const size_t entry)
 	{
 		using namespace Utils;
 		using namespace IO;
@@ -780,7 +1443,7 @@ namespace DLL
 		/* if it contains libs, headers AND dlls, it is also an interface, but the dlls need to be copied */
 		/* if it contains cpp files, we need to add a normal library (NOT AN INTERFACE) and link the headers */
 
-		if (entry.is_directory())
+		if (Index.IsDirectory(entry))
 		{
 			const int8_t subDirectoryType(CheckSubDirectory(entry));
 
@@ -800,34 +1463,57 @@ namespace DLL
 				break;
 				/* The ones below should not happen, they are legit horrible folder structure */
 			case 2 /* contains .h and .lib */:
-				/* add the library name and set the include directories */
-				std::cout << "This program requires a bit of a sane folder structure. Header files and .lib files should really belong in seperate folders\n";
-				std::abort();
-				break;
+				throw std::runtime_error("this program requires a bit of a sane folder structure, header files and .lib files in " + Index.GetRelativePath(entry) + " should really belong in seperate folders");
 			case 3 /* contains .lib, .h and .dll */:
-				std::cout << "This program requires a bit of a sane folder structure. Header files and .lib|.dll files should really belong in seperate folders\n";
-				std::abort();
-				break;
+				throw std::runtime_error("this program requires a bit of a sane folder structure, header files and .lib|.dll files in " + Index.GetRelativePath(entry) + " should really belong in seperate folders");
 			}
 		}
 	}
 
-	void DLLCreator::GenerateLibraryDirectoryCMakeFiles(const std::filesystem::directory_entry& entry)
+	void DLLCreator::GenerateLibraryDirectoryCMakeFiles(const size_t entry)
 	{
 		using namespace Utils;
 		using namespace IO;
 
 		std::vector<std::string> libraryNames{};
 
-		for (const std::filesystem::directory_entry& directory : std::filesystem::directory_iterator(entry))
+		for (const size_t directory : Index.GetChildren(entry))
 		{
+			/* Files next to the libraries (like the CMakeLists.txt of a previous conversion) are not libraries */
+			if (!Index.IsDirectory(directory))
+			{
+				continue;
+			}
+
 			ClearConsole();
 
-			const std::string subDirectory(directory.path().string());
-			const std::string libName(subDirectory.substr(subDirectory.find_last_of('\\') + 1, subDirectory.size() - subDirectory.find_last_of('\\')));
+			const std::string subDirectory(Index.GetPath(directory).string());
+			const std::string libName(Index.GetName(directory));
 			libraryNames.push_back(libName);
 
-			std::cout << "The subdirectory: " << subDirectory << " was found in " << entry.path().string() << "\n";
+			if (BatchManifest)
+			{
+				const LibraryDecision* pLibrary(BatchManifest->FindLibrary(Index.GetRelativePath(directory)));
+
+				if (pLibrary != nullptr)
+				{
+					GenerateLibraryDirectoryCMakeFile(directory, pLibrary->Type);
+					continue;
+				}
+
+				/* Only .h and .cpp folders can be told apart without asking, the .lib folders need their paths */
+				const int8_t libraryType(CheckSubDirectory(directory));
+
+				if (!BatchManifest->bDetectLibraries || libraryType > 1)
+				{
+					throw std::runtime_error("the manifest does not say what type of files " + Index.GetRelativePath(directory) + " contains, add it to \"libraries\"");
+				}
+
+				GenerateLibraryDirectoryCMakeFile(directory, libraryType == 1 ? 1 : 0);
+				continue;
+			}
+
+			std::cout << "The subdirectory: " << subDirectory << " was found in " << Index.GetPath(entry).string() << "\n";
 			std::cout << "The program assumes that this is a Library folder, containing external libraries and will therefore not search any deeper\n";
 
 			std::cout << "What type of files does " << subDirectory << " contain?\n";
@@ -852,39 +1538,9 @@ namespace DLL
 				userInput = ReadUserInput();
 			}
 
-			switch (std::stoi(userInput))
-			{
-			case 0:
-				GenrerateSubDirectoryHCMakeFiles(directory);
-				break;
-			case 1:
-				GenerateSubDirectoryCppCMakeFile(directory);
-				break;
-			case 2:
-				GenerateSubDirectoryHAndLibCMakeFile(directory);
-				break;
-			case 3:
-				GenerateSubDirectoryHAndLibAndDLLCMakeFile(directory);
-				break;
-			}
+			GenerateLibraryDirectoryCMakeFile(directory, static_cast<int8_t>(std::stoi(userInput)));
 		}
 
-		/* open the 3rdParty root CMake file */
-		HANDLE apiFile(
-			CreateFileA((entry.path().string() + "\\CMakeLists.txt").c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(apiFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(apiFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(apiFile);
-
 		std::string fileContents{};
 
 		for (const std::string& libName : libraryNames)
@@ -892,213 +1548,109 @@ namespace DLL
 			fileContents.append("add_subdirectory(" + libName + ")\n");
 		}
 
-		DWORD bytesWritten{};
-		assert(WriteFile(apiFile, fileContents.c_str(), static_cast<DWORD>(fileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::CreateAPIFile() > The API file could not be written to!");
+		/* make the 3rdParty root CMake file */
+		WriteCMakeFile(Index.GetPath(entry).string(), fileContents);
+	}
 
-		assert(CloseHandle(apiFile) != 0 && "DLLCreator::CreateAPIFile() > Handle to file could not be closed!");
+	void DLLCreator::GenerateLibraryDirectoryCMakeFile(const size_t entry, const int8_t libraryType)
+	{
+		switch (libraryType)
+		{
+		case 0:
+			GenrerateSubDirectoryHCMakeFiles(entry);
+			break;
+		case 1:
+			GenerateSubDirectoryCppCMakeFile(entry);
+			break;
+		case 2:
+			GenerateSubDirectoryHAndLibCMakeFile(entry);
+			break;
+		case 3:
+			GenerateSubDirectoryHAndLibAndDLLCMakeFile(entry);
+			break;
+		}
 	}
 
-	void DLLCreator::GenrerateSubDirectoryHCMakeFiles(const std::filesystem::directory_entry& _entry)
+	void DLLCreator::GenrerateSubDirectoryHCMakeFiles(const size_t _entry)
 	{
 		using namespace Utils;
 		using namespace IO;
 
-		const std::string path(_entry.path().string());
-		const std::string libName(path.substr(path.find_last_of('\\') + 1, path.size() - path.find_last_of('\\')));
-
-		/* open the interface preset file */
-		HANDLE cmakeHeaderPresetFile(
-			CreateFileA("Resources/CMakeSubDirectoryHeaderPreset.txt",
-				GENERIC_READ,
-				FILE_SHARE_READ,
-				nullptr,
-				OPEN_EXISTING,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeHeaderPresetFile != INVALID_HANDLE_VALUE);
-
-		std::basic_string<BYTE> fileContents{};
-
-		/* Read the file into a buffer */
-		const DWORD fileSize(GetFileSize(cmakeHeaderPresetFile, nullptr));
-		fileContents.resize(fileSize);
-
-		DWORD readBytes{};
-		assert(ReadFile(cmakeHeaderPresetFile, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > File could not be read!");
-		assert(CloseHandle(cmakeHeaderPresetFile) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > Handle to file could not be closed!");
+		const std::string libName(Index.GetName(_entry));
 
-		std::string convertedFileContents(ConvertToRegularString(fileContents));
-
-		/* Substitute the lib name, header location and project name in */
-		const std::regex libNameRegex("<LIBRARY_NAME>");
-		const std::regex headerLocationRegex("<HEADER_LOCATION>");
-
-		convertedFileContents = std::regex_replace(convertedFileContents, libNameRegex, libName);
-		convertedFileContents = std::regex_replace(convertedFileContents, headerLocationRegex, ""); /* folder contains only headers so... */
+		/* Fill in the interface preset, the folder contains only headers so there is no header location */
+		Presets::SubDirectoryHeaderTemplate.Render({ libName, "" }, CMakeFileContents);
 
 		LibIncludeDirectories.push_back(libName + "IncludeDir");
 
 		/* make the interface file */
-		HANDLE cmakeInterfaceFile(
-			CreateFileA((_entry.path().string() + "\\CMakeLists.txt").c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeInterfaceFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(cmakeInterfaceFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(cmakeInterfaceFile);
-
-		DWORD bytesWritten{};
-		assert(WriteFile(cmakeInterfaceFile, convertedFileContents.c_str(), static_cast<DWORD>(convertedFileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-		assert(CloseHandle(cmakeInterfaceFile) != 0 && "DLLCreator::GenerateRootCMakeFile() > Handle to file could not be closed!");
+		WriteCMakeFile(Index.GetPath(_entry).string(), CMakeFileContents);
 	}
 
-	void DLLCreator::GenerateSubDirectoryCppCMakeFile(const std::filesystem::directory_entry& _entry)
+	void DLLCreator::GenerateSubDirectoryCppCMakeFile(const size_t _entry)
 	{
 		using namespace Utils;
 		using namespace IO;
 
 		std::vector<std::string> filesToAddToLibrary{};
+		std::vector<size_t> sourceEntries{};
 
-		const std::string path(_entry.path().string());
-		const std::string libName(path.substr(path.find_last_of('\\') + 1, path.size() - path.find_last_of('\\')));
+		const std::string libName(Index.GetName(_entry));
 
-		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(_entry))
+		for (const size_t entry : Index.GetChildren(_entry))
 		{
-			if (entry.is_regular_file())
+			/* We don't need to check for any other file, because it doesn't make sense to have .cpp with .lib or .dll files */
+			if (Index.IsRegularFile(entry) && Index.HasAnyKind(entry, FileKind::Source))
 			{
-				const std::string path(entry.path().string());
-
-				/* We don't need to check for any other file, because it doesn't make sense to have .cpp with .lib or .dll files */
-				if (path.find(".cpp") != std::string::npos)
-				{
-					filesToAddToLibrary.push_back(path.substr(path.find_last_of('\\') + 1, path.size()));
-				}
+				filesToAddToLibrary.push_back(std::string(Index.GetName(entry)));
+				sourceEntries.push_back(entry);
 			}
 		}
 
-		std::cout << "For the directory: " << _entry.path().string() << " are all the headers in the same directory as the .cpp files?\n";
-		std::cout << "Y/N >> ";
-
-		std::string userInput{ ReadUserInput() };
-		while (userInput != "Y" && userInput != "N")
-		{
-			ClearConsole();
-
-			std::cout << "Invalid input! Input must be Y or N\n";
-			std::cout << "For the directory: " << _entry.path().string() << " are all the headers in the same directory as the .cpp files?\n";
-			std::cout << "Y/N >> ";
-
-			userInput = ReadUserInput();
-		}
-
-		ClearConsole();
+		const std::string headerLocation(GetHeaderLocation(Index.GetPath(_entry)));
 
-		std::string headerLocation{};
-		if (userInput == "N")
+		std::string sources{};
+		for (const std::string& cppFile : filesToAddToLibrary)
 		{
-			std::cout << "INFO: Headers must be located in the same location\n";
-			std::cout << "Please give the RELATIVE location of all the headers\n";
-			std::cout << "For example: Point2f >\n\tPoint2f.cpp\n\tInclude\n\t\tPoint2f.h\n";
-			std::cout << "Relative location would be Include\n";
-			std::cout << "Relative location of headers: ";
-
-			headerLocation = ReadUserInput();
+			sources.append(cppFile + " ");
 		}
 
-		/* open the cpp preset file */
-		HANDLE cmakeCppPresetFile(
-			CreateFileA("Resources/CMakeSubDirectoryCppPreset.txt",
-				GENERIC_READ,
-				FILE_SHARE_READ,
-				nullptr,
-				OPEN_EXISTING,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeCppPresetFile != INVALID_HANDLE_VALUE);
-
-		std::basic_string<BYTE> fileContents{};
-
-		/* Read the file into a buffer */
-		const DWORD fileSize(GetFileSize(cmakeCppPresetFile, nullptr));
-		fileContents.resize(fileSize);
-
-		DWORD readBytes{};
-		assert(ReadFile(cmakeCppPresetFile, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > File could not be read!");
-		assert(CloseHandle(cmakeCppPresetFile) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > Handle to file could not be closed!");
-
-		std::string convertedFileContents(ConvertToRegularString(fileContents));
+		const std::string precompiledHeaders(GetPrecompiledHeaders(libName, sourceEntries));
 
-		/* Substitute the lib name, header location and project name in */
-		const std::regex libNameRegex("<LIBRARY_NAME>");
-		const std::regex headerLocationRegex("<HEADER_LOCATION>");
+		std::string unitySources{}, unityBatches{};
+		GetUnityBatches(libName, sourceEntries, unitySources, unityBatches);
 
-		convertedFileContents = std::regex_replace(convertedFileContents, libNameRegex, libName);
-		convertedFileContents = std::regex_replace(convertedFileContents, headerLocationRegex, headerLocation);
-
-		const size_t insertPos{ convertedFileContents.find_first_of(')') };
-
-		assert(insertPos != std::string::npos && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > Error making CMake file");
-
-		for (const std::string& cppFile : filesToAddToLibrary)
-		{
-			convertedFileContents.insert(insertPos, cppFile + " ");
-		}
+		/* Fill in the cpp preset */
+		Presets::SubDirectoryCppTemplate.Render({ libName, headerLocation, sources, ConvertToRegularString(ProjectName), precompiledHeaders, unitySources, unityBatches },
+			CMakeFileContents);
 
 		LibIncludeDirectories.push_back(libName + "IncludeDir");
 
 		/* make the cpp file */
-		HANDLE cmakeCppFile(
-			CreateFileA((_entry.path().string() + "\\CMakeLists.txt").c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeCppFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(cmakeCppFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(cmakeCppFile);
-
-		DWORD bytesWritten{};
-		assert(WriteFile(cmakeCppFile, convertedFileContents.c_str(), static_cast<DWORD>(convertedFileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-		assert(CloseHandle(cmakeCppFile) != 0 && "DLLCreator::GenerateRootCMakeFile() > Handle to file could not be closed!");
+		WriteCMakeFile(Index.GetPath(_entry).string(), CMakeFileContents);
 	}
 
-	void DLLCreator::GenerateSubDirectoryCppCMakeFile(const std::string& libName, const std::string& path)
+	void DLLCreator::GenerateSubDirectoryCppCMakeFile(const std::string& libName, const size_t directory)
 	{
 		using namespace Utils;
 		using namespace IO;
 
 		std::vector<std::string> filesToAddToLibrary{};
+		std::vector<size_t> sourceEntries{};
 
-		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path))
+		for (const size_t entry : Index.GetChildren(directory))
 		{
-			if (entry.is_regular_file())
+			if (Index.IsRegularFile(entry))
 			{
-				const std::string path(entry.path().string());
-
 				/* We don't need to check for any other file, because it doesn't make sense to have .cpp with .lib or .dll files */
-				if (path.find(".cpp") != std::string::npos)
+				if (Index.HasAnyKind(entry, FileKind::Source))
 				{
-					filesToAddToLibrary.push_back(path.substr(path.find_last_of('\\') + 1, path.size()));
+					filesToAddToLibrary.push_back(std::string(Index.GetName(entry)));
+					sourceEntries.push_back(entry);
 				}
 			}
 			/* If we find another directory, start this sequence again */
-			else if (entry.is_directory())
+			else if (Index.IsDirectory(entry))
 			{
 				const int8_t subDirectoryType(CheckSubDirectory(entry));
 
@@ -1121,7 +1673,38 @@ namespace DLL
 			}
 		}
 
-		std::cout << "For the directory: " << path << " are all the headers in the same directory as the .cpp files?\n";
+		const std::string headerLocation(GetHeaderLocation(Index.GetPath(directory)));
+
+		std::string sources{};
+		for (const std::string& cppFile : filesToAddToLibrary)
+		{
+			sources.append(cppFile + " ");
+		}
+
+		const std::string precompiledHeaders(GetPrecompiledHeaders(libName, sourceEntries));
+
+		std::string unitySources{}, unityBatches{};
+		GetUnityBatches(libName, sourceEntries, unitySources, unityBatches);
+
+		/* Fill in the cpp preset */
+		Presets::SubDirectoryCppTemplate.Render({ libName, headerLocation, sources, ConvertToRegularString(ProjectName), precompiledHeaders, unitySources, unityBatches },
+			CMakeFileContents);
+
+		/* make the cpp file */
+		WriteCMakeFile(Index.GetPath(directory).string(), CMakeFileContents);
+	}
+
+	std::string DLLCreator::GetHeaderLocation(const std::filesystem::path& directory)
+	{
+		using namespace Utils;
+		using namespace IO;
+
+		if (BatchManifest)
+		{
+			return BatchManifest->GetHeaderLocation(GetRelativePath(directory));
+		}
+
+		std::cout << "For the directory: " << directory.string() << " are all the headers in the same directory as the .cpp files?\n";
 		std::cout << "Y/N >> ";
 
 		std::string userInput{ ReadUserInput() };
@@ -1130,7 +1713,7 @@ namespace DLL
 			ClearConsole();
 
 			std::cout << "Invalid input! Input must be Y or N\n";
-			std::cout << "For the directory: " << path << " are all the headers in the same directory as the .cpp files?\n";
+			std::cout << "For the directory: " << directory.string() << " are all the headers in the same directory as the .cpp files?\n";
 			std::cout << "Y/N >> ";
 
 			userInput = ReadUserInput();
@@ -1150,86 +1733,36 @@ namespace DLL
 			headerLocation = ReadUserInput();
 		}
 
-		/* open the cpp preset file */
-		HANDLE cmakeCppPresetFile(
-			CreateFileA("Resources/CMakeSubDirectoryCppPreset.txt",
-				GENERIC_READ,
-				FILE_SHARE_READ,
-				nullptr,
-				OPEN_EXISTING,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeCppPresetFile != INVALID_HANDLE_VALUE);
-
-		std::basic_string<BYTE> fileContents{};
-
-		/* Read the file into a buffer */
-		const DWORD fileSize(GetFileSize(cmakeCppPresetFile, nullptr));
-		fileContents.resize(fileSize);
-
-		DWORD readBytes{};
-		assert(ReadFile(cmakeCppPresetFile, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > File could not be read!");
-		assert(CloseHandle(cmakeCppPresetFile) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > Handle to file could not be closed!");
-
-		std::string convertedFileContents(ConvertToRegularString(fileContents));
-
-		/* Substitute the lib name, header location and project name in */
-		const std::regex libNameRegex("<LIBRARY_NAME>");
-		const std::regex headerLocationRegex("<HEADER_LOCATION>");
-		const std::regex projectNameRegex("<PROJECT_NAME>");
-
-		convertedFileContents = std::regex_replace(convertedFileContents, libNameRegex, libName);
-		convertedFileContents = std::regex_replace(convertedFileContents, headerLocationRegex, headerLocation);
-		convertedFileContents = std::regex_replace(convertedFileContents, projectNameRegex, ConvertToRegularString(ProjectName));
-
-		const size_t insertPos{ convertedFileContents.find_first_of(')') };
-
-		assert(insertPos != std::string::npos && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > Error making CMake file");
-
-		for (const std::string& cppFile : filesToAddToLibrary)
-		{
-			convertedFileContents.insert(insertPos, cppFile + " ");
-		}
-
-		/* make the cpp file */
-		HANDLE cmakeCppFile(
-			CreateFileA((path + "\\CMakeLists.txt").c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeCppFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(cmakeCppFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(cmakeCppFile);
-
-		DWORD bytesWritten{};
-		assert(WriteFile(cmakeCppFile, convertedFileContents.c_str(), static_cast<DWORD>(convertedFileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-		assert(CloseHandle(cmakeCppFile) != 0 && "DLLCreator::GenerateRootCMakeFile() > Handle to file could not be closed!");
+		return headerLocation;
 	}
 
-	void DLLCreator::GenerateSubDirectoryHAndLibCMakeFile(const std::filesystem::directory_entry& _entry)
+	void DLLCreator::GenerateSubDirectoryHAndLibCMakeFile(const size_t _entry)
 	{
 		using namespace Utils;
 		using namespace IO;
 
-		const std::string path(_entry.path().string());
-		const std::string libName(path.substr(path.find_last_of('\\') + 1, path.size() - path.find_last_of('\\')));
+		const std::string path(Index.GetPath(_entry).string());
+		const std::string libName(Index.GetName(_entry));
 
-		std::cout << "What is the RELATIVE path for the .lib files?\n";
-		std::cout << "The path must be relative to: " << _entry.path().string() << "\n";
-		std::cout << "Example:\n";
-		std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
-		std::cout << "Relative path is: /source\n";
-		std::cout << "Enter relative path: ";
+		/* In batch mode the manifest knows where the .lib and .h files are */
+		const LibraryDecision* pLibrary(BatchManifest ? BatchManifest->FindLibrary(Index.GetRelativePath(_entry)) : nullptr);
 
-		std::string sourcePath(ReadUserInput());
+		std::string sourcePath{};
+		if (pLibrary != nullptr)
+		{
+			sourcePath = pLibrary->SourcePath;
+		}
+		else
+		{
+			std::cout << "What is the RELATIVE path for the .lib files?\n";
+			std::cout << "The path must be relative to: " << path << "\n";
+			std::cout << "Example:\n";
+			std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
+			std::cout << "Relative path is: /source\n";
+			std::cout << "Enter relative path: ";
+
+			sourcePath = ReadUserInput();
+		}
 
 		if (sourcePath[0] != '/')
 		{
@@ -1238,94 +1771,65 @@ namespace DLL
 
 		ClearConsole();
 
-		std::cout << "What is the RELATIVE path for the .h files?\n";
-		std::cout << "The path must be relative to: " << _entry.path().string() << "\n";
-		std::cout << "Example:\n";
-		std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
-		std::cout << "Relative path is: /include\n";
-		std::cout << "Enter relative path: ";
-
-		std::string includePath(ReadUserInput());
+		std::string includePath{};
+		if (pLibrary != nullptr)
+		{
+			includePath = pLibrary->IncludePath;
+		}
+		else
+		{
+			std::cout << "What is the RELATIVE path for the .h files?\n";
+			std::cout << "The path must be relative to: " << path << "\n";
+			std::cout << "Example:\n";
+			std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
+			std::cout << "Relative path is: /include\n";
+			std::cout << "Enter relative path: ";
+
+			includePath = ReadUserInput();
+		}
 
 		if (includePath[0] != '/')
 		{
 			includePath.insert(0, 1, '/');
 		}
 
-		/* open the dll preset file */
-		HANDLE cmakeLibPresetFile(
-			CreateFileA("Resources/CMakeSubDirectoryLibPreset.txt",
-				GENERIC_READ,
-				FILE_SHARE_READ,
-				nullptr,
-				OPEN_EXISTING,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeLibPresetFile != INVALID_HANDLE_VALUE);
-
-		std::basic_string<BYTE> fileContents{};
-
-		/* Read the file into a buffer */
-		const DWORD fileSize(GetFileSize(cmakeLibPresetFile, nullptr));
-		fileContents.resize(fileSize);
-
-		DWORD readBytes{};
-		assert(ReadFile(cmakeLibPresetFile, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > File could not be read!");
-		assert(CloseHandle(cmakeLibPresetFile) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > Handle to file could not be closed!");
-
-		std::string convertedFileContents(ConvertToRegularString(fileContents));
-
-		/* Substitute the lib name, header location and project name in */
-		const std::regex libNameRegex("<LIBRARY_NAME>");
-		const std::regex headerLocationRegex("<HEADER_LOCATION>");
-		const std::regex sourceLocationRegex("<SOURCE_LOCATION>");
-
-		convertedFileContents = std::regex_replace(convertedFileContents, libNameRegex, libName);
-		convertedFileContents = std::regex_replace(convertedFileContents, headerLocationRegex, includePath);
-		convertedFileContents = std::regex_replace(convertedFileContents, sourceLocationRegex, sourcePath);
+		/* Fill in the lib preset */
+		Presets::SubDirectoryLibTemplate.Render({ libName, includePath, sourcePath }, CMakeFileContents);
 
 		LibIncludeDirectories.push_back(libName + "IncludeDir");
 		LibSourceDirectories.push_back(libName + "SourceDir");
 
 		/* make the header + lib file */
-		HANDLE cmakeLibFile(
-			CreateFileA((_entry.path().string() + "\\CMakeLists.txt").c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeLibFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(cmakeLibFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(cmakeLibFile);
-
-		DWORD bytesWritten{};
-		assert(WriteFile(cmakeLibFile, convertedFileContents.c_str(), static_cast<DWORD>(convertedFileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-		assert(CloseHandle(cmakeLibFile) != 0 && "DLLCreator::GenerateSubDirectoryHAndLibCMakeFile() > Handle to file could not be closed!");
+		WriteCMakeFile(path, CMakeFileContents);
 	}
 
-	void DLLCreator::GenerateSubDirectoryHAndLibAndDLLCMakeFile(const std::filesystem::directory_entry& _entry)
+	void DLLCreator::GenerateSubDirectoryHAndLibAndDLLCMakeFile(const size_t _entry)
 	{
 		using namespace Utils;
 		using namespace IO;
 
-		const std::string path(_entry.path().string());
-		const std::string libName(path.substr(path.find_last_of('\\') + 1, path.size() - path.find_last_of('\\')));
+		const std::string path(Index.GetPath(_entry).string());
+		const std::string libName(Index.GetName(_entry));
 
-		std::cout << "What is the RELATIVE path for the .lib and .dll files?\n";
-		std::cout << "The path must be relative to: " << _entry.path().string() << "\n";
-		std::cout << "Example:\n";
-		std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
-		std::cout << "Relative path is: /source\n";
-		std::cout << "Enter relative path: ";
+		/* In batch mode the manifest knows where the .lib and .h files are */
+		const LibraryDecision* pLibrary(BatchManifest ? BatchManifest->FindLibrary(Index.GetRelativePath(_entry)) : nullptr);
 
-		std::string sourcePath(ReadUserInput());
+		std::string sourcePath{};
+		if (pLibrary != nullptr)
+		{
+			sourcePath = pLibrary->SourcePath;
+		}
+		else
+		{
+			std::cout << "What is the RELATIVE path for the .lib and .dll files?\n";
+			std::cout << "The path must be relative to: " << path << "\n";
+			std::cout << "Example:\n";
+			std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
+			std::cout << "Relative path is: /source\n";
+			std::cout << "Enter relative path: ";
+
+			sourcePath = ReadUserInput();
+		}
 
 		if (sourcePath[0] != '/')
 		{
@@ -1334,100 +1838,60 @@ namespace DLL
 
 		std::vector<std::string> dllsToCopy{};
 
-		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(_entry.path().string() + sourcePath))
-		{
-			assert(entry.is_regular_file() && "DLLCreator::GenerateSubDirectoryHAndLibAndDLLCMakeFile() > Source folder may not contain sub directories");
+		const size_t sourceDirectory(Index.Find(Index.GetRelativePath(_entry) + sourcePath));
+		assert(sourceDirectory != FileIndex::NoNode && Index.IsDirectory(sourceDirectory) && "DLLCreator::GenerateSubDirectoryHAndLibAndDLLCMakeFile() > Source folder does not exist");
 
-			const std::string path(entry.path().string());
+		for (const size_t entry : Index.GetChildren(sourceDirectory))
+		{
+			assert(Index.IsRegularFile(entry) && "DLLCreator::GenerateSubDirectoryHAndLibAndDLLCMakeFile() > Source folder may not contain sub directories");
 
-			if (path.find(".dll") != std::string::npos)
+			if (Index.HasAnyKind(entry, FileKind::DynamicLibrary))
 			{
-				dllsToCopy.push_back(path.substr(path.find_last_of('\\') + 1));
+				dllsToCopy.push_back(std::string(Index.GetName(entry)));
 			}
 		}
 
 		ClearConsole();
 
-		std::cout << "What is the RELATIVE path for the .h files?\n";
-		std::cout << "The path must be relative to: " << _entry.path().string() << "\n";
-		std::cout << "Example:\n";
-		std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
-		std::cout << "Relative path is: /include\n";
-		std::cout << "Enter relative path: ";
-
-		std::string includePath(ReadUserInput());
+		std::string includePath{};
+		if (pLibrary != nullptr)
+		{
+			includePath = pLibrary->IncludePath;
+		}
+		else
+		{
+			std::cout << "What is the RELATIVE path for the .h files?\n";
+			std::cout << "The path must be relative to: " << path << "\n";
+			std::cout << "Example:\n";
+			std::cout << "SDL2\n\t\tinclude\n\t\tsource\n";
+			std::cout << "Relative path is: /include\n";
+			std::cout << "Enter relative path: ";
+
+			includePath = ReadUserInput();
+		}
 
 		if (includePath[0] != '/')
 		{
 			includePath.insert(0, 1, '/');
 		}
 
-		/* open the dll preset file */
-		HANDLE cmakeDLLPresetFile(
-			CreateFileA("Resources/CMakeSubDirectoryDLLPreset.txt",
-				GENERIC_READ,
-				FILE_SHARE_READ,
-				nullptr,
-				OPEN_EXISTING,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeDLLPresetFile != INVALID_HANDLE_VALUE);
-
-		std::basic_string<BYTE> fileContents{};
-
-		/* Read the file into a buffer */
-		const DWORD fileSize(GetFileSize(cmakeDLLPresetFile, nullptr));
-		fileContents.resize(fileSize);
-
-		DWORD readBytes{};
-		assert(ReadFile(cmakeDLLPresetFile, fileContents.data(), fileSize, &readBytes, nullptr) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > File could not be read!");
-		assert(CloseHandle(cmakeDLLPresetFile) != 0 && "DLLCreator::GenerateSubDirectoryCppCMakeFile() > Handle to file could not be closed!");
-
-		std::string convertedFileContents(ConvertToRegularString(fileContents));
-
 		std::string dlls{};
 
+		/* Values are not searched for placeholders, so the source location goes straight into the dll paths */
 		for (const std::string& dllFile : dllsToCopy)
 		{
-			dlls.append("${CMAKE_CURRENT_SOURCE_DIR}<SOURCE_LOCATION>/" + dllFile + " ");
+			dlls.append("${CMAKE_CURRENT_SOURCE_DIR}" + sourcePath + "/" + dllFile + " ");
 		}
 
-		/* Substitute the lib name, header location and project name in */
-		const std::regex libNameRegex("<LIBRARY_NAME>");
-		const std::regex headerLocationRegex("<HEADER_LOCATION>");
-		const std::regex sourceLocationRegex("<SOURCE_LOCATION>");
-		const std::regex dllsRegex("<DLLS>");
-
-		convertedFileContents = std::regex_replace(convertedFileContents, dllsRegex, dlls);
-		convertedFileContents = std::regex_replace(convertedFileContents, libNameRegex, libName);
-		convertedFileContents = std::regex_replace(convertedFileContents, headerLocationRegex, includePath);
-		convertedFileContents = std::regex_replace(convertedFileContents, sourceLocationRegex, sourcePath);
+		/* Fill in the dll preset */
+		Presets::SubDirectoryDLLTemplate.Render({ libName, includePath, sourcePath, dlls }, CMakeFileContents);
 
 		LibIncludeDirectories.push_back(libName + "IncludeDir");
 		LibSourceDirectories.push_back(libName + "SourceDir");
 		DllDirectories.push_back(libName + "Dlls");
 
 		/* make the header + lib file */
-		HANDLE cmakeDLLFile(
-			CreateFileA((_entry.path().string() + "\\CMakeLists.txt").c_str(),
-				GENERIC_WRITE,
-				FILE_SHARE_WRITE,
-				nullptr,
-				OPEN_ALWAYS,
-				FILE_ATTRIBUTE_NORMAL,
-				nullptr)
-		);
-
-		assert(cmakeDLLFile != INVALID_HANDLE_VALUE);
-
-		SetFilePointer(cmakeDLLFile, 0, nullptr, FILE_BEGIN);
-		SetEndOfFile(cmakeDLLFile);
-
-		DWORD bytesWritten{};
-		assert(WriteFile(cmakeDLLFile, convertedFileContents.c_str(), static_cast<DWORD>(convertedFileContents.size()), &bytesWritten, nullptr) != 0 && "DLLCreator::AddMacroToFilteredHeaderFiles() > The new header file could not be written to!");
-		assert(CloseHandle(cmakeDLLFile) != 0 && "DLLCreator::GenerateSubDirectoryHAndLibCMakeFile() > Handle to file could not be closed!");
+		WriteCMakeFile(path, CMakeFileContents);
 	}
 
 	/* returns
@@ -1435,30 +1899,32 @@ namespace DLL
 	1 if directory contains .cpp files,
 	2 if directory contains only .h and .lib,
 	3 if directory contains .lib, .h and .dll */
-	int8_t DLLCreator::CheckSubDirectory(const std::filesystem::directory_entry& _entry)
+	int8_t DLLCreator::CheckSubDirectory(const size_t _entry) const
 	{
+		using FileKind = Utils::IO::FileKind;
+
 		bool bHasDlls(false), bHasLibs(false), bHasOnlyHeaders(false), bOnlyDirectories(true);
-		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(_entry))
+		for (const size_t entry : Index.GetChildren(_entry))
 		{
-			if (entry.is_regular_file())
+			if (Index.IsRegularFile(entry))
 			{
-				const std::string path(entry.path().string());
+				const FileKind kind(Index.GetKind(entry));
 
-				if (path.find(".cpp") != std::string::npos)
+				if (HasAnyKind(kind, FileKind::Source))
 				{
 					return 1;
 				}
-				else if (path.find(".dll") != std::string::npos)
+				else if (HasAnyKind(kind, FileKind::DynamicLibrary))
 				{
 					bHasDlls = true;
 					bHasOnlyHeaders = false;
 				}
-				else if (path.find(".lib") != std::string::npos)
+				else if (HasAnyKind(kind, FileKind::StaticLibrary))
 				{
 					bHasLibs = true;
 					bHasOnlyHeaders = false;
 				}
-				else if (path.find(".h") != std::string::npos)
+				else if (HasAnyKind(kind, FileKind::Header))
 				{
 					bHasOnlyHeaders = true;
 				}
@@ -1485,15 +1951,22 @@ namespace DLL
 
 	std::string DLLCreator::FindVcxprojFilePath() const
 	{
+		/* The manifest can name the vcxproj, in which case there is nothing to search for */
+		if (BatchManifest && !BatchManifest->VcxprojPath.empty())
+		{
+			return (std::filesystem::path(Utils::IO::ConvertToRegularString(RootPath)) / BatchManifest->VcxprojPath).make_preferred().string();
+		}
+
 		/* First search through the root path entries */
 
+		using FileKind = Utils::IO::FileKind;
+
 		std::string vcxprojFilePath{};
-		const std::string suffix(".vcxproj");
-		for (const std::filesystem::directory_entry& entry : PathEntries)
+		for (const size_t entry : PathEntries)
 		{
-			if (std::equal(suffix.rbegin(), suffix.rend(), entry.path().string().rbegin()))
+			if (Index.HasAnyKind(entry, FileKind::Project))
 			{
-				vcxprojFilePath = entry.path().string();
+				vcxprojFilePath = Index.GetPath(entry).string();
 				break;
 			}
 		}
@@ -1501,26 +1974,56 @@ namespace DLL
 		/* Check if we found a vcxproj file */
 		if (vcxprojFilePath.empty())
 		{
-			/* if we didn't, recursively search through every file to find it */
-			for (const std::filesystem::directory_entry& path : PathEntries)
+			/* if we didn't, search through every directory to find it, depth first, the files of a directory before its sub directories */
+			std::vector<size_t> directoriesToSearch{};
+
+			for (auto it(PathEntries.crbegin()); it != PathEntries.crend(); ++it)
+			{
+				if (Index.IsDirectory(*it))
+				{
+					directoriesToSearch.push_back(*it);
+				}
+			}
+
+			while (!directoriesToSearch.empty() && vcxprojFilePath.empty())
 			{
-				for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path))
+				const size_t directory(directoriesToSearch.back());
+				directoriesToSearch.pop_back();
+
+				for (const size_t entry : Index.GetChildren(directory))
 				{
-					if (std::equal(suffix.rbegin(), suffix.rend(), entry.path().string().rbegin()))
+					if (Index.HasAnyKind(entry, FileKind::Project))
 					{
-						vcxprojFilePath = entry.path().string();
+						vcxprojFilePath = Index.GetPath(entry).string();
 						break;
 					}
 				}
+
+				/* Push in reverse, so the first child gets searched first */
+				for (const size_t entry : Index.GetChildren(directory) | std::views::reverse)
+				{
+					if (Index.IsDirectory(entry))
+					{
+						directoriesToSearch.push_back(entry);
+					}
+				}
+			}
+		}
+
+		/* if after all this we *still* haven't found the vcxproj, ask the user for the location */
+		if (vcxprojFilePath.empty())
+		{
+			if (BatchManifest)
+			{
+				throw std::runtime_error("no .vcxproj file was found in " + Utils::IO::ConvertToRegularString(RootPath) + ", set \"vcxproj\" in the manifest");
 			}
 
-			/* if after all this we *still* haven't found the vcxproj, ask the user for the location */
 			std::string input;
 			do
 			{
 				std::cout << "\nPlease enter the absolute path to the .vcxproj file\n";
 				input = Utils::IO::ReadUserInput();
-			} while (input.find(".vcxproj") != std::string::npos);
+			} while (input.find(".vcxproj") == std::string::npos);
 
 			vcxprojFilePath = input;
 		}
@@ -1528,56 +2031,41 @@ namespace DLL
 		return vcxprojFilePath;
 	}
 
-	void DLLCreator::PrintDirectoryContents(const std::filesystem::directory_entry& entry)
+	void DLLCreator::PrintDirectoryContents(const size_t directory)
 	{
-		Utils::IO::ClearConsole();
+		using FileKind = Utils::IO::FileKind;
 
-		std::vector<std::filesystem::directory_entry> entries{};
+		ClearConsole();
+
+		std::vector<size_t> entries{};
 
-		for (const std::filesystem::directory_entry& _entry : std::filesystem::directory_iterator(entry))
+		for (const size_t entry : Index.GetChildren(directory))
 		{
-			entries.push_back(_entry);
+			entries.push_back(entry);
 		}
 
-		/* Sort all entries, first all files, then all directories */
-		std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b)->bool
+		/* Sort all entries, first all files, then all directories, both sorted on name */
+		std::stable_sort(entries.begin(), entries.end(), [this](const size_t a, const size_t b)->bool
 			{
 				/* Files => Directories */
-				return static_cast<int>(a.is_directory()) < static_cast<int>(b.is_directory());
+				return static_cast<int>(Index.IsDirectory(a)) < static_cast<int>(Index.IsDirectory(b));
 
 				/* Directories => Files */
-				//return static_cast<int>(a.is_directory()) > static_cast<int>(b.is_directory());
+				//return static_cast<int>(Index.IsDirectory(a)) > static_cast<int>(Index.IsDirectory(b));
 			});
 
 		/* Exclude certain files we know should not be converted already */
-		entries.erase(std::remove_if(entries.begin(), entries.end(), [](const std::filesystem::directory_entry& entry)
-			{
-				const std::string path(entry.path().string());
-
-				return path.find(".sln") != std::string::npos ||
-					path.find(".vcxproj.user") != std::string::npos ||
-					path.find(".vcxproj.filters") != std::string::npos ||
-					path.find(".rar") != std::string::npos ||
-					path.find(".zip") != std::string::npos ||
-					path.find(".txt") != std::string::npos ||
-					path.find(".props") != std::string::npos ||
-					path.find(".bin") != std::string::npos ||
-					path.find(".exe") != std::string::npos ||
-					path.find(".lib") != std::string::npos ||
-					path.find(".dll") != std::string::npos ||
-					path.find(".cpp") != std::string::npos ||
-					path.find(".vs") != std::string::npos ||
-					path.find("x64") != std::string::npos ||
-					path.find("Release") != std::string::npos ||
-					path.find("Debug") != std::string::npos ||
-					path.find("x86") != std::string::npos;
+		entries.erase(std::remove_if(entries.begin(), entries.end(), [this](const size_t entry)
+			{
+				/* Source files and libraries are never headers either */
+				return Classifier.IsExcluded(Index.GetKind(entry)) || Index.HasAnyKind(entry, FileKind::Source | FileKind::StaticLibrary | FileKind::DynamicLibrary);
 			}), entries.end());
 
 		bool bAreFilesPresent(false), bAreDirectoriesPresent(false);
 		/* Print everything inside of this directory */
 		for (size_t i{}; i < entries.size(); ++i)
 		{
-			if (entries[i].is_regular_file())
+			if (Index.IsRegularFile(entries[i]))
 			{
 				std::cout << std::to_string(i) + ". File:\t";
 				bAreFilesPresent = true;
@@ -1588,7 +2076,7 @@ namespace DLL
 				bAreDirectoriesPresent = true;
 			}
 
-			std::cout << entries[i].path().string() << "\n";
+			std::cout << Index.GetPath(entries[i]).string() << "\n";
 		}
 
 		/* Get what files should be converted */
@@ -1602,9 +2090,9 @@ namespace DLL
 
 			if (input == "ALL")
 			{
-				for (const auto& entry : entries)
+				for (const size_t entry : entries)
 				{
-					FilteredFilePaths.push_back(entry.path().string());
+					FilteredFilePaths.push_back(Index.GetPath(entry).string());
 				}
 			}
 			if (input != "NONE")
@@ -1613,9 +2101,9 @@ namespace DLL
 				for (const size_t i : indices)
 				{
 					/* make sure the index is valid */
-					if (i < entries.size() && entries[i].is_regular_file())
+					if (i < entries.size() && Index.IsRegularFile(entries[i]))
 					{
-						FilteredFilePaths.push_back(entries[i].path().string());
+						FilteredFilePaths.push_back(Index.GetPath(entries[i]).string());
 					}
 				}
 			}
@@ -1633,7 +2121,7 @@ namespace DLL
 				for (const size_t i : indices)
 				{
 					/* make sure the index is valid */
-					if (i < entries.size() && entries[i].is_directory())
+					if (i < entries.size() && Index.IsDirectory(entries[i]))
 					{
 						PrintDirectoryContents(entries[i]);
 					}
@@ -1642,6 +2130,56 @@ namespace DLL
 		}
 	}
 
+	void DLLCreator::WriteHeaderFile(const std::string& path, const std::basic_string<unsigned char /* BYTE */>& fileContents, [[maybe_unused]] const int fileNumber)
+	{
+#ifdef WRITE_TO_TEST_FILE
+		/* write the altered header to a test file */
+		[[maybe_unused]] const bool bWritten(WriteOutputFile(std::string("Test") + std::to_string(fileNumber) + ".txt", fileContents));
+#else
+		[[maybe_unused]] const bool bWritten(WriteOutputFile(path, fileContents));
+#endif
+		assert(bWritten && "DLLCreator::WriteHeaderFile() > The new header file could not be written to!");
+	}
+
+	void DLLCreator::WriteCMakeFile(const std::string& directory, const std::string& fileContents)
+	{
+		const std::basic_string_view<BYTE> contents(reinterpret_cast<const BYTE*>(fileContents.data()), fileContents.size());
+
+		[[maybe_unused]] const bool bWritten(WriteOutputFile((std::filesystem::path(directory) / "CMakeLists.txt").string(), contents));
+		assert(bWritten && "DLLCreator::WriteCMakeFile() > The CMake file could not be written to!");
+	}
+
+	bool DLLCreator::WriteOutputFile(const std::string& filePath, const std::basic_string_view<unsigned char /* BYTE */> contents)
+	{
+		const Utils::Trace::Clock::time_point begin(Utils::Trace::Clock::now());
+		const Utils::IO::WriteResult result(Utils::IO::WriteFileIfChanged(filePath, contents));
+
+		if (Trace.IsEnabled())
+		{
+			using Utils::Json::Value;
+
+			Value args(Value::MakeObject());
+			args.Set("file", Value::MakeString(GetRelativePath(filePath)));
+			args.Set("bytes", Value::MakeNumber(static_cast<double>(contents.size())));
+			args.Set("unchanged", Value::MakeBoolean(result == Utils::IO::WriteResult::Unchanged));
+
+			Trace.AddEvent("Write", "io", begin, Utils::Trace::Clock::now(), std::move(args));
+		}
+
+		switch (result)
+		{
+		case Utils::IO::WriteResult::Written:
+			++NrOfWrittenFiles;
+			Statistics.NrOfBytesWritten += contents.size();
+			return true;
+		case Utils::IO::WriteResult::Unchanged:
+			++NrOfUnchangedFiles;
+			return true;
+		default:
+			return false;
+		}
+	}
+
 	std::vector<size_t> DLLCreator::GetNumbersFromCSVString(const std::string& _userInput) const
 	{
 		std::vector<size_t> numbers{};
@@ -1674,14 +2212,35 @@ namespace DLL
 
 	size_t DLLCreator::GetNumberOfDirectoriesDeep(const std::string& filePath) const
 	{
-		const size_t countRootPath(std::count(RootPath.cbegin(), RootPath.cend(), '\\'));
-		size_t countOtherPath(std::count(filePath.cbegin(), filePath.cend(), '\\'));
+		const auto isSeparator([](const auto c)->bool
+			{
+				return c == '\\' || c == '/';
+			});
 
-		if (!std::filesystem::directory_entry(filePath).is_directory())
+		const size_t countRootPath(std::count_if(RootPath.cbegin(), RootPath.cend(), isSeparator));
+		size_t countOtherPath(std::count_if(filePath.cbegin(), filePath.cend(), isSeparator));
+
+		if (const size_t node(Index.Find(GetRelativePath(filePath))); node == Utils::IO::FileIndex::NoNode || !Index.IsDirectory(node))
 		{
 			--countOtherPath;
 		}
 
 		return countOtherPath - countRootPath;
 	}
+
+	std::string DLLCreator::GetRelativePath(const std::filesystem::path& path) const
+	{
+		const std::filesystem::path rootPath(Utils::IO::ConvertToRegularString(RootPath));
+
+		return path.lexically_normal().lexically_relative(rootPath.lexically_normal()).generic_string();
+	}
+
+	void DLLCreator::ClearConsole() const
+	{
+		/* Nobody is watching the console in batch mode */
+		if (!BatchManifest)
+		{
+			Utils::IO::ClearConsole();
+		}
+	}
 }
\ No newline at end of file
@@ -2,8 +2,21 @@
 
 #define __STDC_WANT_LIB_EXT1__ 1 /* strncpy_s */
 #include <string> /* std::string */
+#include <string_view> /* std::basic_string_view */
 #include <vector> /* std::vector */
 #include <filesystem> /* std::filesystem */
+#include <optional> /* std::optional */
+#include <cstdint> /* uintmax_t */
+
+#include "../Utils/FileIndex.h"
+#include "../Utils/ExportAnalysis.h"
+#include "../Utils/Trace.h"
+
+#include "Manifest.h"
+#include "PrecompiledHeaders.h"
+#include "UnityBuild.h"
+#include "ConversionState.h"
+#include "BuildSettings.h"
 
 // #define WRITE_TO_TEST_FILE
 
@@ -14,36 +27,115 @@ namespace DLL
 	public:
 		DLLCreator(const std::string& rootPath, const std::string& outputPath);
 
-		void Convert();
+		/* Takes every decision from the manifest instead of asking the user, so no console input is needed.
+		nrOfThreads is how many threads read the source tree and rewrite the headers, 0 means one per hardware thread */
+		explicit DLLCreator(const Manifest& manifest, const size_t nrOfThreads = 0);
+
+		/* GenerateFiles() followed by RunCMake(), returns false and prints why if either failed.
+		Ends with a one line summary of where the time went and how many bytes were read and written */
+		bool Convert(const BuildSettings& build);
+
+		/* Everything but running CMake: the .vcxproj, the API file, the headers and the CMake files.
+		Throws std::runtime_error when the project can not be converted, like when a header of the manifest can not be read */
+		void GenerateFiles();
+		/* Configures and builds the generated CMake files as build says, unless the manifest says not to, and prints the summary.
+		Returns false and fills in error if CMake could not be started, failed or ran out of time */
+		bool RunCMake(const BuildSettings& build, std::string& error);
+
+		/* Records every step and every file Convert() reads or writes as an event of GetTrace(), call before Convert() */
+		void EnableTrace();
+		const Utils::Trace::Recorder& GetTrace() const { return Trace; }
 
 	private:
+		/* What Convert() spent its time on. Per file times add up over every thread, so they can exceed the step they are part of */
+		struct ConversionStatistics final
+		{
+			Utils::Trace::Clock::duration StateTime{}; /* loading and saving the conversion state */
+			Utils::Trace::Clock::duration ScanTime{};
+			Utils::Trace::Clock::duration FilterTime{}; /* includes answering the questions and loading the symbols */
+			Utils::Trace::Clock::duration ProjectTime{};
+			Utils::Trace::Clock::duration APIFileTime{};
+			Utils::Trace::Clock::duration HeaderTime{};
+			Utils::Trace::Clock::duration CMakeGenerationTime{};
+			Utils::Trace::Clock::duration CMakeQueueTime{}; /* from GenerateFiles() being done until RunCMake() got called */
+			Utils::Trace::Clock::duration CMakeConfigureTime{};
+			Utils::Trace::Clock::duration CMakeBuildTime{};
+			Utils::Trace::Clock::duration ReadTime{}; /* per file */
+			Utils::Trace::Clock::duration RewriteTime{}; /* per header, parsing, analyzing and editing */
+			size_t NrOfScannedFiles{};
+			size_t NrOfCompilerCacheHits{}; /* of the CMake build */
+			size_t NrOfCompilerCacheMisses{};
+			size_t NrOfPrecompilingLibraries{};
+			uint64_t NrOfLinesToParse{}; /* estimated, for the sources of the .cpp libraries, without and with their precompiled headers */
+			uint64_t NrOfPrecompiledLinesToParse{};
+			size_t NrOfUnitySources{}; /* merged into batches */
+			size_t NrOfUnityBatches{};
+			size_t NrOfRewrittenHeaders{};
+			uintmax_t NrOfBytesRead{};
+			uintmax_t NrOfBytesWritten{};
+		};
+
+		void PrintSummary(const Utils::Trace::Clock::duration totalTime) const;
+		/* Reads filePath into contents and adds the time it took to readTime, safe to call from any thread */
+		bool ReadInputFile(const std::string& filePath, std::basic_string<unsigned char /* BYTE */>& contents, Utils::Trace::Clock::duration& readTime) const;
+
 		void GetAllFilesAndDirectories();
 		void FilterFilesAndDirectories();
+		/* Reads the libraries, object files and symbol lists the manifest names into Symbols */
+		void LoadSymbols();
 		void DefinePreprocessorMacro();
 		void CreateAPIFile();
 		void AddMacroToFilteredHeaderFiles();
+		/* The batch version of AddMacroToFilteredHeaderFiles(), headers are rewritten in parallel and written in manifest order */
+		void RewriteFilteredHeaderFiles();
 		void GenerateCMakeFiles();
-		void ExecuteCMake();
+		/* Streams the output of both CMake runs with the project name in front, returns false and fills in error if either fails */
+		bool ExecuteCMake(const BuildSettings& build, std::string& error);
 
 		void GenerateRootCMakeFile();
-		void GenerateSubDirectoryCMakeFiles(const std::filesystem::directory_entry& entry);
-		void GenerateLibraryDirectoryCMakeFiles(const std::filesystem::directory_entry& entry);
-		void GenrerateSubDirectoryHCMakeFiles(const std::filesystem::directory_entry& _entry);
-		void GenerateSubDirectoryCppCMakeFile(const std::filesystem::directory_entry& _entry);
-		void GenerateSubDirectoryCppCMakeFile(const std::string& libName, const std::string& path);
-		void GenerateSubDirectoryHAndLibCMakeFile(const std::filesystem::directory_entry& _entry);
-		void GenerateSubDirectoryHAndLibAndDLLCMakeFile(const std::filesystem::directory_entry& _entry);
+		/* All folders are passed as nodes of Index */
+		void GenerateSubDirectoryCMakeFiles(const size_t directory);
+		void GenerateLibraryDirectoryCMakeFiles(const size_t directory);
+		/* libraryType is one of the options GenerateLibraryDirectoryCMakeFiles() asks for, 0 to 3 */
+		void GenerateLibraryDirectoryCMakeFile(const size_t directory, const int8_t libraryType);
+		void GenrerateSubDirectoryHCMakeFiles(const size_t directory);
+		void GenerateSubDirectoryCppCMakeFile(const size_t directory);
+		void GenerateSubDirectoryCppCMakeFile(const std::string& libName, const size_t directory);
+		/* The <PRECOMPILED_HEADERS> of the library of sources, quoted for CMake, empty if it is not worth it or the manifest turned them off */
+		std::string GetPrecompiledHeaders(const std::string& libName, const std::vector<size_t>& sources);
+		/* The <UNITY_SOURCES> and <UNITY_BATCHES> of the library of sources, both empty unless the manifest asks for a unity build */
+		void GetUnityBatches(const std::string& libName, const std::vector<size_t>& sources, std::string& unitySources, std::string& unityBatches);
+		/* ReadInputFile() for the sources the CMake files are generated for, counted in the statistics */
+		bool ReadSourceFile(const std::string& filePath, std::basic_string<unsigned char /* BYTE */>& contents);
+		/* Asks the user (or the manifest) where the headers of a folder with .cpp files are, relative to that folder */
+		std::string GetHeaderLocation(const std::filesystem::path& directory);
+		void GenerateSubDirectoryHAndLibCMakeFile(const size_t directory);
+		void GenerateSubDirectoryHAndLibAndDLLCMakeFile(const size_t directory);
 
 		/* returns
 		0 if directory contains only .h files
 		1 if directory contains .cpp files,
 		2 if directory contains only .h and .lib,
 		3 if directory contains .lib, .h and .dll */
-		int8_t CheckSubDirectory(const std::filesystem::directory_entry& _entry);
+		int8_t CheckSubDirectory(const size_t directory) const;
 		std::string FindVcxprojFilePath() const;
-		void PrintDirectoryContents(const std::filesystem::directory_entry& entry);
+		void PrintDirectoryContents(const size_t directory);
 		std::vector<size_t> GetNumbersFromCSVString(const std::string& userInput) const;
 		size_t GetNumberOfDirectoriesDeep(const std::string& filePath) const;
+		std::string GetRelativePath(const std::filesystem::path& path) const;
+		/* Returns fileContents with the exports decision asks for and the API include added, safe to call from any thread.
+		Names the decision exports that none of the Symbols define are added to undefinedExports */
+		std::basic_string<unsigned char /* BYTE */> RewriteHeader(const std::string& entry, const HeaderDecision& decision, const std::basic_string<unsigned char /* BYTE */>& fileContents,
+			std::vector<std::string>& undefinedExports) const;
+		/* The #include of the API file, relative to the header at entry */
+		std::basic_string<unsigned char /* BYTE */> GetAPIInclude(const std::string& entry) const;
+		void ClearConsole() const;
+
+		void WriteHeaderFile(const std::string& path, const std::basic_string<unsigned char /* BYTE */>& fileContents, const int fileNumber);
+		void WriteCMakeFile(const std::string& directory, const std::string& fileContents);
+		/* Leaves the file alone, timestamp included, when it already holds exactly these bytes, so CMake does not reconfigure for nothing.
+		Every output of the conversion goes through here and gets counted */
+		bool WriteOutputFile(const std::string& filePath, const std::basic_string_view<unsigned char /* BYTE */> contents);
 
 		std::basic_string<unsigned char /* BYTE */> RootPath;
 		std::basic_string<unsigned char /* BYTE */> ProjectName;
@@ -51,7 +143,10 @@ namespace DLL
 		std::basic_string<unsigned char /* BYTE */> APIFileNamePath;
 		std::basic_string<unsigned char /* BYTE */> APIMacro;
 		std::string OutputPath{};
-		std::vector<std::filesystem::directory_entry> PathEntries;
+		/* Built once in GetAllFilesAndDirectories(), every later step queries it instead of the file system */
+		Utils::IO::FileClassifier Classifier{};
+		Utils::IO::FileIndex Index{};
+		std::vector<size_t> PathEntries; /* the nodes in the root that could be converted, files first */
 		std::vector<std::string> FilteredFilePaths;
 
 		constexpr inline static const unsigned long /* DWORD */ ExportMacroLength{7};
@@ -60,5 +155,29 @@ namespace DLL
 		std::vector<std::string> LibIncludeDirectories{};
 		std::vector<std::string> LibSourceDirectories{};
 		std::vector<std::string> DllDirectories{};
+
+		/* Every generated CMake file gets rendered into this buffer, so it only grows a few times per conversion */
+		std::string CMakeFileContents{};
+		/* Made by GenerateCMakeFiles(), so the headers the .cpp libraries share are read once */
+		std::optional<PrecompiledHeaderPlanner> HeaderPlanner{};
+
+		std::optional<Manifest> BatchManifest{};
+		/* What the built libraries define, empty unless the manifest lists their symbols */
+		Utils::Cpp::SymbolIndex Symbols{};
+		uint64_t SymbolsHash{};
+		size_t NrOfThreads{};
+
+		/* What the previous conversion did, so a re-run only redoes what changed since */
+		ConversionState State{};
+		std::string StatePath{};
+
+		size_t NrOfWrittenFiles{};
+		size_t NrOfUnchangedFiles{};
+
+		ConversionStatistics Statistics{};
+		Utils::Trace::Clock::time_point ConvertStart{};
+		Utils::Trace::Clock::time_point GenerateEnd{};
+		/* Recording does not change the conversion, so the const functions the header workers run can record as well */
+		mutable Utils::Trace::Recorder Trace{};
 	};
 }
\ No newline at end of file
@@ -0,0 +1,431 @@
+#include "Manifest.h"
+
+#include "../Utils/Utils.h"
+#include "../Utils/FileIO.h"
+#include "../Utils/Json.h"
+
+#include <algorithm> /* std::sort, std::adjacent_find */
+#include <cmath> /* std::floor */
+#include <filesystem> /* std::filesystem */
+#include <string_view> /* std::string_view */
+#include <system_error> /* std::error_code */
+
+namespace DLL
+{
+	namespace
+	{
+		/* Manifests are written by hand, so accept both separators and a leading or trailing separator */
+		std::string NormalizeRelativePath(const std::string& path)
+		{
+			std::string normalized(std::filesystem::path(path).lexically_normal().generic_string());
+
+			while (!normalized.empty() && normalized.front() == '/')
+			{
+				normalized.erase(normalized.begin());
+			}
+
+			while (!normalized.empty() && normalized.back() == '/')
+			{
+				normalized.pop_back();
+			}
+
+			return normalized == "." ? std::string{} : normalized;
+		}
+
+		bool ReadString(const Utils::Json::Value& object, const char* pKey, std::string& value, std::string& error)
+		{
+			if (const Utils::Json::Value* pValue = object.Find(pKey))
+			{
+				if (!pValue->IsString())
+				{
+					error = std::string("\"") + pKey + "\" must be a string";
+					return false;
+				}
+
+				value = pValue->GetString();
+			}
+
+			return true;
+		}
+
+		bool ReadBoolean(const Utils::Json::Value& object, const char* pKey, bool& bValue, std::string& error)
+		{
+			if (const Utils::Json::Value* pValue = object.Find(pKey))
+			{
+				if (!pValue->IsBoolean())
+				{
+					error = std::string("\"") + pKey + "\" must be true or false";
+					return false;
+				}
+
+				bValue = pValue->GetBoolean();
+			}
+
+			return true;
+		}
+
+		/* "ccache", "sccache" or "none", left out means whichever of the first two is installed */
+		bool ReadCompilerCache(const Utils::Json::Value& object, Manifest& manifest, std::string& error)
+		{
+			if (const Utils::Json::Value* pValue = object.Find("compilerCache"))
+			{
+				const std::string& name(pValue->GetString());
+
+				if (name != "ccache" && name != "sccache" && name != "none")
+				{
+					error = "\"compilerCache\" must be \"ccache\", \"sccache\" or \"none\"";
+					return false;
+				}
+
+				manifest.CompilerCache = name == "none" ? std::string{} : name;
+			}
+
+			return true;
+		}
+
+		bool ReadSeconds(const Utils::Json::Value& object, const char* pKey, double& seconds, std::string& error)
+		{
+			if (const Utils::Json::Value* pValue = object.Find(pKey))
+			{
+				if (!pValue->IsNumber() || pValue->GetNumber() < 0.0)
+				{
+					error = std::string("\"") + pKey + "\" must be a number of seconds, 0 or more";
+					return false;
+				}
+
+				seconds = pValue->GetNumber();
+			}
+
+			return true;
+		}
+
+		bool ReadCount(const Utils::Json::Value& object, const char* pKey, size_t& count, std::string& error)
+		{
+			if (const Utils::Json::Value* pValue = object.Find(pKey))
+			{
+				const double number(pValue->GetNumber(-1.0));
+
+				if (!pValue->IsNumber() || number < 0.0 || number > 1e9 || std::floor(number) != number)
+				{
+					error = std::string("\"") + pKey + "\" must be a whole number, 0 or more";
+					return false;
+				}
+
+				count = static_cast<size_t>(number);
+			}
+
+			return true;
+		}
+
+		bool ReadHeaders(const Utils::Json::Value& headers, Manifest& manifest, std::string& error)
+		{
+			if (!headers.IsArray())
+			{
+				error = "\"headers\" must be an array";
+				return false;
+			}
+
+			for (const Utils::Json::Value& header : headers.GetArray())
+			{
+				HeaderDecision decision{};
+
+				/* Just a path means the header only gets the API include, or gets analyzed */
+				if (header.IsString())
+				{
+					decision.Path = NormalizeRelativePath(header.GetString());
+					decision.bAnalyze = manifest.bAnalyzeExports;
+					manifest.Headers.push_back(decision);
+					continue;
+				}
+
+				if (!header.IsObject() || !ReadString(header, "path", decision.Path, error) || !ReadBoolean(header, "exportClass", decision.bExportClass, error))
+				{
+					if (error.empty())
+					{
+						error = "every entry in \"headers\" must be a path or an object";
+					}
+
+					return false;
+				}
+
+				if (decision.Path.empty())
+				{
+					error = "every entry in \"headers\" needs a \"path\"";
+					return false;
+				}
+
+				decision.Path = NormalizeRelativePath(decision.Path);
+
+				/* Decisions of its own win over the default */
+				decision.bAnalyze = manifest.bAnalyzeExports && header.Find("exportClass") == nullptr && header.Find("functions") == nullptr;
+
+				if (!ReadBoolean(header, "analyze", decision.bAnalyze, error))
+				{
+					return false;
+				}
+
+				if (const Utils::Json::Value* pFunctions = header.Find("functions"))
+				{
+					if (!pFunctions->IsArray())
+					{
+						error = "\"functions\" of " + decision.Path + " must be an array of function names";
+						return false;
+					}
+
+					for (const Utils::Json::Value& function : pFunctions->GetArray())
+					{
+						if (!function.IsString())
+						{
+							error = "\"functions\" of " + decision.Path + " must be an array of function names";
+							return false;
+						}
+
+						decision.Functions.push_back(function.GetString());
+					}
+				}
+
+				manifest.Headers.push_back(decision);
+			}
+
+			/* Headers are rewritten in parallel, two entries for the same header would race on the file */
+			std::vector<std::string_view> paths{};
+			for (const HeaderDecision& header : manifest.Headers)
+			{
+				paths.push_back(header.Path);
+			}
+
+			std::sort(paths.begin(), paths.end());
+
+			if (const auto cIt(std::adjacent_find(paths.cbegin(), paths.cend())); cIt != paths.cend())
+			{
+				error = std::string(*cIt) + " is listed more than once in \"headers\"";
+				return false;
+			}
+
+			return true;
+		}
+
+		bool ReadLibraries(const Utils::Json::Value& libraries, Manifest& manifest, std::string& error)
+		{
+			if (!libraries.IsObject())
+			{
+				error = "\"libraries\" must be an object";
+				return false;
+			}
+
+			for (const auto& [path, library] : libraries.GetObject())
+			{
+				LibraryDecision decision{};
+
+				const Utils::Json::Value* pType(library.Find("type"));
+
+				if (!library.IsObject() || pType == nullptr || !pType->IsNumber() || pType->GetNumber() < 0 || pType->GetNumber() > 3)
+				{
+					error = "library " + path + " needs a \"type\" between 0 and 3";
+					return false;
+				}
+
+				decision.Type = static_cast<int8_t>(pType->GetNumber());
+
+				if (!ReadString(library, "sourcePath", decision.SourcePath, error) || !ReadString(library, "includePath", decision.IncludePath, error))
+				{
+					return false;
+				}
+
+				/* .lib (and .dll) folders need to know where the .lib files and headers are */
+				if (decision.Type >= 2 && (decision.SourcePath.empty() || decision.IncludePath.empty()))
+				{
+					error = "library " + path + " needs a \"sourcePath\" and an \"includePath\"";
+					return false;
+				}
+
+				manifest.Libraries[NormalizeRelativePath(path)] = decision;
+			}
+
+			return true;
+		}
+
+		bool ReadHeaderLocations(const Utils::Json::Value& headerLocations, Manifest& manifest, std::string& error)
+		{
+			if (!headerLocations.IsObject())
+			{
+				error = "\"headerLocations\" must be an object";
+				return false;
+			}
+
+			for (const auto& [path, location] : headerLocations.GetObject())
+			{
+				if (!location.IsString())
+				{
+					error = "header location of " + path + " must be a string";
+					return false;
+				}
+
+				manifest.HeaderLocations[NormalizeRelativePath(path)] = location.GetString();
+			}
+
+			return true;
+		}
+
+		bool ReadSymbolFiles(const Utils::Json::Value& symbolFiles, Manifest& manifest, std::string& error)
+		{
+			if (!symbolFiles.IsArray())
+			{
+				error = "\"symbols\" must be an array of paths";
+				return false;
+			}
+
+			for (const Utils::Json::Value& symbolFile : symbolFiles.GetArray())
+			{
+				if (!symbolFile.IsString() || symbolFile.GetString().empty())
+				{
+					error = "\"symbols\" must be an array of paths";
+					return false;
+				}
+
+				manifest.SymbolFiles.push_back(symbolFile.GetString());
+			}
+
+			return true;
+		}
+
+		bool ReadExclusions(const Utils::Json::Value& exclusions, Manifest& manifest, std::string& error)
+		{
+			if (!exclusions.IsArray())
+			{
+				error = "\"exclude\" must be an array of names";
+				return false;
+			}
+
+			for (const Utils::Json::Value& exclusion : exclusions.GetArray())
+			{
+				if (!exclusion.IsString() || exclusion.GetString().empty())
+				{
+					error = "\"exclude\" must be an array of names";
+					return false;
+				}
+
+				manifest.Exclusions.push_back(exclusion.GetString());
+			}
+
+			return true;
+		}
+	}
+
+	bool Manifest::Load(const std::string& manifestPath, Manifest& manifest, std::string& error)
+	{
+		std::basic_string<BYTE> fileContents{};
+
+		if (!Utils::IO::ReadFile(manifestPath, fileContents))
+		{
+			error = "could not read " + manifestPath;
+			return false;
+		}
+
+		Utils::Json::Value document{};
+
+		if (!Utils::Json::Parse(Utils::IO::ConvertToRegularString(fileContents), document, error))
+		{
+			error = manifestPath + ": " + error;
+			return false;
+		}
+
+		if (!document.IsObject())
+		{
+			error = manifestPath + ": the manifest must be a JSON object";
+			return false;
+		}
+
+		manifest = Manifest{};
+
+		const bool bIsValid(
+			ReadString(document, "root", manifest.RootPath, error) &&
+			ReadString(document, "output", manifest.OutputPath, error) &&
+			ReadString(document, "vcxproj", manifest.VcxprojPath, error) &&
+			ReadBoolean(document, "overwriteApiFile", manifest.bOverwriteAPIFile, error) &&
+			ReadBoolean(document, "executeCMake", manifest.bExecuteCMake, error) &&
+			ReadSeconds(document, "cmakeTimeout", manifest.CMakeTimeout, error) &&
+			ReadString(document, "generator", manifest.Generator, error) &&
+			ReadCompilerCache(document, manifest, error) &&
+			ReadBoolean(document, "analyzeExports", manifest.bAnalyzeExports, error) &&
+			ReadBoolean(document, "precompiledHeaders", manifest.bPrecompiledHeaders, error) &&
+			ReadBoolean(document, "unityBuild", manifest.bUnityBuild, error) &&
+			ReadCount(document, "unityBatches", manifest.NrOfUnityBatches, error) &&
+			ReadBoolean(document, "detectLibraries", manifest.bDetectLibraries, error) &&
+			(document.Find("headers") == nullptr || ReadHeaders(*document.Find("headers"), manifest, error)) &&
+			(document.Find("libraries") == nullptr || ReadLibraries(*document.Find("libraries"), manifest, error)) &&
+			(document.Find("headerLocations") == nullptr || ReadHeaderLocations(*document.Find("headerLocations"), manifest, error)) &&
+			(document.Find("exclude") == nullptr || ReadExclusions(*document.Find("exclude"), manifest, error)) &&
+			(document.Find("symbols") == nullptr || ReadSymbolFiles(*document.Find("symbols"), manifest, error)));
+
+		if (!bIsValid)
+		{
+			error = manifestPath + ": " + error;
+			return false;
+		}
+
+		/* Relative paths in the manifest are relative to the manifest itself, not to wherever the tool got started from */
+		const std::filesystem::path manifestDirectory(std::filesystem::absolute(manifestPath).parent_path());
+
+		if (manifest.RootPath.empty())
+		{
+			manifest.RootPath = manifestDirectory.string();
+		}
+		else if (std::filesystem::path(manifest.RootPath).is_relative())
+		{
+			manifest.RootPath = (manifestDirectory / manifest.RootPath).lexically_normal().string();
+		}
+
+		if (!manifest.OutputPath.empty() && std::filesystem::path(manifest.OutputPath).is_relative())
+		{
+			manifest.OutputPath = (manifestDirectory / manifest.OutputPath).lexically_normal().string();
+		}
+
+		/* A trailing separator would make the project name empty */
+		while (manifest.RootPath.size() > 1 && (manifest.RootPath.back() == '/' || manifest.RootPath.back() == '\\'))
+		{
+			manifest.RootPath.pop_back();
+		}
+
+		manifest.VcxprojPath = NormalizeRelativePath(manifest.VcxprojPath);
+
+		/* A mistyped header would otherwise only show up once it gets read */
+		for (const HeaderDecision& header : manifest.Headers)
+		{
+			std::error_code errorCode{};
+
+			if (!std::filesystem::is_regular_file(std::filesystem::path(manifest.RootPath) / header.Path, errorCode))
+			{
+				error = manifestPath + ": header " + header.Path + " does not exist in " + manifest.RootPath;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const HeaderDecision* Manifest::FindHeader(const std::string& relativePath) const
+	{
+		for (const HeaderDecision& header : Headers)
+		{
+			if (header.Path == relativePath)
+			{
+				return &header;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const LibraryDecision* Manifest::FindLibrary(const std::string& relativePath) const
+	{
+		const auto cIt(Libraries.find(relativePath));
+		return cIt != Libraries.cend() ? &cIt->second : nullptr;
+	}
+
+	std::string Manifest::GetHeaderLocation(const std::string& relativePath) const
+	{
+		const auto cIt(HeaderLocations.find(relativePath));
+		return cIt != HeaderLocations.cend() ? cIt->second : std::string{};
+	}
+}
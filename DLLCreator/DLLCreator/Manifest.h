@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint> /* int8_t */
+#include <string> /* std::string */
+#include <vector> /* std::vector */
+#include <unordered_map> /* std::unordered_map */
+
+namespace DLL
+{
+	/* What to do with a single header that should be readied for the .dll conversion */
+	struct HeaderDecision final
+	{
+		std::string Path{}; /* relative to the root, '/' separated */
+		bool bExportClass{};
+		std::vector<std::string> Functions{}; /* names of the functions to export when the class is not exported */
+		bool bAnalyze{}; /* ignore the two above and let Utils::Cpp::AnalyzeExports() decide */
+	};
+
+	/* What a folder inside a library folder contains, see DLLCreator::GenerateLibraryDirectoryCMakeFiles() */
+	struct LibraryDecision final
+	{
+		/* 0. Only .h files
+		1. .h and .cpp files
+		2. .h and .lib files
+		3. .h, .lib and .dll files */
+		int8_t Type{};
+		std::string SourcePath{}; /* relative path to the .lib (and .dll) files */
+		std::string IncludePath{}; /* relative path to the .h files */
+	};
+
+	/* Every decision DLLCreator::Convert() would otherwise ask the user for, so a conversion can run unattended */
+	class Manifest final
+	{
+	public:
+		/* Returns false and fills in error if the manifest could not be read or is malformed.
+		Relative root and output paths are resolved against the directory of the manifest */
+		static bool Load(const std::string& manifestPath, Manifest& manifest, std::string& error);
+
+		/* All lookups take paths relative to the root, '/' separated */
+		const HeaderDecision* FindHeader(const std::string& relativePath) const;
+		const LibraryDecision* FindLibrary(const std::string& relativePath) const;
+		std::string GetHeaderLocation(const std::string& relativePath) const;
+
+		std::string RootPath{};
+		std::string OutputPath{};
+		std::string VcxprojPath{}; /* relative to the root, empty means search for it */
+		bool bOverwriteAPIFile{ true };
+		bool bExecuteCMake{ true };
+		double CMakeTimeout{}; /* seconds the CMake configure and build may each take, 0 means no limit */
+		std::string Generator{}; /* the CMake generator, empty means Ninja when it is installed and the default of CMake otherwise */
+		std::string CompilerCache{ "ccache sccache" }; /* the compiler caches the generated CMake files look for, in order of preference, empty for none */
+		bool bAnalyzeExports{}; /* whether headers without their own decisions get analyzed */
+		bool bPrecompiledHeaders{ true }; /* whether the .cpp libraries precompile the headers their sources share */
+		bool bUnityBuild{}; /* whether the .cpp libraries compile their sources together in batches */
+		size_t NrOfUnityBatches{}; /* the most batches per library, 0 means one per hardware thread */
+		bool bDetectLibraries{}; /* whether library folders missing from Libraries get type 0 or 1 from the files they contain */
+
+		std::vector<HeaderDecision> Headers{};
+		std::unordered_map<std::string, LibraryDecision> Libraries{};
+		std::unordered_map<std::string, std::string> HeaderLocations{}; /* for folders containing .cpp files */
+		std::vector<std::string> Exclusions{}; /* extra file and folder names ("ThirdParty") or extensions ("*.tlog") to leave alone */
+		std::vector<std::string> SymbolFiles{}; /* relative to the root or absolute, the symbols of the built libraries for the analysis */
+	};
+}
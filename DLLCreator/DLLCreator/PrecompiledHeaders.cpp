@@ -0,0 +1,540 @@
+#include "PrecompiledHeaders.h"
+
+#include "../Utils/IncludeParser.h"
+
+#include <algorithm> /* std::sort, std::lower_bound, std::set_union, std::count, std::find_if, std::is_sorted */
+#include <array> /* std::array */
+#include <cctype> /* std::tolower */
+#include <filesystem> /* std::filesystem::path */
+#include <iterator> /* std::back_inserter */
+#include <utility> /* std::move, std::make_pair */
+
+namespace DLL
+{
+	namespace
+	{
+		struct HeaderCost final
+		{
+			std::string_view Name;
+			uint64_t NrOfLines;
+
+			constexpr bool operator<(const HeaderCost& other) const { return Name < other.Name; }
+		};
+
+		/* Non-empty lines of g++ 12 -std=c++20 -E -P for a file including only that header, rounded to hundreds.
+		The MSVC standard library is in the same range. windows.h is a rough guess, it depends on the SDK and on what is defined before it */
+		constexpr std::array<HeaderCost, 113> StandardHeaderCosts{ {
+			{ "algorithm", 20500 },
+			{ "any", 3200 },
+			{ "array", 9600 },
+			{ "assert.h", 100 },
+			{ "atomic", 23900 },
+			{ "barrier", 30200 },
+			{ "bit", 3100 },
+			{ "bitset", 19900 },
+			{ "cassert", 100 },
+			{ "cctype", 200 },
+			{ "cerrno", 100 },
+			{ "cfloat", 100 },
+			{ "charconv", 3800 },
+			{ "chrono", 31300 },
+			{ "cinttypes", 200 },
+			{ "climits", 100 },
+			{ "clocale", 100 },
+			{ "cmath", 15700 },
+			{ "codecvt", 20800 },
+			{ "compare", 3500 },
+			{ "complex", 34400 },
+			{ "concepts", 2600 },
+			{ "condition_variable", 38100 },
+			{ "coroutine", 3700 },
+			{ "csetjmp", 100 },
+			{ "csignal", 1200 },
+			{ "cstdarg", 100 },
+			{ "cstddef", 100 },
+			{ "cstdint", 200 },
+			{ "cstdio", 400 },
+			{ "cstdlib", 800 },
+			{ "cstring", 300 },
+			{ "ctime", 300 },
+			{ "ctype.h", 100 },
+			{ "cuchar", 500 },
+			{ "cwchar", 400 },
+			{ "cwctype", 200 },
+			{ "deque", 14100 },
+			{ "errno.h", 100 },
+			{ "exception", 2900 },
+			{ "execution", 110500 },
+			{ "filesystem", 40500 },
+			{ "forward_list", 12100 },
+			{ "fstream", 28200 },
+			{ "functional", 28100 },
+			{ "future", 40300 },
+			{ "initializer_list", 100 },
+			{ "inttypes.h", 100 },
+			{ "iomanip", 30900 },
+			{ "ios", 24500 },
+			{ "iosfwd", 600 },
+			{ "iostream", 26400 },
+			{ "istream", 26400 },
+			{ "iterator", 22300 },
+			{ "latch", 22900 },
+			{ "limits", 1000 },
+			{ "limits.h", 100 },
+			{ "list", 11400 },
+			{ "locale", 27500 },
+			{ "locale.h", 100 },
+			{ "map", 15700 },
+			{ "math.h", 15800 },
+			{ "memory", 35000 },
+			{ "memory_resource", 29400 },
+			{ "mutex", 25100 },
+			{ "new", 200 },
+			{ "numbers", 2400 },
+			{ "numeric", 7100 },
+			{ "optional", 6800 },
+			{ "ostream", 25100 },
+			{ "queue", 17900 },
+			{ "random", 35500 },
+			{ "ranges", 29700 },
+			{ "ratio", 2900 },
+			{ "regex", 53900 },
+			{ "scoped_allocator", 8400 },
+			{ "semaphore", 25900 },
+			{ "set", 13900 },
+			{ "setjmp.h", 100 },
+			{ "shared_mutex", 23400 },
+			{ "signal.h", 1200 },
+			{ "source_location", 100 },
+			{ "span", 11400 },
+			{ "sstream", 27200 },
+			{ "stack", 14400 },
+			{ "stdarg.h", 100 },
+			{ "stddef.h", 100 },
+			{ "stdexcept", 19400 },
+			{ "stdint.h", 100 },
+			{ "stdio.h", 300 },
+			{ "stdlib.h", 800 },
+			{ "stop_token", 34300 },
+			{ "streambuf", 21900 },
+			{ "string", 18900 },
+			{ "string.h", 200 },
+			{ "string_view", 12900 },
+			{ "syncstream", 27500 },
+			{ "system_error", 19700 },
+			{ "thread", 34400 },
+			{ "time.h", 200 },
+			{ "tuple", 5500 },
+			{ "type_traits", 2400 },
+			{ "typeindex", 3600 },
+			{ "typeinfo", 100 },
+			{ "unordered_map", 17600 },
+			{ "unordered_set", 17500 },
+			{ "utility", 4700 },
+			{ "valarray", 28900 },
+			{ "variant", 7700 },
+			{ "vector", 14900 },
+			{ "version", 100 },
+			{ "wchar.h", 300 },
+			{ "windows.h", 150000 }
+		} };
+
+		static_assert(std::is_sorted(StandardHeaderCosts.begin(), StandardHeaderCosts.end()), "PrecompiledHeaders > StandardHeaderCosts must be sorted on name");
+
+		/* Loading a precompiled header is counted as a tenth of parsing what is in it */
+		constexpr uint64_t PrecompiledHeaderLoadDivisor{ 10 };
+
+		std::string ToLower(const std::string_view text)
+		{
+			std::string lower(text);
+
+			for (char& c : lower)
+			{
+				c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+			}
+
+			return lower;
+		}
+
+		/* Splits a path of an #include into its parts, either separator */
+		std::vector<std::string_view> SplitPath(std::string_view path)
+		{
+			std::vector<std::string_view> parts{};
+
+			while (!path.empty())
+			{
+				const size_t end(std::min(path.find_first_of("/\\"), path.size()));
+
+				if (end > 0)
+				{
+					parts.push_back(path.substr(0, end));
+				}
+
+				path.remove_prefix(std::min(end + 1, path.size()));
+			}
+
+			return parts;
+		}
+
+		/* pch.h, stdafx.h, precompiled.h and the like, the names Visual Studio and most projects give their precompiled header */
+		bool IsPrecompiledHeaderName(const std::string_view name)
+		{
+			const std::string lower(ToLower(name));
+			return lower.find("pch") != std::string::npos || lower.find("stdafx") != std::string::npos || lower.find("precomp") != std::string::npos;
+		}
+
+		/* Adds value to the sorted vector values, unless it is already in there. Returns false if it was */
+		template<typename T>
+		bool InsertSorted(std::vector<T>& values, const T& value)
+		{
+			const auto it(std::lower_bound(values.begin(), values.end(), value));
+
+			if (it != values.end() && *it == value)
+			{
+				return false;
+			}
+
+			values.insert(it, value);
+			return true;
+		}
+	}
+
+	PrecompiledHeaderPlanner::PrecompiledHeaderPlanner(const Utils::IO::FileIndex& index, ReadFunction readFile)
+		: Index(index)
+		, ReadFile(std::move(readFile))
+	{
+		for (size_t node{}; node < Index.GetNumberOfNodes(); ++node)
+		{
+			if (Index.IsRegularFile(node) && Index.HasAnyKind(node, Utils::IO::FileKind::Header))
+			{
+				HeadersByName[ToLower(Index.GetName(node))].push_back(node);
+			}
+		}
+	}
+
+	PrecompiledHeaderPlan PrecompiledHeaderPlanner::Plan(const std::vector<size_t>& sources)
+	{
+		using Utils::IO::FileIndex;
+
+		struct Candidate final
+		{
+			std::string Name; /* for target_precompile_headers() */
+			size_t NrOfIncluders;
+			bool bIsStable;
+			size_t FirstSource; /* where it was included first, to keep the include order */
+			size_t FirstPosition;
+			Closure Contents;
+			uint64_t Cost;
+		};
+
+		PrecompiledHeaderPlan plan{};
+
+		if (sources.empty())
+		{
+			return plan;
+		}
+
+		uint64_t nrOfSourceLines{};
+		std::vector<Closure> sourceClosures(sources.size());
+		std::vector<Candidate> candidates{};
+
+		for (size_t source{}; source < sources.size(); ++source)
+		{
+			const ScannedFile& file(Scan(sources[source]));
+			nrOfSourceLines += file.NrOfLines;
+
+			/* A source that includes a header twice only counts once */
+			std::vector<std::string> includedNames{};
+
+			for (size_t position{}; position < file.Includes.size(); ++position)
+			{
+				const Include& include(file.Includes[position]);
+				AddToClosure(include, sourceClosures[source]);
+
+				/* Only <external> headers, the quoted ones are part of the project and change with it */
+				if (!include.bIsAngled || !InsertSorted(includedNames, include.Path))
+				{
+					continue;
+				}
+
+				/* A header in a folder with sources is part of the project as well, whatever the include looks like */
+				bool bIsStable(include.bIsStable);
+				if (include.Node != FileIndex::NoNode)
+				{
+					for (const size_t sibling : Index.GetChildren(Index.GetParent(include.Node)))
+					{
+						bIsStable = bIsStable && !Index.HasAnyKind(sibling, Utils::IO::FileKind::Source);
+					}
+				}
+
+				const std::string name("<" + include.Path + ">");
+				const auto cIt(std::find_if(candidates.begin(), candidates.end(), [&name](const Candidate& candidate)->bool
+					{
+						return candidate.Name == name;
+					}));
+
+				if (cIt == candidates.end())
+				{
+					Closure contents{};
+					AddToClosure(include, contents);
+
+					const uint64_t cost(GetCost(contents));
+					candidates.push_back(Candidate{ name, 1, bIsStable, source, position, std::move(contents), cost });
+				}
+				else
+				{
+					++cIt->NrOfIncluders;
+					cIt->bIsStable = cIt->bIsStable && bIsStable;
+				}
+			}
+		}
+
+		/* A Visual Studio precompiled header has to be the first include of every source.
+		Most sources start with their own header as well, so the name has to say it is a precompiled header */
+		const auto getFirstInclude([this, &sources](const size_t source)->size_t
+			{
+				const ScannedFile& file(ScannedFiles.at(sources[source]));
+
+				if (file.Includes.empty() || !file.Includes.front().bIsStable || file.Includes.front().Node == FileIndex::NoNode)
+				{
+					return FileIndex::NoNode;
+				}
+
+				return IsPrecompiledHeaderName(Index.GetName(file.Includes.front().Node)) ? file.Includes.front().Node : FileIndex::NoNode;
+			});
+
+		bool bHasOwnPrecompiledHeader(sources.size() >= 2 && getFirstInclude(0) != FileIndex::NoNode);
+		for (size_t source{ 1 }; source < sources.size() && bHasOwnPrecompiledHeader; ++source)
+		{
+			bHasOwnPrecompiledHeader = getFirstInclude(source) == getFirstInclude(0);
+		}
+
+		Closure precompiled{};
+
+		if (bHasOwnPrecompiledHeader)
+		{
+			const size_t header(getFirstInclude(0));
+			AddToClosure(ScannedFiles.at(sources[0]).Includes.front(), precompiled);
+
+			const std::filesystem::path library(Index.GetRelativePath(Index.GetParent(sources[0])));
+			plan.Headers.push_back(std::filesystem::path(Index.GetRelativePath(header)).lexically_relative(library).generic_string());
+		}
+		else if (sources.size() >= 2)
+		{
+			/* Worth it when at least half of the sources include it, the others get it for free but it still has to be loaded for them */
+			const size_t minNrOfIncluders(std::max<size_t>((sources.size() + 1) / 2, 2));
+
+			std::vector<const Candidate*> picked{};
+			for (const Candidate& candidate : candidates)
+			{
+				if (candidate.bIsStable && candidate.NrOfIncluders >= minNrOfIncluders && candidate.Cost >= MinHeaderCost)
+				{
+					picked.push_back(&candidate);
+				}
+			}
+
+			std::sort(picked.begin(), picked.end(), [](const Candidate* pA, const Candidate* pB)->bool
+				{
+					const uint64_t scoreA(pA->NrOfIncluders * pA->Cost), scoreB(pB->NrOfIncluders * pB->Cost);
+					return scoreA != scoreB ? scoreA > scoreB : pA->Name < pB->Name;
+				});
+
+			picked.resize(std::min(picked.size(), MaxNrOfHeaders));
+
+			/* In the order the sources include them, some headers depend on others coming first */
+			std::sort(picked.begin(), picked.end(), [](const Candidate* pA, const Candidate* pB)->bool
+				{
+					return std::make_pair(pA->FirstSource, pA->FirstPosition) < std::make_pair(pB->FirstSource, pB->FirstPosition);
+				});
+
+			for (const Candidate* pCandidate : picked)
+			{
+				plan.Headers.push_back(pCandidate->Name);
+
+				for (const size_t file : pCandidate->Contents.Files)
+				{
+					InsertSorted(precompiled.Files, file);
+				}
+
+				for (const std::string& header : pCandidate->Contents.ExternalHeaders)
+				{
+					InsertSorted(precompiled.ExternalHeaders, header);
+				}
+			}
+		}
+
+		/* Without them every source parses everything it includes, with them the precompiled header gets parsed once,
+		and every source only loads it and parses whatever else it includes */
+		const uint64_t precompiledCost(GetCost(precompiled));
+
+		plan.NrOfLinesBefore = nrOfSourceLines;
+		plan.NrOfLinesAfter = nrOfSourceLines + (plan.Headers.empty() ? 0 : precompiledCost);
+
+		for (const Closure& closure : sourceClosures)
+		{
+			plan.NrOfLinesBefore += GetCost(closure);
+
+			if (plan.Headers.empty())
+			{
+				continue;
+			}
+
+			Closure withPrecompiled{};
+			std::set_union(closure.Files.cbegin(), closure.Files.cend(), precompiled.Files.cbegin(), precompiled.Files.cend(), std::back_inserter(withPrecompiled.Files));
+			std::set_union(closure.ExternalHeaders.cbegin(), closure.ExternalHeaders.cend(), precompiled.ExternalHeaders.cbegin(), precompiled.ExternalHeaders.cend(),
+				std::back_inserter(withPrecompiled.ExternalHeaders));
+
+			plan.NrOfLinesAfter += GetCost(withPrecompiled) - precompiledCost + precompiledCost / PrecompiledHeaderLoadDivisor;
+		}
+
+		if (plan.Headers.empty() || plan.NrOfLinesAfter >= plan.NrOfLinesBefore)
+		{
+			plan.Headers.clear();
+			plan.NrOfLinesAfter = plan.NrOfLinesBefore;
+		}
+
+		return plan;
+	}
+
+	const PrecompiledHeaderPlanner::ScannedFile& PrecompiledHeaderPlanner::Scan(const size_t node)
+	{
+		if (const auto cIt(ScannedFiles.find(node)); cIt != ScannedFiles.cend())
+		{
+			return cIt->second;
+		}
+
+		/* References into the map stay valid while it grows, so the files including this one can keep theirs */
+		ScannedFile& file(ScannedFiles[node]);
+		std::basic_string<BYTE> contents{};
+
+		if (!ReadFile(Index.GetPath(node).string(), contents))
+		{
+			return file;
+		}
+
+		const std::string_view text(reinterpret_cast<const char*>(contents.data()), contents.size());
+		file.NrOfLines = std::count(text.cbegin(), text.cend(), '\n') + (!text.empty() && text.back() != '\n' ? 1 : 0);
+
+		std::vector<Utils::Cpp::IncludeDirective> directives{};
+		Utils::Cpp::ParseIncludes(text, directives);
+
+		for (const Utils::Cpp::IncludeDirective& directive : directives)
+		{
+			file.Includes.push_back(Include{ std::string(directive.Path), directive.bIsAngled, !directive.bIsConditional && !directive.bFollowsDefine,
+				Resolve(node, directive.Path, directive.bIsAngled) });
+		}
+
+		return file;
+	}
+
+	size_t PrecompiledHeaderPlanner::Resolve(const size_t node, const std::string_view path, const bool bIsAngled)
+	{
+		using Utils::IO::FileIndex;
+
+		const std::vector<std::string_view> parts(SplitPath(path));
+
+		if (parts.empty())
+		{
+			return FileIndex::NoNode;
+		}
+
+		/* "path" is looked for next to the file including it first */
+		if (!bIsAngled)
+		{
+			size_t current(Index.GetParent(node));
+
+			for (const std::string_view part : parts)
+			{
+				if (current == FileIndex::NoNode)
+				{
+					break;
+				}
+
+				current = part == "." ? current : part == ".." ? Index.GetParent(current) : Index.FindChild(current, part);
+			}
+
+			if (current != FileIndex::NoNode && Index.IsRegularFile(current))
+			{
+				return current;
+			}
+		}
+
+		/* Then anywhere in the tree, the way an include directory would find it: the parts of the path have to match the parents of the header */
+		const auto cIt(HeadersByName.find(ToLower(parts.back())));
+
+		if (cIt == HeadersByName.cend())
+		{
+			return FileIndex::NoNode;
+		}
+
+		for (const size_t header : cIt->second)
+		{
+			size_t current(header);
+			bool bMatches(true);
+
+			for (size_t part(parts.size()); part-- > 0 && bMatches;)
+			{
+				/* ../ and ./ only say where to start looking */
+				if (parts[part] == "." || parts[part] == "..")
+				{
+					break;
+				}
+
+				bMatches = current != FileIndex::NoNode && ToLower(Index.GetName(current)) == ToLower(parts[part]);
+				current = Index.GetParent(current);
+			}
+
+			if (bMatches)
+			{
+				return header;
+			}
+		}
+
+		return FileIndex::NoNode;
+	}
+
+	void PrecompiledHeaderPlanner::AddToClosure(const Include& include, Closure& closure)
+	{
+		if (include.Node == Utils::IO::FileIndex::NoNode)
+		{
+			InsertSorted(closure.ExternalHeaders, ToLower(include.Path));
+			return;
+		}
+
+		/* Added before walking into it, so a cycle of includes ends */
+		if (!InsertSorted(closure.Files, include.Node))
+		{
+			return;
+		}
+
+		for (const Include& nested : Scan(include.Node).Includes)
+		{
+			AddToClosure(nested, closure);
+		}
+	}
+
+	uint64_t PrecompiledHeaderPlanner::GetCost(const Closure& closure) const
+	{
+		uint64_t cost{};
+
+		for (const size_t file : closure.Files)
+		{
+			cost += ScannedFiles.at(file).NrOfLines;
+		}
+
+		/* Standard headers share most of what they include, together they cost about the largest of them plus a fifth of the others.
+		That is within 20% of what g++ 12 reports for common sets of them */
+		uint64_t largest{}, sum{};
+
+		for (const std::string& header : closure.ExternalHeaders)
+		{
+			const auto cIt(std::lower_bound(StandardHeaderCosts.cbegin(), StandardHeaderCosts.cend(), HeaderCost{ header, 0 }));
+			const uint64_t headerCost(cIt != StandardHeaderCosts.cend() && cIt->Name == header ? cIt->NrOfLines : UnknownHeaderCost);
+
+			largest = std::max(largest, headerCost);
+			sum += headerCost;
+		}
+
+		return cost + largest + (sum - largest) / 5;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../Utils/Utils.h" /* BYTE */
+#include "../Utils/FileIndex.h"
+
+#include <cstdint> /* uint64_t */
+#include <functional> /* std::function */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <unordered_map> /* std::unordered_map */
+#include <vector> /* std::vector */
+
+namespace DLL
+{
+	/* The headers of one library worth precompiling, with what that should save */
+	struct PrecompiledHeaderPlan final
+	{
+		/* For target_precompile_headers(): "<vector>" for external headers, a path relative to the library for a header of its own.
+		In the order the sources include them. Empty if precompiling would not win anything */
+		std::vector<std::string> Headers{};
+		/* Estimated lines the compiler parses for all the sources of the library together, without and with the precompiled headers */
+		uint64_t NrOfLinesBefore{};
+		uint64_t NrOfLinesAfter{};
+	};
+
+	/* Picks the headers to precompile for the .cpp libraries of a project, from the #include directives of their sources.
+	The headers are ranked on how many sources include them times what they cost to parse, everything they include counted once.
+	Only stable headers are picked: external ones (standard library, SDKs and the libraries in the tree) that no source defines
+	a macro in front of, and that are not included conditionally. A library whose sources all start by including the same header
+	named like a precompiled header (pch.h, stdafx.h) already has one, that one is used as it is.
+	The size of a header of the tree is its number of lines, standard headers are looked up in a table measured with GCC 12.
+	Every file is read at most once, however many libraries include it */
+	class PrecompiledHeaderPlanner final
+	{
+	public:
+		/* Reads a file of the tree, returns false if it could not be read */
+		using ReadFunction = std::function<bool(const std::string& filePath, std::basic_string<BYTE>& contents)>;
+
+		PrecompiledHeaderPlanner(const Utils::IO::FileIndex& index, ReadFunction readFile);
+
+		/* sources are the nodes of the index with the .cpp files of one library */
+		PrecompiledHeaderPlan Plan(const std::vector<size_t>& sources);
+
+		/* More precompiled headers only make the precompiled header itself slower to build and load */
+		inline static constexpr size_t MaxNrOfHeaders{ 16 };
+		/* Headers smaller than this (in lines) are not worth precompiling */
+		inline static constexpr uint64_t MinHeaderCost{ 1000 };
+		/* What an external header is assumed to cost when it is neither in the table nor in the tree */
+		inline static constexpr uint64_t UnknownHeaderCost{ 1000 };
+
+	private:
+		struct Include final
+		{
+			std::string Path;
+			bool bIsAngled;
+			bool bIsStable; /* unconditional and without a macro defined before it */
+			size_t Node; /* where it was found in the index, FileIndex::NoNode for an external header */
+		};
+
+		struct ScannedFile final
+		{
+			uint64_t NrOfLines{};
+			std::vector<Include> Includes{};
+		};
+
+		/* Everything an include pulls in, each file once */
+		struct Closure final
+		{
+			std::vector<size_t> Files{}; /* nodes of the index, sorted */
+			std::vector<std::string> ExternalHeaders{}; /* sorted */
+		};
+
+		const ScannedFile& Scan(const size_t node);
+		/* The node of the index path refers to, when included from the file at node, or FileIndex::NoNode */
+		size_t Resolve(const size_t node, const std::string_view path, const bool bIsAngled);
+		void AddToClosure(const Include& include, Closure& closure);
+		uint64_t GetCost(const Closure& closure) const;
+
+		const Utils::IO::FileIndex& Index;
+		ReadFunction ReadFile;
+		std::unordered_map<size_t, ScannedFile> ScannedFiles{};
+		std::unordered_map<std::string, std::vector<size_t>> HeadersByName{}; /* lower case file name to the headers called that */
+	};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array> /* std::array */
+#include <string_view> /* std::string_view */
+
+#include "../Utils/Template.h"
+#include "EmbeddedResources.h" /* generated from the Resources/<name>.txt files at build time */
+
+namespace DLL
+{
+	/* The CMake presets, embedded in the executable and parsed into templates at compile time,
+	so converting never reads or parses a preset file */
+	namespace Presets
+	{
+		/* The placeholders of every preset, the values passed to Render() go in the same order */
+		inline constexpr std::array<std::string_view, 9> RootSlots{ "<VERSION_MAJOR>", "<VERSION_MINOR>", "<PROJECT_NAME>", "<SUBDIRECTORIES>", "<LIBRARIES>", "<INCLUDES>", "<DLLS>", "<API_FILE>", "<COMPILER_CACHE>" };
+		inline constexpr std::array<std::string_view, 2> SubDirectoryHeaderSlots{ "<LIBRARY_NAME>", "<HEADER_LOCATION>" };
+		inline constexpr std::array<std::string_view, 7> SubDirectoryCppSlots{ "<LIBRARY_NAME>", "<HEADER_LOCATION>", "<SOURCES>", "<PROJECT_NAME>", "<PRECOMPILED_HEADERS>",
+			"<UNITY_SOURCES>", "<UNITY_BATCHES>" };
+		inline constexpr std::array<std::string_view, 3> SubDirectoryLibSlots{ "<LIBRARY_NAME>", "<HEADER_LOCATION>", "<SOURCE_LOCATION>" };
+		inline constexpr std::array<std::string_view, 4> SubDirectoryDLLSlots{ "<LIBRARY_NAME>", "<HEADER_LOCATION>", "<SOURCE_LOCATION>", "<DLLS>" };
+
+		inline constexpr auto RootChunks(Utils::ParseTemplate<Utils::CountTemplateChunks(EmbeddedResources::CMakeRootPreset, RootSlots)>(EmbeddedResources::CMakeRootPreset, RootSlots));
+		inline constexpr auto SubDirectoryHeaderChunks(Utils::ParseTemplate<Utils::CountTemplateChunks(EmbeddedResources::CMakeSubDirectoryHeaderPreset, SubDirectoryHeaderSlots)>(EmbeddedResources::CMakeSubDirectoryHeaderPreset, SubDirectoryHeaderSlots));
+		inline constexpr auto SubDirectoryCppChunks(Utils::ParseTemplate<Utils::CountTemplateChunks(EmbeddedResources::CMakeSubDirectoryCppPreset, SubDirectoryCppSlots)>(EmbeddedResources::CMakeSubDirectoryCppPreset, SubDirectoryCppSlots));
+		inline constexpr auto SubDirectoryLibChunks(Utils::ParseTemplate<Utils::CountTemplateChunks(EmbeddedResources::CMakeSubDirectoryLibPreset, SubDirectoryLibSlots)>(EmbeddedResources::CMakeSubDirectoryLibPreset, SubDirectoryLibSlots));
+		inline constexpr auto SubDirectoryDLLChunks(Utils::ParseTemplate<Utils::CountTemplateChunks(EmbeddedResources::CMakeSubDirectoryDLLPreset, SubDirectoryDLLSlots)>(EmbeddedResources::CMakeSubDirectoryDLLPreset, SubDirectoryDLLSlots));
+
+		inline constexpr Utils::Template RootTemplate(RootChunks, RootSlots.size());
+		inline constexpr Utils::Template SubDirectoryHeaderTemplate(SubDirectoryHeaderChunks, SubDirectoryHeaderSlots.size());
+		inline constexpr Utils::Template SubDirectoryCppTemplate(SubDirectoryCppChunks, SubDirectoryCppSlots.size());
+		inline constexpr Utils::Template SubDirectoryLibTemplate(SubDirectoryLibChunks, SubDirectoryLibSlots.size());
+		inline constexpr Utils::Template SubDirectoryDLLTemplate(SubDirectoryDLLChunks, SubDirectoryDLLSlots.size());
+
+		/* The cpp files go in the <SOURCES> slot, a preset without it would silently drop every source file */
+		static_assert(Utils::CountTemplateChunks(EmbeddedResources::CMakeSubDirectoryCppPreset, std::array<std::string_view, 1>{ "<SOURCES>" }) == 2,
+			"Resources/CMakeSubDirectoryCppPreset.txt needs exactly one <SOURCES>");
+	}
+}
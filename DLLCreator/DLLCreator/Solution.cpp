@@ -0,0 +1,299 @@
+#include "Solution.h"
+#include "DLLCreator.h"
+
+#include "../Utils/Utils.h"
+#include "../Utils/FileIO.h"
+#include "../Utils/FileClassifier.h"
+#include "../Utils/LineIndex.h"
+#include "../Utils/ThreadPool.h"
+
+#include <algorithm> /* std::sort, std::min, std::max */
+#include <exception> /* std::exception */
+#include <filesystem> /* std::filesystem */
+#include <memory> /* std::unique_ptr, std::make_unique */
+#include <iostream> /* std::cout */
+#include <string_view> /* std::string_view */
+#include <system_error> /* std::error_code */
+#include <thread> /* std::thread::hardware_concurrency */
+
+namespace DLL
+{
+	namespace
+	{
+		/* Lines of a .sln look like: Project("{TYPE-GUID}") = "Name", "Relative\Path.vcxproj", "{PROJECT-GUID}" */
+		bool FindProjectsInSolutionFile(const std::filesystem::path& solutionPath, std::vector<std::filesystem::path>& vcxprojPaths, std::string& error)
+		{
+			std::basic_string<BYTE> fileContents{};
+
+			if (!Utils::IO::ReadFile(solutionPath.string(), fileContents))
+			{
+				error = "could not read " + solutionPath.string();
+				return false;
+			}
+
+			const Utils::IO::LineIndex lines(fileContents);
+			const std::string_view suffix(".vcxproj");
+
+			for (size_t i{}; i < lines.GetNumberOfLines(); ++i)
+			{
+				const std::basic_string_view<BYTE> lineBytes(lines.GetLine(i));
+				const std::string_view line(reinterpret_cast<const char*>(lineBytes.data()), lineBytes.size());
+
+				if (line.rfind("Project(", 0) != 0)
+				{
+					continue;
+				}
+
+				/* The path is the third quoted string, so it starts after the fifth quote */
+				size_t quote{};
+				for (size_t quoteIndex{}; quoteIndex < 5 && quote != std::string_view::npos; ++quoteIndex)
+				{
+					quote = line.find('"', quote + (quoteIndex == 0 ? 0 : 1));
+				}
+
+				if (quote == std::string_view::npos)
+				{
+					continue;
+				}
+
+				/* Solution folders and other project types are listed as well */
+				const size_t pathEnd(line.find('"', quote + 1));
+				const std::string_view path(line.substr(quote + 1, pathEnd - quote - 1));
+
+				if (pathEnd == std::string_view::npos || path.size() < suffix.size() || path.substr(path.size() - suffix.size()) != suffix)
+				{
+					continue;
+				}
+
+				/* Visual Studio always writes backslashes */
+				std::string relativePath(path);
+				std::replace(relativePath.begin(), relativePath.end(), '\\', '/');
+
+				const std::filesystem::path vcxprojPath((solutionPath.parent_path() / relativePath).lexically_normal());
+
+				if (!std::filesystem::is_regular_file(vcxprojPath))
+				{
+					error = solutionPath.string() + " lists " + vcxprojPath.string() + ", which does not exist";
+					return false;
+				}
+
+				vcxprojPaths.push_back(vcxprojPath);
+			}
+
+			return true;
+		}
+
+		void FindProjectsInDirectory(const std::filesystem::path& directory, std::vector<std::filesystem::path>& vcxprojPaths)
+		{
+			const Utils::IO::FileClassifier classifier{};
+			std::error_code errorCode{};
+
+			for (auto it(std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, errorCode));
+				it != std::filesystem::recursive_directory_iterator(); it.increment(errorCode))
+			{
+				const bool bIsDirectory(it->is_directory(errorCode));
+				const Utils::IO::FileKind kind(classifier.Classify(it->path().filename().string(), bIsDirectory));
+
+				if (bIsDirectory)
+				{
+					/* Build output and tool folders never contain projects to convert */
+					if (Utils::IO::HasAnyKind(kind, Utils::IO::FileKind::BuildFolder | Utils::IO::FileKind::ToolFolder))
+					{
+						it.disable_recursion_pending();
+					}
+				}
+				else if (Utils::IO::HasAnyKind(kind, Utils::IO::FileKind::Project))
+				{
+					vcxprojPaths.push_back(it->path().lexically_normal());
+				}
+			}
+		}
+
+		bool IsInsideDirectory(const std::string& path, const std::string& directory)
+		{
+			return path == directory || (path.size() > directory.size() && path.compare(0, directory.size(), directory) == 0 && path[directory.size()] == '/');
+		}
+	}
+
+	bool Solution::Load(const std::string& solutionPath, Solution& solution, std::string& error)
+	{
+		solution = Solution{};
+
+		const std::filesystem::path path(std::filesystem::absolute(solutionPath).lexically_normal());
+		std::vector<std::filesystem::path> vcxprojPaths{};
+
+		if (std::filesystem::is_directory(path))
+		{
+			FindProjectsInDirectory(path, vcxprojPaths);
+		}
+		else if (path.extension() == ".sln")
+		{
+			if (!FindProjectsInSolutionFile(path, vcxprojPaths, error))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			error = solutionPath + " is neither a .sln nor a directory";
+			return false;
+		}
+
+		if (vcxprojPaths.empty())
+		{
+			error = "no .vcxproj files were found in " + solutionPath;
+			return false;
+		}
+
+		for (const std::filesystem::path& vcxprojPath : vcxprojPaths)
+		{
+			const std::filesystem::path projectDirectory(vcxprojPath.parent_path());
+			const std::filesystem::path manifestPath(projectDirectory / ProjectManifestName);
+
+			Manifest manifest{};
+
+			if (std::filesystem::is_regular_file(manifestPath))
+			{
+				if (!Manifest::Load(manifestPath.string(), manifest, error))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				/* Without a manifest the project only gets its CMake files and the EXPORT define */
+				manifest.RootPath = projectDirectory.string();
+				manifest.bDetectLibraries = true;
+			}
+
+			if (manifest.VcxprojPath.empty())
+			{
+				manifest.VcxprojPath = vcxprojPath.lexically_relative(manifest.RootPath).generic_string();
+			}
+
+			solution.Projects.push_back(manifest);
+		}
+
+		/* Always convert (and report) in the same order, no matter in what order the file system or the .sln lists the projects */
+		std::sort(solution.Projects.begin(), solution.Projects.end(), [](const Manifest& a, const Manifest& b)->bool
+			{
+				return a.RootPath < b.RootPath;
+			});
+
+		/* Every conversion generates CMake files in every folder below its root, so two projects may not share folders */
+		for (size_t i{}; i < solution.Projects.size(); ++i)
+		{
+			const std::string root(std::filesystem::path(solution.Projects[i].RootPath).generic_string());
+
+			for (size_t j{}; j < solution.Projects.size(); ++j)
+			{
+				if (i != j && IsInsideDirectory(std::filesystem::path(solution.Projects[j].RootPath).generic_string(), root))
+				{
+					error = "the projects in " + solution.Projects[i].RootPath + " and " + solution.Projects[j].RootPath +
+						" share folders, give each project its own folder or convert them separately";
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool Solution::Convert(const size_t nrOfThreads, const size_t nrOfCMakeRuns, const size_t nrOfBuildJobs, Utils::Trace::Recorder& trace) const
+	{
+		/* Every job only writes to its own slot, so no locking is needed */
+		std::vector<std::string> errors(Projects.size());
+		/* A project is kept until its CMake run is done */
+		std::vector<std::unique_ptr<DLLCreator>> converters(Projects.size());
+
+		/* No point in starting more threads than there are projects */
+		const size_t nrOfHardwareThreads(std::max<size_t>(std::thread::hardware_concurrency(), 1));
+		const size_t nrOfConversions(std::min(nrOfThreads == 0 ? nrOfHardwareThreads : nrOfThreads, Projects.size()));
+		const size_t nrOfConcurrentCMakeRuns(std::min(nrOfCMakeRuns == 0 ? nrOfConversions : nrOfCMakeRuns, Projects.size()));
+
+		/* Every build running at the same time takes its compile jobs from the same budget */
+		const BuildSettings build(nrOfBuildJobs, nrOfConcurrentCMakeRuns);
+
+		/* Runs on a thread of the CMake pool, the project is let go of as soon as its CMake run is done */
+		const auto runCMake([&converters, &errors, &trace, &build](const size_t i)
+			{
+				try
+				{
+					if (std::string error{}; !converters[i]->RunCMake(build, error))
+					{
+						errors[i] = error;
+					}
+
+					trace.Append(converters[i]->GetTrace());
+				}
+				catch (const std::exception& exception)
+				{
+					errors[i] = exception.what();
+				}
+
+				converters[i].reset();
+			});
+
+		{ /* Scope-lock the pools, their destructors join the workers */
+			Utils::ThreadPool threadPool(nrOfConversions);
+
+			/* CMake runs mostly wait on the processes they started, so they get threads of their own and never hold up converting */
+			Utils::ThreadPool cmakePool(nrOfConcurrentCMakeRuns);
+
+			std::cout << "Converting " << Projects.size() << " projects on " << threadPool.GetNumberOfThreads() << " threads, running CMake for " << cmakePool.GetNumberOfThreads()
+				<< " at a time with " << build.GetNumberOfJobs() << " compile jobs between them\n";
+
+			/* The projects already keep the cores busy, so each one only walks its tree and rewrites its headers with what is left */
+			const size_t nrOfThreadsPerProject(std::max<size_t>(nrOfHardwareThreads / threadPool.GetNumberOfThreads(), 1));
+
+			for (size_t i{}; i < Projects.size(); ++i)
+			{
+				threadPool.Submit([this, i, nrOfThreadsPerProject, &converters, &errors, &trace, &cmakePool, &runCMake]()
+					{
+						try
+						{
+							converters[i] = std::make_unique<DLLCreator>(Projects[i], nrOfThreadsPerProject);
+
+							if (trace.IsEnabled())
+							{
+								converters[i]->EnableTrace();
+							}
+
+							converters[i]->GenerateFiles();
+
+							cmakePool.Submit([i, &runCMake]()
+								{
+									runCMake(i);
+								});
+						}
+						catch (const std::exception& exception)
+						{
+							/* An exception escaping a worker would take down every other conversion */
+							errors[i] = exception.what();
+						}
+					});
+			}
+
+			/* Every CMake run gets submitted by a conversion, so only once those are done can the CMake runs be waited for */
+			threadPool.Wait();
+			cmakePool.Wait();
+		}
+
+		bool bSucceeded(true);
+
+		for (size_t i{}; i < Projects.size(); ++i)
+		{
+			if (errors[i].empty())
+			{
+				std::cout << "Converted: " << Projects[i].RootPath << "\n";
+			}
+			else
+			{
+				std::cout << "Failed: " << Projects[i].RootPath << " > " << errors[i] << "\n";
+				bSucceeded = false;
+			}
+		}
+
+		return bSucceeded;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Manifest.h"
+
+#include "../Utils/Trace.h"
+
+#include <string> /* std::string */
+#include <vector> /* std::vector */
+
+namespace DLL
+{
+	/* Every project of a Visual Studio solution, so a whole solution can be converted in one go */
+	class Solution final
+	{
+	public:
+		/* solutionPath is either a .sln or a directory that gets searched for .vcxproj files.
+		Every project gets converted with the manifest called ProjectManifestName next to its .vcxproj,
+		or with the defaults of a manifest if there is none.
+		Returns false and fills in error if no project was found, a manifest is malformed or two projects overlap */
+		static bool Load(const std::string& solutionPath, Solution& solution, std::string& error);
+
+		/* Converts the projects concurrently, nrOfThreads at a time (0 means one per hardware thread).
+		A converted project has its CMake run while the next ones are still being converted, with at most nrOfCMakeRuns
+		of those at a time, for all projects together (0 means as many as nrOfThreads).
+		Those builds share nrOfBuildJobs compile jobs (0 means as many as the cores and the memory allow), see BuildSettings.
+		Every project only touches its own folder, so the output is the same as converting them one by one.
+		Returns false if any project failed, the failures get printed in the order of the projects.
+		If trace is enabled, every project gets recorded into it as a process of its own */
+		bool Convert(const size_t nrOfThreads, const size_t nrOfCMakeRuns, const size_t nrOfBuildJobs, Utils::Trace::Recorder& trace) const;
+
+		inline static const std::string ProjectManifestName{ "DLLCreator.json" };
+
+		std::vector<Manifest> Projects{}; /* sorted on root path */
+	};
+}
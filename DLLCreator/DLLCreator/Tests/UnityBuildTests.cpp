@@ -0,0 +1,73 @@
+#include "UnityBuild.h"
+
+#include <cstdio> /* std::printf */
+#include <iterator> /* std::size */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+
+/* Checks which names IsInternalToSource() picks out of a source, the ones that would collide when sources are merged into one unity batch.
+Those have to be found after the bodies ParseDeclarations() skips as well */
+
+namespace
+{
+	struct TestCase final
+	{
+		const char* pText;
+		const char* pExpected; /* the internal names, separated by spaces */
+	};
+
+	const TestCase TestCases[]
+	{
+		{ "void Engine::Run() {}\nstatic int Dup() { return 1; }\nint E1() { return Dup(); }", "Dup" },
+		{ "namespace { void Engine::Run() {} int Helper() { return 1; } struct Local { int Get() { return 1; } }; }", "Helper Local" },
+		{ "Engine::Engine() : Value{ 0 } {}\nstatic int Dup() { return 1; }\nstatic int Other() { return 2; }", "Dup Other" },
+
+		/* Classes only have static members, those do not collide */
+		{ "class A { static int Count(); };\nstatic int Count() { return 0; }", "Count" },
+		{ "int Foo();\nstruct S { int x; };", "" }
+	};
+
+	std::string InternalNames(const std::string_view text)
+	{
+		std::vector<Utils::Cpp::Declaration> declarations{};
+		Utils::Cpp::ParseDeclarations(text, declarations);
+
+		std::string names{};
+		for (const Utils::Cpp::Declaration& declaration : declarations)
+		{
+			if (!DLL::IsInternalToSource(declaration))
+			{
+				continue;
+			}
+
+			if (!names.empty())
+			{
+				names += ' ';
+			}
+
+			names += text.substr(declaration.NameBegin, declaration.NameEnd - declaration.NameBegin);
+		}
+
+		return names;
+	}
+}
+
+int main()
+{
+	size_t failures{};
+
+	for (const TestCase& testCase : TestCases)
+	{
+		const std::string names(InternalNames(testCase.pText));
+
+		if (names != testCase.pExpected)
+		{
+			++failures;
+			std::printf("FAILED:\n%s\n  expected \"%s\", got \"%s\"\n", testCase.pText, testCase.pExpected, names.c_str());
+		}
+	}
+
+	std::printf("%zu of %zu passed\n", std::size(TestCases) - failures, std::size(TestCases));
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include "UnityBuild.h"
+
+#include "../Utils/IncludeParser.h"
+
+#include <algorithm> /* std::sort, std::min, std::min_element, std::minmax_element */
+#include <numeric> /* std::iota */
+#include <string_view> /* std::string_view */
+#include <unordered_map> /* std::unordered_map */
+#include <utility> /* std::move */
+
+namespace DLL
+{
+	bool IsInternalToSource(const Utils::Cpp::Declaration& declaration)
+	{
+		using namespace Utils::Cpp;
+
+		if (declaration.Depth > 0)
+		{
+			return false;
+		}
+
+		return HasAnySpecifier(declaration.Specifiers, Specifier::Internal) ||
+			(declaration.Type == DeclarationType::Function && HasAnySpecifier(declaration.Specifiers, Specifier::Static));
+	}
+
+	UnityBuildPlan PlanUnityBuild(const Utils::IO::FileIndex& index, const std::vector<size_t>& sources, const size_t nrOfBatches,
+		const std::function<bool(const std::string& filePath, std::basic_string<BYTE>& contents)>& readFile)
+	{
+		using namespace Utils;
+		using namespace Cpp;
+
+		UnityBuildPlan plan{};
+
+		if (sources.size() < MinNrOfUnitySources || nrOfBatches == 0)
+		{
+			return plan;
+		}
+
+		/* Names the sources kept so far have internally, to the source they are in */
+		std::unordered_map<std::string, size_t> internalNames{};
+		std::vector<uint64_t> sizes{};
+
+		std::basic_string<BYTE> contents{};
+		std::vector<std::string_view> macros{};
+		std::vector<Declaration> declarations{};
+
+		for (const size_t source : sources)
+		{
+			contents.clear();
+
+			if (!readFile(index.GetPath(source).string(), contents))
+			{
+				plan.Exclusions.push_back(UnityBuildPlan::Exclusion{ source, "could not be read" });
+				continue;
+			}
+
+			const std::string_view text(reinterpret_cast<const char*>(contents.data()), contents.size());
+
+			macros.clear();
+			FindLeakedMacros(text, macros);
+
+			if (!macros.empty())
+			{
+				plan.Exclusions.push_back(UnityBuildPlan::Exclusion{ source, "defines " + std::string(macros.front()) });
+				continue;
+			}
+
+			declarations.clear();
+			ParseDeclarations(text, declarations);
+
+			std::vector<std::string> names{};
+			std::string collision{};
+
+			for (const Declaration& declaration : declarations)
+			{
+				if (!IsInternalToSource(declaration))
+				{
+					continue;
+				}
+
+				std::string name(text.substr(declaration.NameBegin, declaration.NameEnd - declaration.NameBegin));
+
+				if (const auto cIt(internalNames.find(name)); cIt != internalNames.cend())
+				{
+					collision = name + " is in " + std::string(index.GetName(cIt->second)) + " as well";
+					break;
+				}
+
+				names.push_back(std::move(name));
+			}
+
+			if (!collision.empty())
+			{
+				plan.Exclusions.push_back(UnityBuildPlan::Exclusion{ source, std::move(collision) });
+				continue;
+			}
+
+			for (std::string& name : names)
+			{
+				internalNames.emplace(std::move(name), source);
+			}
+
+			plan.Sources.push_back(source);
+			sizes.push_back(contents.size());
+		}
+
+		plan.NrOfBatches = std::min(nrOfBatches, plan.Sources.size() / 2);
+
+		if (plan.Sources.size() < MinNrOfUnitySources || plan.NrOfBatches == 0)
+		{
+			plan.Sources.clear();
+			plan.NrOfBatches = 0;
+			return plan;
+		}
+
+		/* Largest first, each into the smallest batch so far */
+		std::vector<size_t> order(plan.Sources.size());
+		std::iota(order.begin(), order.end(), size_t{});
+		std::sort(order.begin(), order.end(), [&sizes](const size_t a, const size_t b)->bool
+			{
+				return sizes[a] != sizes[b] ? sizes[a] > sizes[b] : a < b;
+			});
+
+		std::vector<uint64_t> batchSizes(plan.NrOfBatches);
+		plan.Batches.resize(plan.Sources.size());
+
+		for (const size_t i : order)
+		{
+			const size_t batch(std::min_element(batchSizes.cbegin(), batchSizes.cend()) - batchSizes.cbegin());
+
+			plan.Batches[i] = batch;
+			batchSizes[batch] += sizes[i];
+		}
+
+		/* Numbered in the order the sources are listed in, so the batches read from the top down */
+		std::vector<size_t> numbers(plan.NrOfBatches);
+		size_t nextNumber{ 1 };
+
+		for (size_t& batch : plan.Batches)
+		{
+			if (numbers[batch] == 0)
+			{
+				numbers[batch] = nextNumber++;
+			}
+
+			batch = numbers[batch];
+		}
+
+		const auto minMax(std::minmax_element(batchSizes.cbegin(), batchSizes.cend()));
+		plan.NrOfBytesInSmallestBatch = *minMax.first;
+		plan.NrOfBytesInLargestBatch = *minMax.second;
+
+		return plan;
+	}
+}
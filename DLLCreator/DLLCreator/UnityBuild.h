@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../Utils/Utils.h" /* BYTE */
+#include "../Utils/FileIndex.h"
+#include "../Utils/HeaderParser.h" /* Utils::Cpp::Declaration */
+
+#include <cstdint> /* uint64_t */
+#include <functional> /* std::function */
+#include <string> /* std::string */
+#include <vector> /* std::vector */
+
+namespace DLL
+{
+	/* How the sources of one library get compiled together */
+	struct UnityBuildPlan final
+	{
+		/* A source that is not merged, with why */
+		struct Exclusion final
+		{
+			size_t Source; /* node of the index */
+			std::string Reason;
+		};
+
+		/* The merged sources (nodes of the index) in the order they were passed, with the batch (from 1 on) each one goes into.
+		Empty if the library is too small to bother */
+		std::vector<size_t> Sources{};
+		std::vector<size_t> Batches{};
+		size_t NrOfBatches{};
+		uint64_t NrOfBytesInSmallestBatch{};
+		uint64_t NrOfBytesInLargestBatch{};
+		/* Compiled on their own, they would break or change the sources merged with them */
+		std::vector<Exclusion> Exclusions{};
+	};
+
+	/* Whether the name of declaration is only known inside its own source: a function or class of an anonymous namespace, or a static function.
+	Two sources with the same one of these collide when they are merged, members of classes do not */
+	bool IsInternalToSource(const Utils::Cpp::Declaration& declaration);
+
+	/* Libraries with fewer sources that can be merged than this are compiled as they are */
+	inline constexpr size_t MinNrOfUnitySources{ 4 };
+
+	/* Splits the sources of one library into at most nrOfBatches batches of about the same size in bytes, the largest sources are placed first,
+	each in the batch that is smallest so far. There are never more batches than half the sources, so a small library gets fewer of them.
+	Sources a lightweight scan finds unsafe to merge are left out: the ones that #define a macro they do not #undef again,
+	and the ones with a function or class in an anonymous namespace (or a static function) that an earlier source has as well.
+	Static variables and macros used in other ways are not looked for, a source that trips over those needs an exclusion in CMake.
+	readFile reads a source, it returns false if the source could not be read */
+	UnityBuildPlan PlanUnityBuild(const Utils::IO::FileIndex& index, const std::vector<size_t>& sources, const size_t nrOfBatches,
+		const std::function<bool(const std::string& filePath, std::basic_string<BYTE>& contents)>& readFile);
+}
@@ -0,0 +1,61 @@
+# Turns every Resources/*.txt file into a constexpr std::string_view, so the presets are compiled into the executable
+# Usage: cmake -DRESOURCE_DIR=<folder with the .txt files> -DOUTPUT=<header to generate> -P EmbedResources.cmake
+
+if(NOT DEFINED RESOURCE_DIR OR NOT DEFINED OUTPUT)
+	message(FATAL_ERROR "EmbedResources.cmake needs RESOURCE_DIR and OUTPUT")
+endif()
+
+# Visual Studio passes Windows paths
+file(TO_CMAKE_PATH "${RESOURCE_DIR}" RESOURCE_DIR)
+file(TO_CMAKE_PATH "${OUTPUT}" OUTPUT)
+
+# Raw string literals are limited in size by some compilers, so long files get split into adjacent literals
+set(PieceSize 8000)
+set(Delimiter "Resource")
+
+file(GLOB ResourceFiles "${RESOURCE_DIR}/*.txt")
+list(SORT ResourceFiles)
+
+set(Contents "#pragma once\n\n/* Generated from the Resources/<name>.txt files by EmbedResources.cmake, do not edit */\n\n#include <string_view> /* std::string_view */\n\nnamespace DLL\n{\n\tnamespace EmbeddedResources\n\t{\n")
+
+foreach(ResourceFile ${ResourceFiles})
+	get_filename_component(Name "${ResourceFile}" NAME_WE)
+
+	file(READ "${ResourceFile}" Text)
+
+	# The output should not depend on how git checked the file out
+	string(REPLACE "\r\n" "\n" Text "${Text}")
+
+	string(FIND "${Text}" ")${Delimiter}\"" DelimiterPos)
+	if(NOT DelimiterPos EQUAL -1)
+		message(FATAL_ERROR "${ResourceFile} contains the raw string delimiter )${Delimiter}\"")
+	endif()
+
+	string(APPEND Contents "\t\tinline constexpr std::string_view ${Name}{ ")
+
+	string(LENGTH "${Text}" Length)
+	if(Length EQUAL 0)
+		string(APPEND Contents "\"\"")
+	endif()
+
+	set(Offset 0)
+	while(Offset LESS Length)
+		string(SUBSTRING "${Text}" ${Offset} ${PieceSize} Piece)
+		string(APPEND Contents "R\"${Delimiter}(${Piece})${Delimiter}\"")
+		math(EXPR Offset "${Offset} + ${PieceSize}")
+	endwhile()
+
+	string(APPEND Contents " };\n")
+endforeach()
+
+string(APPEND Contents "\t}\n}\n")
+
+# Only touch the header when it changes, so nothing recompiles needlessly
+if(EXISTS "${OUTPUT}")
+	file(READ "${OUTPUT}" OldContents)
+	if(OldContents STREQUAL Contents)
+		return()
+	endif()
+endif()
+
+file(WRITE "${OUTPUT}" "${Contents}")
@@ -0,0 +1,324 @@
+#include "ByteSearch.h"
+
+#include <bit> /* std::countr_zero */
+#include <cstdint> /* uintptr_t */
+#include <cstring> /* std::memchr, std::memcmp */
+
+/* SSE2 is part of x64, so only AVX2 has to be checked for at runtime */
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define BYTE_SEARCH_HAS_SSE2 1
+#include <immintrin.h> /* SSE2 and AVX2 intrinsics */
+#ifdef _MSC_VER
+#include <intrin.h> /* __cpuidex, _xgetbv */
+#endif
+#endif
+
+/* MSVC compiles AVX2 intrinsics anywhere, GCC and Clang only in functions that ask for them */
+#if defined(__GNUC__) || defined(__clang__)
+#define BYTE_SEARCH_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define BYTE_SEARCH_AVX2_TARGET
+#endif
+
+/* GCC defines __SANITIZE_ADDRESS__ under -fsanitize=address, Clang only answers __has_feature(address_sanitizer) */
+#if defined(__SANITIZE_ADDRESS__)
+#define BYTE_SEARCH_HAS_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define BYTE_SEARCH_HAS_ASAN 1
+#endif
+#endif
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			/* Every kernel can assume offset < size, and for substrings needleSize >= 2 and offset + needleSize <= size */
+			using FindByteKernel = size_t(*)(const BYTE* const, const size_t, const BYTE, const size_t);
+			using FindSubstringKernel = size_t(*)(const BYTE* const, const size_t, const BYTE* const, const size_t, const size_t);
+
+			size_t FindByteScalar(const BYTE* const pData, const size_t size, const BYTE value, const size_t offset)
+			{
+				const void* const pFound(std::memchr(pData + offset, value, size - offset));
+				return pFound != nullptr ? static_cast<size_t>(static_cast<const BYTE*>(pFound) - pData) : NotFound;
+			}
+
+			size_t FindSubstringScalar(const BYTE* const pData, const size_t size, const BYTE* const pNeedle, const size_t needleSize, size_t offset)
+			{
+				const size_t lastStart(size - needleSize);
+
+				while (offset <= lastStart)
+				{
+					offset = FindByteScalar(pData, lastStart + 1, pNeedle[0], offset);
+
+					if (offset == NotFound)
+					{
+						return NotFound;
+					}
+
+					if (pData[offset + needleSize - 1] == pNeedle[needleSize - 1] && std::memcmp(pData + offset + 1, pNeedle + 1, needleSize - 2) == 0)
+					{
+						return offset;
+					}
+
+					++offset;
+				}
+
+				return NotFound;
+			}
+
+#ifdef BYTE_SEARCH_HAS_SSE2
+			size_t FindByteSSE2(const BYTE* const pData, const size_t size, const BYTE value, size_t offset)
+			{
+				const __m128i values(_mm_set1_epi8(static_cast<char>(value)));
+
+				for (; offset + 16 <= size; offset += 16)
+				{
+					const __m128i block(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + offset)));
+					const unsigned mask(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, values))));
+
+					if (mask != 0)
+					{
+						return offset + std::countr_zero(mask);
+					}
+				}
+
+				for (; offset < size; ++offset)
+				{
+					if (pData[offset] == value)
+					{
+						return offset;
+					}
+				}
+
+				return NotFound;
+			}
+
+			size_t FindSubstringSSE2(const BYTE* const pData, const size_t size, const BYTE* const pNeedle, const size_t needleSize, size_t offset)
+			{
+				const __m128i firsts(_mm_set1_epi8(static_cast<char>(pNeedle[0])));
+				const __m128i lasts(_mm_set1_epi8(static_cast<char>(pNeedle[needleSize - 1])));
+
+				/* Position i is a candidate when both pData[i] and pData[i + needleSize - 1] match */
+				for (; offset + needleSize - 1 + 16 <= size; offset += 16)
+				{
+					const __m128i blockFirsts(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + offset)));
+					const __m128i blockLasts(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + offset + needleSize - 1)));
+
+					unsigned mask(static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirsts, firsts), _mm_cmpeq_epi8(blockLasts, lasts)))));
+
+					while (mask != 0)
+					{
+						const size_t candidate(offset + std::countr_zero(mask));
+
+						if (std::memcmp(pData + candidate + 1, pNeedle + 1, needleSize - 2) == 0)
+						{
+							return candidate;
+						}
+
+						mask &= mask - 1;
+					}
+				}
+
+				return offset + needleSize <= size ? FindSubstringScalar(pData, size, pNeedle, needleSize, offset) : NotFound;
+			}
+
+			BYTE_SEARCH_AVX2_TARGET size_t FindByteAVX2(const BYTE* const pData, const size_t size, const BYTE value, size_t offset)
+			{
+				const __m256i values(_mm256_set1_epi8(static_cast<char>(value)));
+
+				for (; offset + 32 <= size; offset += 32)
+				{
+					const __m256i block(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + offset)));
+					const unsigned mask(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, values))));
+
+					if (mask != 0)
+					{
+						return offset + std::countr_zero(mask);
+					}
+				}
+
+				return offset < size ? FindByteSSE2(pData, size, value, offset) : NotFound;
+			}
+
+			BYTE_SEARCH_AVX2_TARGET size_t FindSubstringAVX2(const BYTE* const pData, const size_t size, const BYTE* const pNeedle, const size_t needleSize, size_t offset)
+			{
+				const __m256i firsts(_mm256_set1_epi8(static_cast<char>(pNeedle[0])));
+				const __m256i lasts(_mm256_set1_epi8(static_cast<char>(pNeedle[needleSize - 1])));
+
+				for (; offset + needleSize - 1 + 32 <= size; offset += 32)
+				{
+					const __m256i blockFirsts(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + offset)));
+					const __m256i blockLasts(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + offset + needleSize - 1)));
+
+					unsigned mask(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirsts, firsts), _mm256_cmpeq_epi8(blockLasts, lasts)))));
+
+					while (mask != 0)
+					{
+						const size_t candidate(offset + std::countr_zero(mask));
+
+						if (std::memcmp(pData + candidate + 1, pNeedle + 1, needleSize - 2) == 0)
+						{
+							return candidate;
+						}
+
+						mask &= mask - 1;
+					}
+				}
+
+				return offset + needleSize <= size ? FindSubstringSSE2(pData, size, pNeedle, needleSize, offset) : NotFound;
+			}
+
+			bool HasAVX2()
+			{
+#ifdef _MSC_VER
+				int info[4]{};
+				__cpuidex(info, 0, 0);
+
+				if (info[0] < 7)
+				{
+					return false;
+				}
+
+				/* The OS also has to save the AVX registers on a context switch */
+				__cpuidex(info, 1, 0);
+				constexpr int osxsave{ 1 << 27 }, avx{ 1 << 28 };
+
+				if ((info[2] & osxsave) == 0 || (info[2] & avx) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+				{
+					return false;
+				}
+
+				__cpuidex(info, 7, 0);
+				constexpr int avx2{ 1 << 5 };
+
+				return (info[1] & avx2) != 0;
+#else
+				/* Also checks that the OS saves the AVX registers */
+				return __builtin_cpu_supports("avx2");
+#endif
+			}
+#endif
+
+			struct Kernels final
+			{
+				FindByteKernel pFindByte;
+				FindSubstringKernel pFindSubstring;
+				const char* pName;
+			};
+
+			Kernels SelectKernels()
+			{
+#ifdef BYTE_SEARCH_HAS_SSE2
+				if (HasAVX2())
+				{
+					return Kernels{ &FindByteAVX2, &FindSubstringAVX2, "AVX2" };
+				}
+
+				return Kernels{ &FindByteSSE2, &FindSubstringSSE2, "SSE2" };
+#else
+				return Kernels{ &FindByteScalar, &FindSubstringScalar, "Scalar" };
+#endif
+			}
+
+			Kernels& GetKernels()
+			{
+				/* Initialisation of a function local static is thread safe */
+				static Kernels kernels(SelectKernels());
+				return kernels;
+			}
+		}
+
+		size_t FindByte(const BYTE* const pData, const size_t size, const BYTE value, const size_t offset)
+		{
+			return offset < size ? GetKernels().pFindByte(pData, size, value, offset) : NotFound;
+		}
+
+		size_t FindSubstring(const BYTE* const pData, const size_t size, const BYTE* const pNeedle, const size_t needleSize, const size_t offset)
+		{
+			/* Same as std::string_view::find(): an empty needle is found at offset, as long as offset is inside the text */
+			if (needleSize == 0)
+			{
+				return offset <= size ? offset : NotFound;
+			}
+
+			if (offset > size || needleSize > size - offset)
+			{
+				return NotFound;
+			}
+
+			if (needleSize == 1)
+			{
+				return FindByte(pData, size, pNeedle[0], offset);
+			}
+
+			return GetKernels().pFindSubstring(pData, size, pNeedle, needleSize, offset);
+		}
+
+		size_t FindByteUnbounded(const BYTE* const pData, const BYTE value)
+		{
+			/* AddressSanitizer does not know aligned reads can not fault, so it gets the plain loop */
+#if defined(BYTE_SEARCH_HAS_SSE2) && !defined(BYTE_SEARCH_HAS_ASAN)
+			const __m128i values(_mm_set1_epi8(static_cast<char>(value)));
+
+			/* The first block starts before pData, the bytes in front of it are shifted out of the mask */
+			const size_t misalignment(reinterpret_cast<uintptr_t>(pData) & 15);
+			const BYTE* pBlock(pData - misalignment);
+
+			unsigned mask(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(pBlock)), values))) >> misalignment);
+
+			while (mask == 0)
+			{
+				pBlock += 16;
+				mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(pBlock)), values)));
+
+				if (mask != 0)
+				{
+					return static_cast<size_t>(pBlock - pData) + std::countr_zero(mask);
+				}
+			}
+
+			return std::countr_zero(mask);
+#else
+			size_t counter{};
+			while (pData[counter] != value)
+			{
+				++counter;
+			}
+
+			return counter;
+#endif
+		}
+
+		const char* GetByteSearchKernelName()
+		{
+			return GetKernels().pName;
+		}
+
+		bool UseByteSearchKernel(const std::string_view name)
+		{
+			Kernels kernels{ &FindByteScalar, &FindSubstringScalar, "Scalar" };
+
+#ifdef BYTE_SEARCH_HAS_SSE2
+			if (name == "SSE2")
+			{
+				kernels = Kernels{ &FindByteSSE2, &FindSubstringSSE2, "SSE2" };
+			}
+			else if (name == "AVX2" && HasAVX2())
+			{
+				kernels = Kernels{ &FindByteAVX2, &FindSubstringAVX2, "AVX2" };
+			}
+#endif
+
+			if (name != kernels.pName)
+			{
+				return false;
+			}
+
+			GetKernels() = kernels;
+			return true;
+		}
+	}
+}
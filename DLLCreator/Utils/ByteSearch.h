@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Utils.h" /* BYTE */
+
+#include <string> /* std::basic_string */
+#include <string_view> /* std::string_view, std::basic_string_view */
+
+namespace Utils
+{
+	namespace IO
+	{
+		/* Vectorized searches over byte buffers. Which kernel runs (AVX2, SSE2 or plain C++) is decided once, on first use,
+		from what the CPU supports. The results are the same as the matching std::string_view::find() */
+
+		inline constexpr size_t NotFound{ static_cast<size_t>(-1) };
+
+		/* The index of the first value at or after offset, or NotFound */
+		size_t FindByte(const BYTE* const pData, const size_t size, const BYTE value, const size_t offset = 0);
+
+		/* The index of the first occurrence of the needle at or after offset, or NotFound.
+		Candidates are filtered on the first and last byte of the needle 16 or 32 positions at a time, only those get compared in full */
+		size_t FindSubstring(const BYTE* const pData, const size_t size, const BYTE* const pNeedle, const size_t needleSize, const size_t offset = 0);
+
+		/* The index of the first value, for buffers that are only known to contain it (like a '\0' terminated string).
+		Only ever reads aligned blocks, which never cross into the next page, so this can not fault on a page the string does not touch */
+		size_t FindByteUnbounded(const BYTE* const pData, const BYTE value);
+
+		inline size_t FindByte(const std::basic_string_view<BYTE> text, const BYTE value, const size_t offset = 0)
+		{
+			return FindByte(text.data(), text.size(), value, offset);
+		}
+
+		inline size_t FindByte(const std::string_view text, const char value, const size_t offset = 0)
+		{
+			return FindByte(reinterpret_cast<const BYTE*>(text.data()), text.size(), static_cast<BYTE>(value), offset);
+		}
+
+		inline size_t FindSubstring(const std::basic_string_view<BYTE> text, const std::basic_string_view<BYTE> needle, const size_t offset = 0)
+		{
+			return FindSubstring(text.data(), text.size(), needle.data(), needle.size(), offset);
+		}
+
+		inline size_t FindSubstring(const std::string_view text, const std::string_view needle, const size_t offset = 0)
+		{
+			return FindSubstring(reinterpret_cast<const BYTE*>(text.data()), text.size(), reinterpret_cast<const BYTE*>(needle.data()), needle.size(), offset);
+		}
+
+		/* "AVX2", "SSE2" or "Scalar" */
+		const char* GetByteSearchKernelName();
+
+		/* Makes every search after this run on the named kernel, so tests can cover the ones the CPU would not pick.
+		Returns false, and changes nothing, when this CPU or build does not have it. Not safe while other threads are searching */
+		bool UseByteSearchKernel(const std::string_view name);
+	}
+}
@@ -0,0 +1,64 @@
+#include "EditList.h"
+
+#include <algorithm> /* std::stable_sort */
+#include <assert.h> /* assert() */
+
+namespace Utils
+{
+	namespace IO
+	{
+		void EditList::Insert(const size_t offset, const std::basic_string_view<BYTE> text)
+		{
+			Replace(offset, 0, text);
+		}
+
+		void EditList::Replace(const size_t offset, const size_t count, const std::basic_string_view<BYTE> text)
+		{
+			Edits.push_back(Edit{ offset, count, TextStorage.size(), text.size() });
+			TextStorage.append(text);
+		}
+
+		std::basic_string<BYTE> EditList::Apply(const std::basic_string_view<BYTE> source) const
+		{
+			const std::vector<Edit> sortedEdits(GetSortedEdits());
+
+			size_t finalSize(source.size());
+			for (const Edit& edit : sortedEdits)
+			{
+				finalSize += edit.TextSize;
+				finalSize -= edit.EraseCount;
+			}
+
+			std::basic_string<BYTE> output{};
+			output.reserve(finalSize);
+
+			size_t sourcePos{};
+			for (const Edit& edit : sortedEdits)
+			{
+				assert(edit.Offset >= sourcePos && "EditList::Apply() > Edits may not overlap!");
+				assert(edit.Offset + edit.EraseCount <= source.size() && "EditList::Apply() > Edit is out of bounds!");
+
+				output.append(source.substr(sourcePos, edit.Offset - sourcePos));
+				output.append(TextStorage, edit.TextOffset, edit.TextSize);
+
+				sourcePos = edit.Offset + edit.EraseCount;
+			}
+
+			output.append(source.substr(sourcePos));
+
+			return output;
+		}
+
+		std::vector<EditList::Edit> EditList::GetSortedEdits() const
+		{
+			std::vector<Edit> sortedEdits(Edits);
+
+			std::stable_sort(sortedEdits.begin(), sortedEdits.end(), [](const Edit& a, const Edit& b)->bool
+				{
+					return a.Offset < b.Offset;
+				});
+
+			return sortedEdits;
+		}
+	}
+}
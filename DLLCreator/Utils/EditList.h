@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <string> /* std::basic_string */
+#include <string_view> /* std::basic_string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace IO
+	{
+		/* Collects insertions and replacements against offsets in the *original* buffer,
+		so callers never have to shift offsets after an edit. All edits get applied in one linear pass. */
+		class EditList final
+		{
+		public:
+			/* Inserts text in front of the byte at offset */
+			void Insert(const size_t offset, const std::basic_string_view<BYTE> text);
+
+			/* Replaces count bytes starting at offset with text. Replaced ranges may not overlap */
+			void Replace(const size_t offset, const size_t count, const std::basic_string_view<BYTE> text);
+
+			bool IsEmpty() const { return Edits.empty(); }
+			size_t GetNumberOfEdits() const { return Edits.size(); }
+
+			/* Copies source into a new buffer with every edit applied */
+			std::basic_string<BYTE> Apply(const std::basic_string_view<BYTE> source) const;
+
+		private:
+			struct Edit final
+			{
+				size_t Offset;
+				size_t EraseCount;
+				size_t TextOffset; /* into TextStorage */
+				size_t TextSize;
+			};
+
+			/* Edits sorted by offset, edits at the same offset keep the order they were added in */
+			std::vector<Edit> GetSortedEdits() const;
+
+			std::vector<Edit> Edits{};
+			std::basic_string<BYTE> TextStorage{};
+		};
+	}
+}
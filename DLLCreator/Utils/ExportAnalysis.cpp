@@ -0,0 +1,432 @@
+#include "ExportAnalysis.h"
+
+#include <cctype> /* std::isalpha, std::isdigit, std::isspace */
+
+namespace Utils
+{
+	namespace Cpp
+	{
+		namespace
+		{
+			std::string_view Trim(std::string_view text)
+			{
+				while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+				{
+					text.remove_prefix(1);
+				}
+
+				while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+				{
+					text.remove_suffix(1);
+				}
+
+				return text;
+			}
+
+			/* Splits off the first whitespace separated field of text */
+			std::string_view TakeField(std::string_view& text)
+			{
+				text = Trim(text);
+
+				size_t end{};
+				while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])))
+				{
+					++end;
+				}
+
+				const std::string_view field(text.substr(0, end));
+				text = Trim(text.substr(end));
+
+				return field;
+			}
+
+			/* The one letter nm puts in front of every symbol, U for undefined */
+			bool IsSymbolType(const std::string_view field)
+			{
+				return field.size() == 1 && std::isalpha(static_cast<unsigned char>(field[0]));
+			}
+
+			/* A class with a member function that is declared here but defined in some .cpp needs its members exported */
+			bool HasOutOfLineMembers(const std::vector<Declaration>& declarations, const size_t classIndex)
+			{
+				const uint32_t memberDepth(declarations[classIndex].Depth + 1);
+
+				for (size_t i(classIndex + 1); i < declarations.size() && declarations[i].Depth >= memberDepth; ++i)
+				{
+					const Declaration& member(declarations[i]);
+
+					if (member.Depth == memberDepth && member.Type == DeclarationType::Function && !member.bIsDefinition &&
+						!HasAnySpecifier(member.Specifiers, Specifier::Inline | Specifier::Constexpr | Specifier::Template | Specifier::Defaulted | Specifier::PureVirtual))
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}
+		}
+
+		const char* GetExportKindName(const ExportKind kind)
+		{
+			switch (kind)
+			{
+			case ExportKind::Function:
+				return "exported function";
+			case ExportKind::Class:
+				return "exported class";
+			case ExportKind::Inline:
+				return "inline";
+			case ExportKind::Template:
+				return "template";
+			case ExportKind::Internal:
+				return "internal";
+			case ExportKind::Member:
+				return "member";
+			case ExportKind::Undefined:
+				return "not defined by the libraries";
+			default:
+				return "unknown";
+			}
+		}
+
+		void SymbolIndex::AddSymbol(std::string_view symbol)
+		{
+			symbol = Trim(symbol);
+
+			/* The import thunks of a .dll */
+			if (symbol.substr(0, 6) == "__imp_")
+			{
+				symbol.remove_prefix(6);
+			}
+
+			if (symbol.empty())
+			{
+				return;
+			}
+
+			if (symbol.front() == '?')
+			{
+				AddMSVCSymbol(symbol);
+			}
+			else if (symbol.substr(0, 2) == "_Z" || symbol.substr(0, 3) == "__Z")
+			{
+				/* Mach-O puts an extra _ in front */
+				AddItaniumSymbol(symbol.substr(symbol[1] == 'Z' ? 2 : 3));
+			}
+			else if (symbol.find("::") != std::string_view::npos || symbol.find('(') != std::string_view::npos)
+			{
+				AddDemangledSymbol(symbol);
+			}
+			else
+			{
+				/* C names get a leading _ on 32 bit Windows and on Mach-O */
+				Names.emplace(symbol);
+
+				if (symbol.front() == '_')
+				{
+					Names.emplace(symbol.substr(1));
+				}
+			}
+		}
+
+		void SymbolIndex::AddSymbolList(const std::string_view text)
+		{
+			size_t lineBegin{};
+
+			while (lineBegin < text.size())
+			{
+				size_t lineEnd(text.find('\n', lineBegin));
+				lineEnd = lineEnd == std::string_view::npos ? text.size() : lineEnd;
+
+				std::string_view line(Trim(text.substr(lineBegin, lineEnd - lineBegin)));
+				lineBegin = lineEnd + 1;
+
+				if (line.empty())
+				{
+					continue;
+				}
+
+				/* dumpbin /symbols: 008 00000000 SECT3 notype () External | ?Add@@YAHHH@Z (int __cdecl Add(int,int)) */
+				if (const size_t bar = line.find('|'); bar != std::string_view::npos)
+				{
+					if (line.find("UNDEF") == std::string_view::npos && line.find("External") != std::string_view::npos)
+					{
+						std::string_view rest(line.substr(bar + 1));
+						AddSymbol(TakeField(rest));
+					}
+
+					continue;
+				}
+
+				/* nm: 0000000000000000 T _Z3Addii, undefined symbols have no address: U _Z3Subii */
+				std::string_view rest(line);
+				const std::string_view first(TakeField(rest));
+
+				if (IsSymbolType(first) && !rest.empty())
+				{
+					if (first != "U")
+					{
+						AddSymbol(rest);
+					}
+
+					continue;
+				}
+
+				std::string_view afterType(rest);
+				const std::string_view second(TakeField(afterType));
+
+				if (IsSymbolType(second) && !afterType.empty())
+				{
+					if (second != "U")
+					{
+						AddSymbol(afterType);
+					}
+
+					continue;
+				}
+
+				AddSymbol(line);
+			}
+		}
+
+		bool SymbolIndex::DefinesFunction(const std::string_view name) const
+		{
+			return Names.find(std::string(name)) != Names.cend();
+		}
+
+		bool SymbolIndex::DefinesMembersOf(const std::string_view className) const
+		{
+			return Scopes.find(std::string(className)) != Scopes.cend();
+		}
+
+		void SymbolIndex::AddMSVCSymbol(const std::string_view symbol)
+		{
+			/* ?Name@Scope@Outer@@Type, or ??0Scope@@ for constructors, ??1 for destructors, ??_7 for vtables and so on */
+			size_t position(1);
+			const bool bIsSpecial(symbol.size() > 2 && symbol[1] == '?');
+
+			if (bIsSpecial)
+			{
+				/* ??$Name@ is a template */
+				if (symbol[2] == '$')
+				{
+					return;
+				}
+
+				position = symbol[2] == '_' ? 4 : 3;
+			}
+
+			std::vector<std::string_view> components{};
+
+			while (position < symbol.size() && symbol[position] != '@')
+			{
+				const size_t end(symbol.find('@', position));
+
+				if (end == std::string_view::npos)
+				{
+					break;
+				}
+
+				/* Templates (?$) and back references (0-9) can not be read without a full demangler */
+				if (symbol[position] == '?' || std::isdigit(static_cast<unsigned char>(symbol[position])))
+				{
+					break;
+				}
+
+				components.push_back(symbol.substr(position, end - position));
+				position = end + 1;
+			}
+
+			if (bIsSpecial)
+			{
+				if (!components.empty())
+				{
+					Scopes.emplace(components.front());
+				}
+			}
+			else if (!components.empty())
+			{
+				Names.emplace(components.front());
+
+				if (components.size() > 1)
+				{
+					Scopes.emplace(components[1]);
+				}
+			}
+		}
+
+		void SymbolIndex::AddItaniumSymbol(const std::string_view symbol)
+		{
+			/* Internal linkage */
+			if (symbol.empty() || symbol.front() == 'L')
+			{
+				return;
+			}
+
+			size_t position{};
+			const bool bIsNested(symbol.front() == 'N');
+
+			if (bIsNested)
+			{
+				++position;
+
+				/* const, volatile, restrict, & and && of member functions */
+				while (position < symbol.size() && (symbol[position] == 'K' || symbol[position] == 'V' || symbol[position] == 'r' || symbol[position] == 'R' || symbol[position] == 'O'))
+				{
+					++position;
+				}
+			}
+
+			std::vector<std::string_view> components{};
+			bool bIsStructor{};
+
+			while (position < symbol.size())
+			{
+				if (symbol.substr(position, 2) == "St")
+				{
+					position += 2;
+				}
+				else if (std::isdigit(static_cast<unsigned char>(symbol[position])))
+				{
+					size_t length{};
+
+					while (position < symbol.size() && std::isdigit(static_cast<unsigned char>(symbol[position])))
+					{
+						length = length * 10 + static_cast<size_t>(symbol[position] - '0');
+						++position;
+					}
+
+					if (length == 0 || position + length > symbol.size())
+					{
+						return;
+					}
+
+					components.push_back(symbol.substr(position, length));
+					position += length;
+
+					if (!bIsNested)
+					{
+						break;
+					}
+				}
+				else
+				{
+					/* C1, C2, D0, D1, D2 name the constructor or destructor of the last component */
+					bIsStructor = bIsNested && position + 1 < symbol.size() && (symbol[position] == 'C' || symbol[position] == 'D') &&
+						std::isdigit(static_cast<unsigned char>(symbol[position + 1]));
+
+					/* E ends the nested name, anything else (templates, substitutions) can not be read without a full demangler */
+					break;
+				}
+			}
+
+			if (components.empty())
+			{
+				return;
+			}
+
+			if (bIsStructor)
+			{
+				Scopes.emplace(components.back());
+				return;
+			}
+
+			Names.emplace(components.back());
+
+			if (components.size() > 1)
+			{
+				Scopes.emplace(components[components.size() - 2]);
+			}
+		}
+
+		void SymbolIndex::AddDemangledSymbol(std::string_view symbol)
+		{
+			/* int __cdecl Math::Add(int, int) const */
+			symbol = Trim(symbol.substr(0, symbol.find('(')));
+
+			if (const size_t space = symbol.find_last_of(" *&"); space != std::string_view::npos)
+			{
+				symbol.remove_prefix(space + 1);
+			}
+
+			const size_t separator(symbol.rfind("::"));
+
+			if (separator == std::string_view::npos)
+			{
+				if (!symbol.empty())
+				{
+					Names.emplace(symbol);
+				}
+
+				return;
+			}
+
+			const std::string_view name(symbol.substr(separator + 2));
+			std::string_view scope(symbol.substr(0, separator));
+
+			if (const size_t outer = scope.rfind("::"); outer != std::string_view::npos)
+			{
+				scope.remove_prefix(outer + 2);
+			}
+
+			/* Engine::Engine and Engine::~Engine */
+			if (name != scope && (name.empty() || name.front() != '~'))
+			{
+				Names.emplace(name);
+			}
+
+			Scopes.emplace(scope);
+		}
+
+		void AnalyzeExports(const std::string_view text, const std::vector<Declaration>& declarations, const SymbolIndex* pSymbols, std::vector<ExportKind>& kinds)
+		{
+			const bool bHasSymbols(pSymbols != nullptr && !pSymbols->IsEmpty());
+
+			kinds.resize(declarations.size());
+
+			for (size_t i{}; i < declarations.size(); ++i)
+			{
+				const Declaration& declaration(declarations[i]);
+				const std::string_view name(text.substr(declaration.NameBegin, declaration.NameEnd - declaration.NameBegin));
+
+				if (HasAnySpecifier(declaration.Specifiers, Specifier::Template))
+				{
+					kinds[i] = ExportKind::Template;
+				}
+				else if (HasAnySpecifier(declaration.Specifiers, Specifier::Internal))
+				{
+					kinds[i] = ExportKind::Internal;
+				}
+				else if (declaration.Depth > 0)
+				{
+					kinds[i] = ExportKind::Member;
+				}
+				else if (declaration.Type != DeclarationType::Function)
+				{
+					if (!HasOutOfLineMembers(declarations, i))
+					{
+						kinds[i] = ExportKind::Inline;
+					}
+					else
+					{
+						kinds[i] = !bHasSymbols || pSymbols->DefinesMembersOf(name) ? ExportKind::Class : ExportKind::Undefined;
+					}
+				}
+				else if (HasAnySpecifier(declaration.Specifiers, Specifier::Static))
+				{
+					kinds[i] = ExportKind::Internal;
+				}
+				else if (declaration.bIsDefinition || HasAnySpecifier(declaration.Specifiers, Specifier::Inline | Specifier::Constexpr | Specifier::Defaulted))
+				{
+					kinds[i] = ExportKind::Inline;
+				}
+				else
+				{
+					/* Operators are mangled into codes, so they can not be looked up by name */
+					const bool bIsDefined(!bHasSymbols || name.substr(0, 8) == "operator" || pSymbols->DefinesFunction(name));
+					kinds[i] = bIsDefined ? ExportKind::Function : ExportKind::Undefined;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "HeaderParser.h" /* Declaration */
+
+#include <cstdint> /* uint8_t */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <unordered_set> /* std::unordered_set */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace Cpp
+	{
+		/* What should happen to a declaration when its header gets readied for the .dll */
+		enum class ExportKind : uint8_t
+		{
+			Function = 0, /* a free function defined in some .cpp, gets the API macro in front */
+			Class = 1, /* a class with members defined in some .cpp, gets the API macro after class or struct */
+			Inline = 2, /* inline, constexpr, deleted or defined in the header, every user compiles its own copy */
+			Template = 3, /* instantiated by its users, there is nothing to export */
+			Internal = 4, /* static or in an anonymous namespace, so invisible outside of its own .cpp */
+			Member = 5, /* exported along with its class, or not at all */
+			Undefined = 6 /* none of the libraries defines it, exporting it would break the link */
+		};
+
+		const char* GetExportKindName(const ExportKind kind);
+
+		/* The functions and classes a set of built libraries defines, read from their symbols.
+		Only names are kept, so overloads and namespaces are not told apart */
+		class SymbolIndex final
+		{
+		public:
+			/* Takes MSVC (?Add@Math@@YAHHH@Z) and Itanium (_ZN4Math3AddEii) mangled names, demangled ones (Math::Add(int, int))
+			and plain C names */
+			void AddSymbol(std::string_view symbol);
+
+			/* One symbol per line. The output of nm and dumpbin /symbols works as well, undefined symbols in it are skipped */
+			void AddSymbolList(const std::string_view text);
+
+			bool IsEmpty() const { return Names.empty() && Scopes.empty(); }
+
+			bool DefinesFunction(const std::string_view name) const;
+			/* True if any member of the class, its vtable included, is defined */
+			bool DefinesMembersOf(const std::string_view className) const;
+
+		private:
+			void AddMSVCSymbol(const std::string_view symbol);
+			void AddItaniumSymbol(const std::string_view symbol);
+			void AddDemangledSymbol(const std::string_view symbol);
+
+			std::unordered_set<std::string> Names{}; /* functions and variables, unqualified */
+			std::unordered_set<std::string> Scopes{}; /* the classes and namespaces the names were in, innermost only */
+		};
+
+		/* Decides for every declaration ParseDeclarations() found in text whether it gets the API macro, kinds[i] is the decision for declarations[i].
+		Without symbols (nullptr or empty) every function declared without a body is assumed to be defined in some .cpp.
+		Static data members are not parsed, so a class with nothing but those out of line is taken for Inline */
+		void AnalyzeExports(const std::string_view text, const std::vector<Declaration>& declarations, const SymbolIndex* pSymbols, std::vector<ExportKind>& kinds);
+	}
+}
@@ -0,0 +1,133 @@
+#include "FileClassifier.h"
+
+#include <algorithm> /* std::lower_bound, std::is_sorted, std::binary_search */
+#include <array> /* std::array */
+#include <cctype> /* std::tolower */
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			struct KindEntry final
+			{
+				std::string_view Name;
+				FileKind Kind;
+			};
+
+			constexpr bool operator<(const KindEntry& a, const KindEntry& b)
+			{
+				return a.Name < b.Name;
+			}
+
+			/* Both tables are lowercase and sorted on name, so a lookup is a binary search over a handful of entries */
+			constexpr std::array<KindEntry, 17> Extensions{ {
+				{ ".bin", FileKind::Binary },
+				{ ".cpp", FileKind::Source },
+				{ ".dll", FileKind::DynamicLibrary },
+				{ ".exe", FileKind::Binary },
+				{ ".h", FileKind::Header },
+				{ ".hh", FileKind::Header },
+				{ ".hpp", FileKind::Header },
+				{ ".hxx", FileKind::Header },
+				{ ".lib", FileKind::StaticLibrary },
+				{ ".props", FileKind::ProjectSettings },
+				{ ".rar", FileKind::Archive },
+				{ ".sln", FileKind::Solution },
+				{ ".txt", FileKind::Text },
+				{ ".vcxproj", FileKind::Project },
+				{ ".vcxproj.filters", FileKind::ProjectSettings },
+				{ ".vcxproj.user", FileKind::ProjectSettings },
+				{ ".zip", FileKind::Archive }
+			} };
+
+			constexpr std::array<KindEntry, 8> DirectoryNames{ {
+				{ ".git", FileKind::ToolFolder },
+				{ ".vs", FileKind::ToolFolder },
+				{ "debug", FileKind::BuildFolder },
+				{ "dll_build", FileKind::BuildFolder },
+				{ "dll_cache", FileKind::BuildFolder },
+				{ "release", FileKind::BuildFolder },
+				{ "x64", FileKind::BuildFolder },
+				{ "x86", FileKind::BuildFolder }
+			} };
+
+			static_assert(std::is_sorted(Extensions.begin(), Extensions.end()), "FileClassifier > Extensions must be sorted on name");
+			static_assert(std::is_sorted(DirectoryNames.begin(), DirectoryNames.end()), "FileClassifier > DirectoryNames must be sorted on name");
+
+			template<size_t N>
+			FileKind FindKind(const std::array<KindEntry, N>& table, const std::string_view name)
+			{
+				const auto cIt(std::lower_bound(table.cbegin(), table.cend(), KindEntry{ name, FileKind::None }));
+				return cIt != table.cend() && cIt->Name == name ? cIt->Kind : FileKind::None;
+			}
+
+			std::string ToLower(const std::string_view text)
+			{
+				std::string lower(text);
+
+				for (char& c : lower)
+				{
+					c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+				}
+
+				return lower;
+			}
+
+			/* Like std::filesystem, a leading dot (".gitignore") is not an extension */
+			std::string_view GetExtension(const std::string_view name, const size_t searchEnd = std::string_view::npos)
+			{
+				const size_t dot(name.find_last_of('.', searchEnd));
+				return dot == std::string_view::npos || dot == 0 ? std::string_view{} : name.substr(dot);
+			}
+		}
+
+		FileKind FileClassifier::Classify(const std::string_view name, const bool bIsDirectory) const
+		{
+			const std::string lowerName(ToLower(name));
+
+			FileKind kind(FileKind::None);
+			std::string_view extension{};
+
+			if (bIsDirectory)
+			{
+				kind = FileKind::Directory | FindKind(DirectoryNames, lowerName);
+			}
+			else if (extension = GetExtension(lowerName); !extension.empty())
+			{
+				/* Two part extensions (".vcxproj.user") win over their last part */
+				if (const std::string_view doubleExtension(GetExtension(lowerName, lowerName.size() - extension.size() - 1)); !doubleExtension.empty())
+				{
+					kind = FindKind(Extensions, doubleExtension);
+				}
+
+				if (kind == FileKind::None)
+				{
+					kind = FindKind(Extensions, extension);
+				}
+			}
+
+			if (std::binary_search(ExcludedNames.cbegin(), ExcludedNames.cend(), lowerName) ||
+				(!extension.empty() && std::binary_search(ExcludedExtensions.cbegin(), ExcludedExtensions.cend(), extension)))
+			{
+				kind = kind | FileKind::Excluded;
+			}
+
+			return kind;
+		}
+
+		void FileClassifier::Exclude(const std::string_view pattern)
+		{
+			std::vector<std::string>& patterns(pattern.starts_with("*.") ? ExcludedExtensions : ExcludedNames);
+			const std::string lowerPattern(ToLower(pattern.starts_with("*.") ? pattern.substr(1) : pattern));
+
+			const auto it(std::lower_bound(patterns.begin(), patterns.end(), lowerPattern));
+
+			if (it == patterns.end() || *it != lowerPattern)
+			{
+				patterns.insert(it, lowerPattern);
+			}
+		}
+	}
+}
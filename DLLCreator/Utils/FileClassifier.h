@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint> /* uint16_t */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace IO
+	{
+		/* What a file or folder is, as a bitmask so callers can test for several kinds at once */
+		enum class FileKind : uint16_t
+		{
+			None = 0,
+			Directory = 1 << 0,
+			Header = 1 << 1, /* .h, .hh, .hpp, .hxx */
+			Source = 1 << 2, /* .cpp */
+			StaticLibrary = 1 << 3, /* .lib */
+			DynamicLibrary = 1 << 4, /* .dll */
+			Project = 1 << 5, /* .vcxproj */
+			Solution = 1 << 6, /* .sln */
+			ProjectSettings = 1 << 7, /* .vcxproj.user, .vcxproj.filters, .props */
+			Archive = 1 << 8, /* .rar, .zip */
+			Text = 1 << 9, /* .txt */
+			Binary = 1 << 10, /* .bin, .exe */
+			BuildFolder = 1 << 11, /* x64, x86, Debug, Release, DLL_BUILD, DLL_CACHE */
+			ToolFolder = 1 << 12, /* .vs, .git */
+			Excluded = 1 << 13 /* matched one of the names passed to FileClassifier::Exclude() */
+		};
+
+		constexpr FileKind operator|(const FileKind a, const FileKind b)
+		{
+			return static_cast<FileKind>(static_cast<uint16_t>(a) | static_cast<uint16_t>(b));
+		}
+
+		constexpr FileKind operator&(const FileKind a, const FileKind b)
+		{
+			return static_cast<FileKind>(static_cast<uint16_t>(a) & static_cast<uint16_t>(b));
+		}
+
+		constexpr bool HasAnyKind(const FileKind kind, const FileKind mask)
+		{
+			return (kind & mask) != FileKind::None;
+		}
+
+		/* Works out the FileKind of a file or folder from its name alone: the extension, or for folders the whole name,
+		is looked up in a small sorted table. Names are compared case insensitive, like Windows does */
+		class FileClassifier final
+		{
+		public:
+			/* The files and folders that never need to be converted or asked about */
+			inline constexpr static FileKind DefaultExcludedKinds{ FileKind::Solution | FileKind::ProjectSettings | FileKind::Archive | FileKind::Text |
+				FileKind::Binary | FileKind::BuildFolder | FileKind::ToolFolder | FileKind::Excluded };
+
+			FileKind Classify(const std::string_view name, const bool bIsDirectory) const;
+
+			/* pattern is either the name of a file or folder ("ThirdParty") or an extension ("*.tlog").
+			Matching entries get FileKind::Excluded on top of their own kind */
+			void Exclude(const std::string_view pattern);
+
+			void SetExcludedKinds(const FileKind kinds) { ExcludedKinds = kinds; }
+			FileKind GetExcludedKinds() const { return ExcludedKinds; }
+
+			bool IsExcluded(const FileKind kind) const { return HasAnyKind(kind, ExcludedKinds); }
+
+		private:
+			FileKind ExcludedKinds{ DefaultExcludedKinds };
+			std::vector<std::string> ExcludedNames{}; /* lowercase, sorted */
+			std::vector<std::string> ExcludedExtensions{}; /* lowercase with the dot, sorted */
+		};
+	}
+}
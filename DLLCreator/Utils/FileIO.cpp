@@ -0,0 +1,136 @@
+#include "FileIO.h"
+#include "Hash.h" /* Hash() */
+
+#include <atomic> /* std::atomic */
+#include <cstdint> /* uint64_t */
+#include <utility> /* std::exchange */
+
+#ifdef _WIN32
+#include <process.h> /* _getpid() */
+#else
+#include <unistd.h> /* getpid() */
+#endif
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			long long GetProcessNumber()
+			{
+#ifdef _WIN32
+				return _getpid();
+#else
+				return getpid();
+#endif
+			}
+		}
+
+		MappedFile::MappedFile(FileBackend* pOwner, const BYTE* pData, const size_t size, void* pNativeHandle)
+			: pOwner{ pOwner }
+			, pData{ pData }
+			, FileSize{ size }
+			, pNativeHandle{ pNativeHandle }
+		{}
+
+		MappedFile::~MappedFile()
+		{
+			Release();
+		}
+
+		MappedFile::MappedFile(MappedFile&& other) noexcept
+			: pOwner{ std::exchange(other.pOwner, nullptr) }
+			, pData{ std::exchange(other.pData, nullptr) }
+			, FileSize{ std::exchange(other.FileSize, 0) }
+			, pNativeHandle{ std::exchange(other.pNativeHandle, nullptr) }
+		{}
+
+		MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Release();
+
+				pOwner = std::exchange(other.pOwner, nullptr);
+				pData = std::exchange(other.pData, nullptr);
+				FileSize = std::exchange(other.FileSize, 0);
+				pNativeHandle = std::exchange(other.pNativeHandle, nullptr);
+			}
+
+			return *this;
+		}
+
+		void MappedFile::Release()
+		{
+			if (pOwner)
+			{
+				pOwner->UnmapFile(pData, FileSize, pNativeHandle);
+
+				pOwner = nullptr;
+				pData = nullptr;
+				FileSize = 0;
+				pNativeHandle = nullptr;
+			}
+		}
+
+		std::string FileBackend::GetTemporaryPath(const std::string& filePath)
+		{
+			/* The process id keeps two runs apart, the counter two threads of the same run */
+			static std::atomic<uint64_t> counter{};
+
+			return filePath + ".tmp" + std::to_string(GetProcessNumber()) + "." + std::to_string(counter++);
+		}
+
+		void FileBackend::AddWrittenFile(const std::string& filePath)
+		{
+			const std::lock_guard lock(WrittenFilesMutex);
+			WrittenFiles.push_back(filePath);
+		}
+
+		std::vector<std::string> FileBackend::TakeWrittenFiles()
+		{
+			const std::lock_guard lock(WrittenFilesMutex);
+			return std::exchange(WrittenFiles, {});
+		}
+
+		bool ReadFile(const std::string& filePath, std::basic_string<BYTE>& contents)
+		{
+			return GetFileBackend().ReadFile(filePath, contents);
+		}
+
+		bool WriteFile(const std::string& filePath, const std::basic_string_view<BYTE> contents)
+		{
+			return GetFileBackend().WriteFile(filePath, contents);
+		}
+
+		bool WriteFile(const std::string& filePath, const std::string_view contents)
+		{
+			return GetFileBackend().WriteFile(filePath, std::basic_string_view<BYTE>(reinterpret_cast<const BYTE*>(contents.data()), contents.size()));
+		}
+
+		MappedFile MapFile(const std::string& filePath)
+		{
+			return GetFileBackend().MapFile(filePath);
+		}
+
+		bool SyncWrittenFiles()
+		{
+			return GetFileBackend().SyncWrittenFiles();
+		}
+
+		WriteResult WriteFileIfChanged(const std::string& filePath, const std::basic_string_view<BYTE> contents)
+		{
+			{ /* Scope-lock the mapping, it has to be released before the file can be replaced */
+				const MappedFile file(MapFile(filePath));
+
+				if (file.IsValid() && file.Size() == contents.size() && Hash(file.View()) == Hash(contents))
+				{
+					return WriteResult::Unchanged;
+				}
+			}
+
+			return WriteFile(filePath, contents) ? WriteResult::Written : WriteResult::Failed;
+		}
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <cstdint> /* uint8_t */
+#include <mutex> /* std::mutex */
+#include <string> /* std::string */
+#include <string_view> /* std::basic_string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace IO
+	{
+		class FileBackend;
+
+		/* Read-only view of an entire file. The view stays valid for as long as this object lives */
+		class MappedFile final
+		{
+		public:
+			MappedFile() = default;
+			MappedFile(FileBackend* pOwner, const BYTE* pData, const size_t size, void* pNativeHandle);
+			~MappedFile();
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile(MappedFile&& other) noexcept;
+			MappedFile& operator=(const MappedFile&) = delete;
+			MappedFile& operator=(MappedFile&& other) noexcept;
+
+			bool IsValid() const { return pOwner != nullptr; }
+			const BYTE* Data() const { return pData; }
+			size_t Size() const { return FileSize; }
+			std::basic_string_view<BYTE> View() const { return std::basic_string_view<BYTE>(pData, FileSize); }
+
+		private:
+			void Release();
+
+			FileBackend* pOwner{};
+			const BYTE* pData{};
+			size_t FileSize{};
+			void* pNativeHandle{};
+		};
+
+		/* Every file the tool touches goes through this interface, so that all pipeline steps share one I/O path */
+		class FileBackend
+		{
+		public:
+			virtual ~FileBackend() = default;
+
+			/* Reads the entire file into contents, returns false if the file could not be opened or read */
+			virtual bool ReadFile(const std::string& filePath, std::basic_string<BYTE>& contents) = 0;
+
+			/* Replaces the contents of the file with contents, creating the file if needed.
+			The contents go to a temporary file next to it, which then gets renamed over the file, so a crash or a failed write
+			leaves either the old or the new file and never a half written one. Nothing is flushed to disk here, see SyncWrittenFiles() */
+			virtual bool WriteFile(const std::string& filePath, const std::basic_string_view<BYTE> contents) = 0;
+
+			/* Flushes every file written since the last call to disk, together with the folders they were renamed in.
+			One call at the end of a run costs a lot less than flushing thousands of files one at a time */
+			virtual bool SyncWrittenFiles() = 0;
+
+			/* Maps the entire file read-only, the returned object is invalid if the file could not be mapped */
+			virtual MappedFile MapFile(const std::string& filePath) = 0;
+
+		protected:
+			friend class MappedFile;
+
+			virtual void UnmapFile(const BYTE* pData, const size_t size, void* pNativeHandle) = 0;
+
+			/* A name next to filePath that no other write, in this process or another, uses at the same time */
+			static std::string GetTemporaryPath(const std::string& filePath);
+
+			/* Thread safe bookkeeping for SyncWrittenFiles() */
+			void AddWrittenFile(const std::string& filePath);
+			std::vector<std::string> TakeWrittenFiles();
+
+		private:
+			std::mutex WrittenFilesMutex{};
+			std::vector<std::string> WrittenFiles{};
+		};
+
+		/* Returns the backend of the platform we were compiled for */
+		FileBackend& GetFileBackend();
+
+		enum class WriteResult : uint8_t
+		{
+			Failed = 0,
+			Written = 1,
+			Unchanged = 2
+		};
+
+		bool ReadFile(const std::string& filePath, std::basic_string<BYTE>& contents);
+		bool WriteFile(const std::string& filePath, const std::basic_string_view<BYTE> contents);
+		bool WriteFile(const std::string& filePath, const std::string_view contents);
+		MappedFile MapFile(const std::string& filePath);
+		bool SyncWrittenFiles();
+
+		/* Like WriteFile(), but leaves the file untouched, timestamp included, when it already holds exactly contents.
+		Only a file of the same size gets read back, and then compared by hash */
+		WriteResult WriteFileIfChanged(const std::string& filePath, const std::basic_string_view<BYTE> contents);
+	}
+}
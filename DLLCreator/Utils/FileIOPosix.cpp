@@ -0,0 +1,268 @@
+#ifndef _WIN32
+
+#include "FileIO.h"
+
+#include <algorithm> /* std::find, std::sort, std::unique */
+#include <cerrno> /* errno, EINTR */
+#include <climits> /* PATH_MAX */
+#include <cstdlib> /* realpath() */
+#include <filesystem> /* std::filesystem::path */
+
+/* POSIX specific includes */
+#include <fcntl.h> /* open() */
+#include <stdio.h> /* rename() */
+#include <sys/mman.h> /* mmap(), munmap(), madvise() */
+#include <sys/stat.h> /* fstat(), lstat(), fchmod() */
+#include <unistd.h> /* pread(), write(), close(), unlink(), fsync(), syncfs() */
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			/* Closes the file descriptor when going out of scope, so early returns don't leak it */
+			class FileDescriptor final
+			{
+			public:
+				explicit FileDescriptor(const int fd) : Fd{ fd } {}
+				~FileDescriptor() { if (Fd >= 0) { close(Fd); } }
+
+				FileDescriptor(const FileDescriptor&) = delete;
+				FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+				int Get() const { return Fd; }
+				bool IsValid() const { return Fd >= 0; }
+
+			private:
+				int Fd;
+			};
+
+			/* write may write less than asked, so keep going until everything is written */
+			bool WriteContents(const int fd, const std::basic_string_view<BYTE> contents)
+			{
+				size_t totalWritten{};
+				while (totalWritten < contents.size())
+				{
+					const ssize_t writtenBytes(write(fd, contents.data() + totalWritten, contents.size() - totalWritten));
+
+					if (writtenBytes < 0 && errno == EINTR)
+					{
+						continue;
+					}
+
+					if (writtenBytes < 0)
+					{
+						return false;
+					}
+
+					totalWritten += static_cast<size_t>(writtenBytes);
+				}
+
+				return true;
+			}
+
+			class PosixFileBackend final : public FileBackend
+			{
+			public:
+				bool ReadFile(const std::string& filePath, std::basic_string<BYTE>& contents) override
+				{
+					const FileDescriptor file(open(filePath.c_str(), O_RDONLY | O_CLOEXEC));
+
+					if (!file.IsValid())
+					{
+						return false;
+					}
+
+					struct stat fileStatus {};
+					if (fstat(file.Get(), &fileStatus) != 0)
+					{
+						return false;
+					}
+
+					contents.resize(static_cast<size_t>(fileStatus.st_size));
+
+					size_t totalRead{};
+					while (totalRead < contents.size())
+					{
+						const ssize_t readBytes(pread(file.Get(), contents.data() + totalRead, contents.size() - totalRead, static_cast<off_t>(totalRead)));
+
+						if (readBytes < 0 && errno == EINTR)
+						{
+							continue;
+						}
+
+						if (readBytes <= 0)
+						{
+							return false;
+						}
+
+						totalRead += static_cast<size_t>(readBytes);
+					}
+
+					return true;
+				}
+
+				bool WriteFile(const std::string& filePath, const std::basic_string_view<BYTE> contents) override
+				{
+					/* Renaming over a symlink would replace the link itself, so write to what it points to */
+					std::string targetPath(filePath);
+					struct stat linkStatus {};
+
+					if (lstat(filePath.c_str(), &linkStatus) == 0 && S_ISLNK(linkStatus.st_mode))
+					{
+						char resolvedPath[PATH_MAX]{};
+
+						if (realpath(filePath.c_str(), resolvedPath) == nullptr)
+						{
+							return false;
+						}
+
+						targetPath = resolvedPath;
+					}
+
+					/* The new file keeps the permissions of the one it replaces */
+					struct stat fileStatus {};
+					const bool bFileExists(stat(targetPath.c_str(), &fileStatus) == 0);
+					const mode_t mode(bFileExists ? fileStatus.st_mode & 07777 : 0644);
+
+					const std::string temporaryPath(GetTemporaryPath(targetPath));
+
+					{ /* Scope-lock the descriptor, the file has to be closed before it gets renamed */
+						const FileDescriptor file(open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode));
+
+						if (!file.IsValid())
+						{
+							return false;
+						}
+
+						/* open() applies the umask, the replaced file did not get it either */
+						if (!WriteContents(file.Get(), contents) || (bFileExists && fchmod(file.Get(), mode) != 0))
+						{
+							unlink(temporaryPath.c_str());
+							return false;
+						}
+					}
+
+					if (rename(temporaryPath.c_str(), targetPath.c_str()) != 0)
+					{
+						unlink(temporaryPath.c_str());
+						return false;
+					}
+
+					AddWrittenFile(targetPath);
+
+					return true;
+				}
+
+				bool SyncWrittenFiles() override
+				{
+					const std::vector<std::string> writtenFiles(TakeWrittenFiles());
+					bool bSynced(true);
+
+#ifdef __linux__
+					/* syncfs() flushes a whole file system, renames included, so one file per file system is enough */
+					std::vector<dev_t> syncedDevices{};
+
+					for (const std::string& filePath : writtenFiles)
+					{
+						struct stat fileStatus {};
+						if (stat(filePath.c_str(), &fileStatus) != 0)
+						{
+							bSynced = false;
+							continue;
+						}
+
+						if (std::find(syncedDevices.cbegin(), syncedDevices.cend(), fileStatus.st_dev) != syncedDevices.cend())
+						{
+							continue;
+						}
+
+						const FileDescriptor file(open(filePath.c_str(), O_RDONLY | O_CLOEXEC));
+						bSynced = file.IsValid() && syncfs(file.Get()) == 0 && bSynced;
+
+						syncedDevices.push_back(fileStatus.st_dev);
+					}
+#else
+					/* Every file, then every folder a file got renamed in */
+					std::vector<std::string> directories{};
+
+					for (const std::string& filePath : writtenFiles)
+					{
+						const FileDescriptor file(open(filePath.c_str(), O_RDONLY | O_CLOEXEC));
+						bSynced = file.IsValid() && fsync(file.Get()) == 0 && bSynced;
+
+						const std::string directory(std::filesystem::path(filePath).parent_path().string());
+						directories.push_back(directory.empty() ? "." : directory);
+					}
+
+					std::sort(directories.begin(), directories.end());
+					directories.erase(std::unique(directories.begin(), directories.end()), directories.end());
+
+					for (const std::string& directory : directories)
+					{
+						const FileDescriptor folder(open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+						bSynced = folder.IsValid() && fsync(folder.Get()) == 0 && bSynced;
+					}
+#endif
+
+					return bSynced;
+				}
+
+				MappedFile MapFile(const std::string& filePath) override
+				{
+					const FileDescriptor file(open(filePath.c_str(), O_RDONLY | O_CLOEXEC));
+
+					if (!file.IsValid())
+					{
+						return MappedFile{};
+					}
+
+					struct stat fileStatus {};
+					if (fstat(file.Get(), &fileStatus) != 0)
+					{
+						return MappedFile{};
+					}
+
+					const size_t fileSize(static_cast<size_t>(fileStatus.st_size));
+
+					/* mmap refuses empty mappings, but an empty file is still a valid file */
+					if (fileSize == 0)
+					{
+						return MappedFile(this, nullptr, 0, nullptr);
+					}
+
+					void* pMapping(mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file.Get(), 0));
+
+					if (pMapping == MAP_FAILED)
+					{
+						return MappedFile{};
+					}
+
+					/* Every caller scans the file front to back */
+					madvise(pMapping, fileSize, MADV_SEQUENTIAL);
+
+					/* The mapping keeps its own reference to the file, so the descriptor can be closed right away */
+					return MappedFile(this, static_cast<const BYTE*>(pMapping), fileSize, nullptr);
+				}
+
+			protected:
+				void UnmapFile(const BYTE* pData, const size_t size, void*) override
+				{
+					if (pData != nullptr && size > 0)
+					{
+						munmap(const_cast<BYTE*>(pData), size);
+					}
+				}
+			};
+		}
+
+		FileBackend& GetFileBackend()
+		{
+			static PosixFileBackend backend{};
+			return backend;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifdef _WIN32
+
+#include "FileIO.h"
+
+#include <algorithm> /* std::min */
+#include <limits> /* std::numeric_limits */
+
+/* Windows specific includes */
+#define WIN32_LEAN_AND_MEAN /* Exclude rarely-used stuff from Windows headers */
+#include <Windows.h> /* CreateFileA(), ReadFile(), WriteFile(), CreateFileMappingA(), MoveFileExA(), FlushFileBuffers() */
+
+#undef max
+#undef min
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			/* Closes the handle when going out of scope, so early returns don't leak it */
+			class FileHandle final
+			{
+			public:
+				explicit FileHandle(const HANDLE handle) : Handle{ handle } {}
+				~FileHandle() { if (Handle != INVALID_HANDLE_VALUE) { CloseHandle(Handle); } }
+
+				FileHandle(const FileHandle&) = delete;
+				FileHandle& operator=(const FileHandle&) = delete;
+
+				HANDLE Get() const { return Handle; }
+				bool IsValid() const { return Handle != INVALID_HANDLE_VALUE; }
+
+			private:
+				HANDLE Handle;
+			};
+
+			/* WriteFile() takes a DWORD size, so anything over 4 GiB goes in pieces */
+			bool WriteContents(const HANDLE file, const std::basic_string_view<BYTE> contents)
+			{
+				size_t totalWritten{};
+				while (totalWritten < contents.size())
+				{
+					const DWORD toWrite(static_cast<DWORD>(std::min<size_t>(contents.size() - totalWritten, std::numeric_limits<DWORD>::max())));
+
+					DWORD writtenBytes{};
+					if (::WriteFile(file, contents.data() + totalWritten, toWrite, &writtenBytes, nullptr) == 0)
+					{
+						return false;
+					}
+
+					totalWritten += writtenBytes;
+				}
+
+				return true;
+			}
+
+			class Win32FileBackend final : public FileBackend
+			{
+			public:
+				bool ReadFile(const std::string& filePath, std::basic_string<BYTE>& contents) override
+				{
+					const FileHandle file(CreateFileA(filePath.c_str(),
+						GENERIC_READ,
+						FILE_SHARE_READ,
+						nullptr,
+						OPEN_EXISTING,
+						FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+						nullptr));
+
+					if (!file.IsValid())
+					{
+						return false;
+					}
+
+					LARGE_INTEGER fileSize{};
+					if (GetFileSizeEx(file.Get(), &fileSize) == 0)
+					{
+						return false;
+					}
+
+					contents.resize(static_cast<size_t>(fileSize.QuadPart));
+
+					size_t totalRead{};
+					while (totalRead < contents.size())
+					{
+						const DWORD toRead(static_cast<DWORD>(std::min<size_t>(contents.size() - totalRead, std::numeric_limits<DWORD>::max())));
+
+						DWORD readBytes{};
+						if (::ReadFile(file.Get(), contents.data() + totalRead, toRead, &readBytes, nullptr) == 0 || readBytes == 0)
+						{
+							return false;
+						}
+
+						totalRead += readBytes;
+					}
+
+					return true;
+				}
+
+				bool WriteFile(const std::string& filePath, const std::basic_string_view<BYTE> contents) override
+				{
+					const std::string temporaryPath(GetTemporaryPath(filePath));
+
+					{ /* Scope-lock the handle, the file has to be closed before it gets renamed */
+						const FileHandle file(CreateFileA(temporaryPath.c_str(),
+							GENERIC_WRITE,
+							0,
+							nullptr,
+							CREATE_NEW,
+							FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+							nullptr));
+
+						if (!file.IsValid())
+						{
+							return false;
+						}
+
+						if (!WriteContents(file.Get(), contents))
+						{
+							DeleteFileA(temporaryPath.c_str());
+							return false;
+						}
+					}
+
+					if (MoveFileExA(temporaryPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING) == 0)
+					{
+						DeleteFileA(temporaryPath.c_str());
+						return false;
+					}
+
+					AddWrittenFile(filePath);
+
+					return true;
+				}
+
+				/* NTFS journals renames itself, so only the contents of the files need flushing */
+				bool SyncWrittenFiles() override
+				{
+					bool bSynced(true);
+
+					for (const std::string& filePath : TakeWrittenFiles())
+					{
+						const FileHandle file(CreateFileA(filePath.c_str(),
+							GENERIC_WRITE,
+							FILE_SHARE_READ | FILE_SHARE_WRITE,
+							nullptr,
+							OPEN_EXISTING,
+							FILE_ATTRIBUTE_NORMAL,
+							nullptr));
+
+						bSynced = file.IsValid() && FlushFileBuffers(file.Get()) != 0 && bSynced;
+					}
+
+					return bSynced;
+				}
+
+				MappedFile MapFile(const std::string& filePath) override
+				{
+					const FileHandle file(CreateFileA(filePath.c_str(),
+						GENERIC_READ,
+						FILE_SHARE_READ,
+						nullptr,
+						OPEN_EXISTING,
+						FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+						nullptr));
+
+					if (!file.IsValid())
+					{
+						return MappedFile{};
+					}
+
+					LARGE_INTEGER fileSize{};
+					if (GetFileSizeEx(file.Get(), &fileSize) == 0)
+					{
+						return MappedFile{};
+					}
+
+					/* CreateFileMappingA() refuses empty files, but an empty file is still a valid file */
+					if (fileSize.QuadPart == 0)
+					{
+						return MappedFile(this, nullptr, 0, nullptr);
+					}
+
+					const HANDLE mapping(CreateFileMappingA(file.Get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+
+					if (mapping == nullptr)
+					{
+						return MappedFile{};
+					}
+
+					const void* pView(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+					if (pView == nullptr)
+					{
+						CloseHandle(mapping);
+						return MappedFile{};
+					}
+
+					/* The view keeps its own reference to the file, so the file handle can be closed right away */
+					return MappedFile(this, static_cast<const BYTE*>(pView), static_cast<size_t>(fileSize.QuadPart), mapping);
+				}
+
+			protected:
+				void UnmapFile(const BYTE* pData, const size_t, void* pNativeHandle) override
+				{
+					if (pData != nullptr)
+					{
+						UnmapViewOfFile(pData);
+					}
+
+					if (pNativeHandle != nullptr)
+					{
+						CloseHandle(static_cast<HANDLE>(pNativeHandle));
+					}
+				}
+			};
+		}
+
+		FileBackend& GetFileBackend()
+		{
+			static Win32FileBackend backend{};
+			return backend;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,274 @@
+#include "FileIndex.h"
+
+#include "WorkStealingPool.h"
+
+#include <algorithm> /* std::sort, std::ranges::lower_bound */
+#include <functional> /* std::function */
+#include <system_error> /* std::error_code */
+
+namespace Utils
+{
+	namespace IO
+	{
+		bool FileIndex::Build(const std::filesystem::path& rootPath, const FileClassifier& classifier, const size_t nrOfThreads)
+		{
+			std::error_code errorCode{};
+
+			if (!std::filesystem::is_directory(rootPath, errorCode))
+			{
+				return false;
+			}
+
+			RootPath = rootPath;
+			Nodes.clear();
+			Names.clear();
+
+			/* Step 1: read every folder. Which thread reads which folder depends on timing,
+			but every listing ends up in the slot of the entry that owns it, so the tree they form does not */
+			Listing root{ rootPath, nullptr, {} };
+
+			if (nrOfThreads == 1)
+			{
+				std::vector<Listing*> toRead{ &root };
+
+				while (!toRead.empty())
+				{
+					Listing* const pListing(toRead.back());
+					toRead.pop_back();
+
+					ReadDirectory(*pListing, classifier);
+
+					for (Entry& entry : pListing->Entries)
+					{
+						if (entry.pListing)
+						{
+							toRead.push_back(entry.pListing.get());
+						}
+					}
+				}
+			}
+			else
+			{
+				WorkStealingPool threadPool(nrOfThreads);
+
+				/* Every folder is a job, its subfolders get submitted as soon as it has been read */
+				std::function<void(Listing&)> readTree{};
+				readTree = [&threadPool, &readTree, &classifier](Listing& listing)->void
+				{
+					ReadDirectory(listing, classifier);
+
+					for (Entry& entry : listing.Entries)
+					{
+						if (entry.pListing)
+						{
+							threadPool.Submit([&readTree, pListing = entry.pListing.get()]()
+								{
+									readTree(*pListing);
+								});
+						}
+					}
+				};
+
+				threadPool.Submit([&readTree, &root]()
+					{
+						readTree(root);
+					});
+
+				threadPool.Wait();
+			}
+
+			/* Step 2: lay the tree out breadth first, so the children of every folder end up next to each other */
+			std::vector<const Listing*> listings{ &root };
+
+			Nodes.push_back(Node{ 0, 0, 0, 0, 0, FileKind::Directory, true, false });
+
+			for (size_t current{}; current < Nodes.size(); ++current)
+			{
+				const Listing* const pListing(listings[current]);
+
+				if (!pListing)
+				{
+					continue;
+				}
+
+				Nodes[current].FirstChild = static_cast<uint32_t>(Nodes.size());
+				Nodes[current].NrOfChildren = static_cast<uint32_t>(pListing->Entries.size());
+
+				for (const Entry& entry : pListing->Entries)
+				{
+					Nodes.push_back(Node{ static_cast<uint32_t>(current), 0, 0, static_cast<uint32_t>(Names.size()), static_cast<uint32_t>(entry.Name.size()),
+						entry.Kind, entry.bIsDirectory, entry.bIsRegularFile });
+					listings.push_back(entry.pListing.get());
+
+					Names.append(entry.Name);
+				}
+			}
+
+			return true;
+		}
+
+		void FileIndex::ReadDirectory(Listing& listing, const FileClassifier& classifier)
+		{
+			std::error_code errorCode{};
+
+			for (std::filesystem::directory_iterator it(listing.Path, std::filesystem::directory_options::skip_permission_denied, errorCode);
+				!errorCode && it != std::filesystem::directory_iterator(); it.increment(errorCode))
+			{
+				/* The file type comes with the directory listing on most systems, so this rarely needs an extra stat */
+				std::error_code statusError{};
+				listing.Entries.push_back(Entry{ it->path().filename().string(), it->is_directory(statusError), it->is_regular_file(statusError), FileKind::None, nullptr });
+
+				Entry& entry(listing.Entries.back());
+				entry.Kind = classifier.Classify(entry.Name, entry.bIsDirectory);
+
+				if (!entry.bIsDirectory)
+				{
+					continue;
+				}
+
+				/* Excluded folders (.git, DLL_BUILD, DLL_CACHE, ...) keep their node and kind, but nothing in them is read */
+				if (classifier.IsExcluded(entry.Kind))
+				{
+					continue;
+				}
+
+				/* Symlinked folders pointing back up the tree would make the walk go on forever */
+				const std::filesystem::path path(listing.Path / entry.Name);
+				bool bExpand(true);
+
+				if (it->is_symlink(statusError))
+				{
+					for (const Listing* pParent(&listing); pParent; pParent = pParent->pParent)
+					{
+						std::error_code equivalentError{};
+
+						if (std::filesystem::equivalent(path, pParent->Path, equivalentError))
+						{
+							bExpand = false;
+							break;
+						}
+					}
+				}
+
+				if (bExpand)
+				{
+					entry.pListing = std::make_unique<Listing>(Listing{ path, &listing, {} });
+				}
+			}
+
+			std::sort(listing.Entries.begin(), listing.Entries.end(), [](const Entry& a, const Entry& b)->bool
+				{
+					return a.Name < b.Name;
+				});
+		}
+
+		std::string_view FileIndex::GetName(const size_t node) const
+		{
+			return std::string_view(Names).substr(Nodes[node].NameOffset, Nodes[node].NameSize);
+		}
+
+		std::filesystem::path FileIndex::GetPath(const size_t node) const
+		{
+			std::vector<size_t> parents{};
+
+			if (node != Root)
+			{
+				parents.push_back(node);
+				AppendParents(node, parents);
+			}
+
+			std::filesystem::path path(RootPath);
+
+			/* parents goes from node up to (but without) the root */
+			for (auto it(parents.crbegin()); it != parents.crend(); ++it)
+			{
+				path /= GetName(*it);
+			}
+
+			return path;
+		}
+
+		std::string FileIndex::GetRelativePath(const size_t node) const
+		{
+			std::vector<size_t> parents{};
+
+			if (node != Root)
+			{
+				parents.push_back(node);
+				AppendParents(node, parents);
+			}
+
+			std::string relativePath{};
+
+			for (auto it(parents.crbegin()); it != parents.crend(); ++it)
+			{
+				if (!relativePath.empty())
+				{
+					relativePath.push_back('/');
+				}
+
+				relativePath.append(GetName(*it));
+			}
+
+			return relativePath;
+		}
+
+		size_t FileIndex::Find(const std::string_view relativePath) const
+		{
+			if (Nodes.empty())
+			{
+				return NoNode;
+			}
+
+			size_t node(Root);
+			size_t componentBegin{};
+
+			while (componentBegin <= relativePath.size() && node != NoNode)
+			{
+				size_t componentEnd(relativePath.find_first_of("\\/", componentBegin));
+
+				if (componentEnd == std::string_view::npos)
+				{
+					componentEnd = relativePath.size();
+				}
+
+				const std::string_view component(relativePath.substr(componentBegin, componentEnd - componentBegin));
+
+				if (component == "..")
+				{
+					node = GetParent(node);
+				}
+				else if (!component.empty() && component != ".")
+				{
+					node = FindChild(node, component);
+				}
+
+				componentBegin = componentEnd + 1;
+			}
+
+			return node;
+		}
+
+		size_t FileIndex::FindChild(const size_t directory, const std::string_view name) const
+		{
+			const auto children(GetChildren(directory));
+
+			/* The children are sorted on name, so this is a binary search */
+			/* std::lower_bound() wants classic iterators, iota_view only has C++20 ones */
+			const auto cIt(std::ranges::lower_bound(children, name, std::ranges::less{}, [this](const size_t child)->std::string_view
+				{
+					return GetName(child);
+				}));
+
+			return cIt != children.end() && GetName(*cIt) == name ? *cIt : NoNode;
+		}
+
+		void FileIndex::AppendParents(const size_t node, std::vector<size_t>& parents) const
+		{
+			for (size_t parent(GetParent(node)); parent != Root && parent != NoNode; parent = GetParent(parent))
+			{
+				parents.push_back(parent);
+			}
+		}
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint> /* uint32_t */
+#include <filesystem> /* std::filesystem */
+#include <memory> /* std::unique_ptr */
+#include <ranges> /* std::views::iota */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+
+#include "FileClassifier.h"
+
+namespace Utils
+{
+	namespace IO
+	{
+		/* Every file and folder below a root, gathered in a single walk so nothing has to touch the file system again.
+		Nodes are stored breadth first in one flat array, the children of a folder are contiguous and sorted on name */
+		class FileIndex final
+		{
+		public:
+			struct Node final
+			{
+				uint32_t Parent;
+				uint32_t FirstChild;
+				uint32_t NrOfChildren;
+				uint32_t NameOffset; /* into Names */
+				uint32_t NameSize;
+				FileKind Kind; /* worked out once while walking */
+				bool bIsDirectory;
+				bool bIsRegularFile;
+			};
+
+			inline constexpr static size_t Root{ 0 };
+			inline constexpr static size_t NoNode{ static_cast<size_t>(-1) };
+
+			/* Walks everything below rootPath. Folders that can not be read, and folders classifier excludes, show up without children.
+			Symlinked folders are walked as well, unless they point back to one of their own parents.
+			Every entry is classified by classifier once, the kinds are cached in the nodes.
+			With more than 1 thread (0 means one per hardware thread) folders are read in parallel,
+			the resulting index is the same no matter how many threads were used.
+			Returns false if rootPath is not a folder */
+			bool Build(const std::filesystem::path& rootPath, const FileClassifier& classifier, const size_t nrOfThreads = 1);
+
+			size_t GetNumberOfNodes() const { return Nodes.size(); }
+			const Node& GetNode(const size_t node) const { return Nodes[node]; }
+
+			std::string_view GetName(const size_t node) const;
+			FileKind GetKind(const size_t node) const { return Nodes[node].Kind; }
+			bool HasAnyKind(const size_t node, const FileKind mask) const { return IO::HasAnyKind(Nodes[node].Kind, mask); }
+			bool IsDirectory(const size_t node) const { return Nodes[node].bIsDirectory; }
+			bool IsRegularFile(const size_t node) const { return Nodes[node].bIsRegularFile; }
+			size_t GetParent(const size_t node) const { return node == Root ? NoNode : Nodes[node].Parent; }
+
+			/* The node indices of the children of node, sorted on name */
+			auto GetChildren(const size_t node) const
+			{
+				return std::views::iota(static_cast<size_t>(Nodes[node].FirstChild), static_cast<size_t>(Nodes[node].FirstChild) + Nodes[node].NrOfChildren);
+			}
+
+			const std::filesystem::path& GetRootPath() const { return RootPath; }
+
+			/* The root path with the names of every parent appended */
+			std::filesystem::path GetPath(const size_t node) const;
+
+			/* '/' separated and relative to the root, empty for the root itself */
+			std::string GetRelativePath(const size_t node) const;
+
+			/* relativePath may use either separator. Returns NoNode if nothing in the index has that path */
+			size_t Find(const std::string_view relativePath) const;
+
+			/* Returns the child of directory called name, or NoNode */
+			size_t FindChild(const size_t directory, const std::string_view name) const;
+
+		private:
+			struct Listing;
+
+			/* A folder entry as read from disk, before it gets a place in Nodes */
+			struct Entry final
+			{
+				std::string Name;
+				bool bIsDirectory;
+				bool bIsRegularFile;
+				FileKind Kind;
+				std::unique_ptr<Listing> pListing; /* only set for folders that should be walked */
+			};
+
+			struct Listing final
+			{
+				std::filesystem::path Path;
+				const Listing* pParent;
+				std::vector<Entry> Entries; /* sorted on name */
+			};
+
+			/* Fills listing.Entries and makes an empty listing for every subfolder that should be walked.
+			Only touches listing, so different folders can be read at the same time */
+			static void ReadDirectory(Listing& listing, const FileClassifier& classifier);
+
+			void AppendParents(const size_t node, std::vector<size_t>& parents) const;
+
+			std::filesystem::path RootPath{};
+			std::vector<Node> Nodes{};
+			std::string Names{};
+		};
+	}
+}
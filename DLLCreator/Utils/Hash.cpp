@@ -0,0 +1,152 @@
+#include "Hash.h"
+
+#include <bit> /* std::rotl */
+#include <cstring> /* std::memcpy */
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			constexpr uint64_t Prime1{ 11400714785074694791ULL };
+			constexpr uint64_t Prime2{ 14029467366897019727ULL };
+			constexpr uint64_t Prime3{ 1609587929392839161ULL };
+			constexpr uint64_t Prime4{ 9650029242287828579ULL };
+			constexpr uint64_t Prime5{ 2870177450012600261ULL };
+
+			/* XXH64 is defined on little endian words, which is what every platform this builds for uses */
+			uint64_t Read64(const BYTE* pData)
+			{
+				uint64_t value;
+				std::memcpy(&value, pData, sizeof(value));
+				return value;
+			}
+
+			uint32_t Read32(const BYTE* pData)
+			{
+				uint32_t value;
+				std::memcpy(&value, pData, sizeof(value));
+				return value;
+			}
+
+			uint64_t Round(uint64_t accumulator, const uint64_t input)
+			{
+				accumulator += input * Prime2;
+				accumulator = std::rotl(accumulator, 31);
+				return accumulator * Prime1;
+			}
+
+			uint64_t MergeRound(uint64_t accumulator, const uint64_t value)
+			{
+				accumulator ^= Round(0, value);
+				return accumulator * Prime1 + Prime4;
+			}
+		}
+
+		Hasher::Hasher(const uint64_t seed)
+			: Accumulators{ seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1 }
+			, Seed{ seed }
+		{}
+
+		void Hasher::Update(const BYTE* pData, size_t size)
+		{
+			TotalSize += size;
+
+			/* Top up a partial stripe first */
+			if (BufferSize > 0)
+			{
+				const size_t toCopy(size < sizeof(Buffer) - BufferSize ? size : sizeof(Buffer) - BufferSize);
+				std::memcpy(Buffer + BufferSize, pData, toCopy);
+
+				BufferSize += toCopy;
+				pData += toCopy;
+				size -= toCopy;
+
+				if (BufferSize < sizeof(Buffer))
+				{
+					return;
+				}
+
+				ConsumeStripe(Buffer);
+				BufferSize = 0;
+			}
+
+			for (; size >= sizeof(Buffer); pData += sizeof(Buffer), size -= sizeof(Buffer))
+			{
+				ConsumeStripe(pData);
+			}
+
+			if (size > 0)
+			{
+				std::memcpy(Buffer, pData, size);
+				BufferSize = size;
+			}
+		}
+
+		uint64_t Hasher::Digest() const
+		{
+			uint64_t hash{};
+
+			if (TotalSize >= sizeof(Buffer))
+			{
+				hash = std::rotl(Accumulators[0], 1) + std::rotl(Accumulators[1], 7) + std::rotl(Accumulators[2], 12) + std::rotl(Accumulators[3], 18);
+
+				for (const uint64_t accumulator : Accumulators)
+				{
+					hash = MergeRound(hash, accumulator);
+				}
+			}
+			else
+			{
+				hash = Seed + Prime5;
+			}
+
+			hash += TotalSize;
+
+			size_t i{};
+			for (; i + 8 <= BufferSize; i += 8)
+			{
+				hash ^= Round(0, Read64(Buffer + i));
+				hash = std::rotl(hash, 27) * Prime1 + Prime4;
+			}
+
+			if (i + 4 <= BufferSize)
+			{
+				hash ^= static_cast<uint64_t>(Read32(Buffer + i)) * Prime1;
+				hash = std::rotl(hash, 23) * Prime2 + Prime3;
+				i += 4;
+			}
+
+			for (; i < BufferSize; ++i)
+			{
+				hash ^= Buffer[i] * Prime5;
+				hash = std::rotl(hash, 11) * Prime1;
+			}
+
+			/* Avalanche, so every input bit affects every output bit */
+			hash ^= hash >> 33;
+			hash *= Prime2;
+			hash ^= hash >> 29;
+			hash *= Prime3;
+			hash ^= hash >> 32;
+
+			return hash;
+		}
+
+		void Hasher::ConsumeStripe(const BYTE* pStripe)
+		{
+			for (size_t i{}; i < 4; ++i)
+			{
+				Accumulators[i] = Round(Accumulators[i], Read64(pStripe + i * 8));
+			}
+		}
+
+		uint64_t Hash(const std::basic_string_view<BYTE> data, const uint64_t seed)
+		{
+			Hasher hasher(seed);
+			hasher.Update(data);
+			return hasher.Digest();
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Utils.h" /* BYTE */
+
+#include <cstdint> /* uint64_t */
+#include <string_view> /* std::basic_string_view */
+
+namespace Utils
+{
+	namespace IO
+	{
+		/* XXH64, a fast non-cryptographic hash. Good for telling files apart, not for anything an attacker controls.
+		Data can be fed in any number of pieces, the result is the same as hashing it in one go */
+		class Hasher final
+		{
+		public:
+			explicit Hasher(const uint64_t seed = 0);
+
+			void Update(const BYTE* pData, size_t size);
+			void Update(const std::basic_string_view<BYTE> data) { Update(data.data(), data.size()); }
+
+			uint64_t Digest() const;
+
+		private:
+			void ConsumeStripe(const BYTE* pStripe);
+
+			uint64_t Accumulators[4];
+			uint64_t Seed;
+			uint64_t TotalSize{};
+			BYTE Buffer[32]{}; /* the tail that does not fill a 32 byte stripe yet */
+			size_t BufferSize{};
+		};
+
+		uint64_t Hash(const std::basic_string_view<BYTE> data, const uint64_t seed = 0);
+	}
+}
@@ -0,0 +1,940 @@
+#include "HeaderParser.h"
+#include "ByteSearch.h" /* IO::FindByte, IO::FindSubstring */
+
+#include <algorithm> /* std::count_if, std::is_sorted, std::binary_search */
+#include <array> /* std::array */
+
+namespace Utils
+{
+	namespace Cpp
+	{
+		namespace
+		{
+			enum class TokenType : uint8_t
+			{
+				Identifier = 0, /* keywords included */
+				Number = 1,
+				Literal = 2, /* strings and characters */
+				Punctuation = 3 /* one character, except for "::" */
+			};
+
+			struct Token final
+			{
+				TokenType Type;
+				size_t Begin;
+				size_t End;
+			};
+
+			constexpr bool IsIdentifierStart(const unsigned char c)
+			{
+				/* Bytes of UTF-8 sequences are allowed in identifiers */
+				return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c >= 0x80;
+			}
+
+			constexpr bool IsDigit(const unsigned char c)
+			{
+				return c >= '0' && c <= '9';
+			}
+
+			constexpr bool IsIdentifierCharacter(const unsigned char c)
+			{
+				return IsIdentifierStart(c) || IsDigit(c);
+			}
+
+			constexpr bool IsSpace(const unsigned char c)
+			{
+				return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+			}
+
+			/* Splits text into tokens, everything that does not matter for declarations (whitespace, comments, preprocessor lines) is skipped */
+			class Lexer final
+			{
+			public:
+				explicit Lexer(const std::string_view text)
+					: Text{ text }
+				{}
+
+				/* Returns false once the end of the text has been reached */
+				bool Next(Token& token)
+				{
+					SkipTrivia();
+
+					if (Position >= Text.size())
+					{
+						return false;
+					}
+
+					bIsAtLineStart = false;
+
+					const size_t begin(Position);
+					const unsigned char c(Text[Position]);
+
+					if (IsIdentifierStart(c))
+					{
+						while (Position < Text.size() && IsIdentifierCharacter(Text[Position]))
+						{
+							++Position;
+						}
+
+						/* String prefixes: L"", u8"", R"()", u8R"()" and so on */
+						if (Position < Text.size() && (Text[Position] == '"' || Text[Position] == '\''))
+						{
+							const std::string_view prefix(Text.substr(begin, Position - begin));
+
+							if (Text[Position] == '"' && prefix.back() == 'R' && (prefix == "R" || prefix == "LR" || prefix == "uR" || prefix == "UR" || prefix == "u8R"))
+							{
+								SkipRawString();
+								token = Token{ TokenType::Literal, begin, Position };
+								return true;
+							}
+							else if (prefix == "L" || prefix == "u" || prefix == "U" || prefix == "u8")
+							{
+								SkipQuoted(Text[Position]);
+								token = Token{ TokenType::Literal, begin, Position };
+								return true;
+							}
+						}
+
+						token = Token{ TokenType::Identifier, begin, Position };
+					}
+					else if (IsDigit(c) || (c == '.' && Position + 1 < Text.size() && IsDigit(Text[Position + 1])))
+					{
+						/* pp-numbers, which covers hex, exponents, suffixes and digit separators (1'000) */
+						while (Position < Text.size())
+						{
+							const unsigned char n(Text[Position]);
+
+							if ((n == '+' || n == '-') && (Text[Position - 1] == 'e' || Text[Position - 1] == 'E' || Text[Position - 1] == 'p' || Text[Position - 1] == 'P'))
+							{
+								++Position;
+							}
+							else if (IsIdentifierCharacter(n) || n == '.' || n == '\'')
+							{
+								++Position;
+							}
+							else
+							{
+								break;
+							}
+						}
+
+						token = Token{ TokenType::Number, begin, Position };
+					}
+					else if (c == '"' || c == '\'')
+					{
+						SkipQuoted(c);
+						token = Token{ TokenType::Literal, begin, Position };
+					}
+					else if (c == ':' && Position + 1 < Text.size() && Text[Position + 1] == ':')
+					{
+						Position += 2;
+						token = Token{ TokenType::Punctuation, begin, Position };
+					}
+					else
+					{
+						++Position;
+						token = Token{ TokenType::Punctuation, begin, Position };
+					}
+
+					return true;
+				}
+
+			private:
+				void SkipTrivia()
+				{
+					while (Position < Text.size())
+					{
+						const unsigned char c(Text[Position]);
+
+						if (c == '\n')
+						{
+							bIsAtLineStart = true;
+							++Position;
+						}
+						else if (IsSpace(c))
+						{
+							++Position;
+						}
+						else if (c == '/' && Position + 1 < Text.size() && Text[Position + 1] == '/')
+						{
+							SkipLine(false);
+						}
+						else if (c == '/' && Position + 1 < Text.size() && Text[Position + 1] == '*')
+						{
+							const size_t begin(Position);
+							SkipBlockComment();
+
+							/* The next line starts inside of the comment, so a directive can follow it */
+							bIsAtLineStart = bIsAtLineStart || Text.substr(begin, Position - begin).find('\n') != std::string_view::npos;
+						}
+						else if (c == '#' && bIsAtLineStart)
+						{
+							SkipLine(true);
+						}
+						else if (c == '\\' && (Text.substr(Position, 2) == "\\\n" || Text.substr(Position, 3) == "\\\r\n"))
+						{
+							/* A line continuation outside of a directive joins two lines, which is the same as whitespace here */
+							Position += Text[Position + 1] == '\n' ? 2 : 3;
+						}
+						else
+						{
+							break;
+						}
+					}
+				}
+
+				/* Skips to the end of the line, following line continuations. In a directive block comments and strings
+				are skipped as a whole, so a newline inside a comment or a "//" inside a string does not end it early */
+				void SkipLine(const bool bIsDirective)
+				{
+					/* Outside of a directive only the newlines matter, so jump from one to the next until one is not continued */
+					while (!bIsDirective && Position < Text.size())
+					{
+						const size_t newLine(IO::FindByte(Text, '\n', Position));
+
+						if (newLine == IO::NotFound)
+						{
+							Position = Text.size();
+							return;
+						}
+
+						const size_t backslash(newLine > 0 && Text[newLine - 1] == '\r' ? newLine - 2 : newLine - 1);
+
+						if (newLine == 0 || backslash == IO::NotFound || backslash < Position || Text[backslash] != '\\')
+						{
+							Position = newLine;
+							return;
+						}
+
+						Position = newLine + 1;
+					}
+
+					while (Position < Text.size())
+					{
+						const unsigned char c(Text[Position]);
+
+						if (c == '\n')
+						{
+							return;
+						}
+						else if (c == '\\' && Position + 1 < Text.size() && (Text[Position + 1] == '\n' || Text[Position + 1] == '\r'))
+						{
+							Position += Text[Position + 1] == '\r' && Position + 2 < Text.size() && Text[Position + 2] == '\n' ? 3 : 2;
+						}
+						else if (bIsDirective && c == '/' && Position + 1 < Text.size() && Text[Position + 1] == '*')
+						{
+							SkipBlockComment();
+						}
+						else if (bIsDirective && (c == '"' || c == '\''))
+						{
+							SkipQuoted(c);
+						}
+						else
+						{
+							++Position;
+						}
+					}
+				}
+
+				void SkipBlockComment()
+				{
+					const size_t end(IO::FindSubstring(Text, "*/", Position + 2));
+					Position = end == std::string_view::npos ? Text.size() : end + 2;
+				}
+
+				/* Position is on the opening quote. Stops at the end of the line for unterminated literals,
+				which also keeps an apostrophe in a directive (#error don't) from eating the rest of the file */
+				void SkipQuoted(const char quote)
+				{
+					++Position;
+
+					while (Position < Text.size() && Text[Position] != quote && Text[Position] != '\n')
+					{
+						Position += Text[Position] == '\\' && Position + 1 < Text.size() ? 2 : 1;
+					}
+
+					if (Position < Text.size() && Text[Position] == quote)
+					{
+						++Position;
+					}
+				}
+
+				/* Position is on the opening quote of R"delimiter( ... )delimiter" */
+				void SkipRawString()
+				{
+					const size_t delimiterBegin(Position + 1);
+					const size_t open(Text.find('(', delimiterBegin));
+
+					if (open == std::string_view::npos)
+					{
+						Position = Text.size();
+						return;
+					}
+
+					const std::string_view delimiter(Text.substr(delimiterBegin, open - delimiterBegin));
+
+					for (size_t close(Text.find(')', open + 1)); close != std::string_view::npos; close = Text.find(')', close + 1))
+					{
+						if (Text.substr(close + 1, delimiter.size()) == delimiter && close + 1 + delimiter.size() < Text.size() && Text[close + 1 + delimiter.size()] == '"')
+						{
+							Position = close + delimiter.size() + 2;
+							return;
+						}
+					}
+
+					Position = Text.size();
+				}
+
+				std::string_view Text;
+				size_t Position{};
+				bool bIsAtLineStart{ true };
+			};
+
+			enum class ScopeType : uint8_t
+			{
+				Namespace = 0, /* also extern "C" { } */
+				Class = 1
+			};
+
+			struct Scope final
+			{
+				ScopeType Type;
+				std::string_view ClassName;
+				Specifier Specifiers; /* passed on to everything declared inside: Template or Internal */
+			};
+
+			enum class StatementType : uint8_t
+			{
+				Other = 0,
+				Namespace = 1,
+				Class = 2,
+				Function = 3
+			};
+
+			class Parser final
+			{
+			public:
+				Parser(const std::string_view text, std::vector<Declaration>& declarations)
+					: Text{ text }
+					, TextLexer{ text }
+					, Declarations{ declarations }
+				{}
+
+				void Parse()
+				{
+					Token token{};
+
+					while (TextLexer.Next(token))
+					{
+						if (bIsInTail)
+						{
+							ParseTail(token);
+						}
+						else
+						{
+							ParseStatement(token);
+						}
+					}
+				}
+
+			private:
+				std::string_view GetText(const Token& token) const
+				{
+					return Text.substr(token.Begin, token.End - token.Begin);
+				}
+
+				bool Is(const Token& token, const std::string_view text) const
+				{
+					return GetText(token) == text;
+				}
+
+				Specifier GetScopeSpecifiers() const
+				{
+					Specifier specifiers(Specifier::None);
+
+					for (const Scope& scope : Scopes)
+					{
+						specifiers = specifiers | scope.Specifiers;
+					}
+
+					return specifiers;
+				}
+
+				uint32_t GetClassDepth() const
+				{
+					return static_cast<uint32_t>(std::count_if(Scopes.cbegin(), Scopes.cend(), [](const Scope& scope)->bool
+						{
+							return scope.Type == ScopeType::Class;
+						}));
+				}
+
+				/* Collects the tokens of one declaration, up to its ';' or '{' */
+				void ParseStatement(const Token& token)
+				{
+					if (token.Type == TokenType::Punctuation)
+					{
+						switch (Text[token.Begin])
+						{
+						case '(':
+						case '[':
+							++Nesting;
+							break;
+						case ')':
+						case ']':
+							Nesting -= Nesting > 0 ? 1 : 0;
+							break;
+						case '{':
+							/* A lambda or braced initializer inside of parentheses, or a member initializer: Engine() : Value{ 0 } { } */
+							if (Nesting > 0 || (bIsInInitializerList && !Statement.empty() && (Statement.back().Type == TokenType::Identifier || Is(Statement.back(), ">"))))
+							{
+								++Nesting;
+								break;
+							}
+
+							OpenBrace();
+							return;
+						case '}':
+							if (Nesting > 0)
+							{
+								--Nesting;
+								break;
+							}
+
+							/* A declaration without a ';' before the end of the scope is not one worth finding */
+							Statement.clear();
+							bIsInInitializerList = false;
+							CloseBrace();
+							return;
+						case ';':
+							if (Nesting == 0)
+							{
+								AnalyzeStatement(false);
+								Statement.clear();
+								bIsInInitializerList = false;
+								return;
+							}
+							break;
+						case ':':
+							/* public:, private: and protected: are not part of the next declaration */
+							if (Nesting == 0 && !Scopes.empty() && Scopes.back().Type == ScopeType::Class && !Statement.empty() && IsAccessSpecifier(Statement.back()))
+							{
+								Statement.clear();
+								bIsInInitializerList = false;
+								return;
+							}
+
+							/* The ':' of a constructor's member initializers comes right after its parameters */
+							bIsInInitializerList = bIsInInitializerList || (Nesting == 0 && !Statement.empty() && (Is(Statement.back(), ")") || Is(Statement.back(), "noexcept")));
+							break;
+						}
+					}
+
+					Statement.push_back(token);
+				}
+
+				/* After the body of a class, enum or initializer, everything up to the ';' belongs to the same declaration */
+				void ParseTail(const Token& token)
+				{
+					if (token.Type != TokenType::Punctuation)
+					{
+						return;
+					}
+
+					switch (Text[token.Begin])
+					{
+					case '(':
+					case '[':
+					case '{':
+						++Nesting;
+						break;
+					case ')':
+					case ']':
+						Nesting -= Nesting > 0 ? 1 : 0;
+						break;
+					case '}':
+						if (Nesting > 0)
+						{
+							--Nesting;
+							break;
+						}
+
+						bIsInTail = false;
+						CloseBrace();
+						break;
+					case ';':
+						if (Nesting == 0)
+						{
+							bIsInTail = false;
+						}
+						break;
+					}
+				}
+
+				void OpenBrace()
+				{
+					const StatementType type(AnalyzeStatement(true));
+					const std::string_view className(ClassName);
+
+					const bool bIsEmpty(Statement.empty());
+					const bool bIsFunctionBody(HasParameters());
+					Statement.clear();
+					bIsInInitializerList = false;
+
+					const Specifier inheritedSpecifiers(StatementSpecifiers & (Specifier::Template | Specifier::Internal));
+
+					switch (type)
+					{
+					case StatementType::Namespace:
+						Scopes.push_back(Scope{ ScopeType::Namespace, {}, inheritedSpecifiers });
+						break;
+					case StatementType::Class:
+						Scopes.push_back(Scope{ ScopeType::Class, className, inheritedSpecifiers });
+						break;
+					case StatementType::Function:
+						SkipBody();
+						break;
+					case StatementType::Other:
+						SkipBody();
+						/* enum E { } e;, int i{ 0 }; and so on. void A::f() { } and other bodies not reported end at their '}' */
+						bIsInTail = !bIsEmpty && !bIsFunctionBody;
+						break;
+					}
+				}
+
+				void CloseBrace()
+				{
+					if (Scopes.empty())
+					{
+						/* Unbalanced, most likely because of a macro */
+						return;
+					}
+
+					const ScopeType type(Scopes.back().Type);
+					Scopes.pop_back();
+
+					/* class A { } a;, but namespace A { } is not followed by anything */
+					bIsInTail = type == ScopeType::Class;
+				}
+
+				/* Skips everything up to and including the '}' that matches the '{' just read */
+				void SkipBody()
+				{
+					Token token{};
+					size_t depth{ 1 };
+
+					while (depth > 0 && TextLexer.Next(token))
+					{
+						if (token.Type == TokenType::Punctuation)
+						{
+							if (Text[token.Begin] == '{')
+							{
+								++depth;
+							}
+							else if (Text[token.Begin] == '}')
+							{
+								--depth;
+							}
+						}
+					}
+
+					Nesting = 0;
+				}
+
+				bool IsAccessSpecifier(const Token& token) const
+				{
+					const std::string_view text(GetText(token));
+					return text == "public" || text == "private" || text == "protected" || text == "signals" || text == "slots" || text == "Q_SIGNALS" || text == "Q_SLOTS";
+				}
+
+				/* Keywords that can be followed by parentheses in a declaration without being the name of a function:
+				specifiers like decltype(...) and types like the void in void (*pFunction)() */
+				bool IsNeverAName(const Token& token) const
+				{
+					/* Sorted, so this is a binary search */
+					constexpr std::array<std::string_view, 31> keywords{ "_Alignas", "__attribute__", "__declspec", "__pragma", "alignas", "alignof", "auto", "bool", "char",
+						"char16_t", "char32_t", "char8_t", "const", "constexpr", "decltype", "double", "explicit", "float", "inline", "int", "long", "noexcept",
+						"requires", "short", "signed", "sizeof", "static", "throw", "unsigned", "void", "volatile" };
+					static_assert(std::is_sorted(keywords.cbegin(), keywords.cend()), "HeaderParser > keywords must be sorted");
+
+					return std::binary_search(keywords.cbegin(), keywords.cend(), GetText(token));
+				}
+
+				/* Returns the index of the token that closes the bracket at Statement[open], or Statement.size() */
+				size_t FindClosing(const size_t open) const
+				{
+					const char opening(Text[Statement[open].Begin]);
+					const char closing(opening == '(' ? ')' : (opening == '[' ? ']' : '}'));
+
+					size_t depth{};
+
+					for (size_t i(open); i < Statement.size(); ++i)
+					{
+						if (Statement[i].Type != TokenType::Punctuation)
+						{
+							continue;
+						}
+
+						if (Text[Statement[i].Begin] == opening)
+						{
+							++depth;
+						}
+						else if (Text[Statement[i].Begin] == closing && --depth == 0)
+						{
+							return i;
+						}
+					}
+
+					return Statement.size();
+				}
+
+				/* Returns the index of the '>' that closes the '<' at Statement[open], or Statement.size().
+				Brackets are skipped as a whole, so template<int N = (1 > 0)> works */
+				size_t FindClosingAngle(const size_t open) const
+				{
+					size_t depth{};
+
+					for (size_t i(open); i < Statement.size(); ++i)
+					{
+						if (Is(Statement[i], "(") || Is(Statement[i], "["))
+						{
+							i = FindClosing(i);
+						}
+						else if (Is(Statement[i], "<"))
+						{
+							++depth;
+						}
+						else if (Is(Statement[i], ">") && --depth == 0)
+						{
+							return i;
+						}
+					}
+
+					return Statement.size();
+				}
+
+				/* Whether the statement has a parameter list outside of an initializer: void A::f() and Engine::Engine() : Value{ 0 },
+				but not int i = Get() or auto f = [](int) */
+				bool HasParameters() const
+				{
+					size_t angleDepth{};
+					bool bHasParameters{};
+
+					for (size_t i{}; i < Statement.size(); ++i)
+					{
+						const Token& token(Statement[i]);
+
+						if (token.Type != TokenType::Punctuation)
+						{
+							continue;
+						}
+
+						const char c(Text[token.Begin]);
+
+						if (c == '<' && i > 0 && (Statement[i - 1].Type == TokenType::Identifier || Is(Statement[i - 1], ">")))
+						{
+							++angleDepth;
+						}
+						else if (c == '>' && angleDepth > 0)
+						{
+							--angleDepth;
+						}
+						else if (Is(token, "=") && angleDepth == 0 && !bHasParameters && (i == 0 || !Is(Statement[i - 1], "operator")))
+						{
+							return false;
+						}
+						else if (c == '(' || c == '[' || c == '{')
+						{
+							bHasParameters = bHasParameters || (c == '(' && angleDepth == 0);
+							i = FindClosing(i);
+						}
+					}
+
+					return bHasParameters;
+				}
+
+				StatementType AnalyzeStatement(const bool bHasBody)
+				{
+					size_t first{};
+					StatementSpecifiers = GetScopeSpecifiers();
+
+					/* Leading [[attributes]] have to stay in front of anything that gets inserted */
+					while (first + 1 < Statement.size() && Is(Statement[first], "[") && Is(Statement[first + 1], "["))
+					{
+						first = FindClosing(first) + 1;
+					}
+
+					/* template<class T> is followed by an ordinary declaration, template<class T> template<class U> by another template head */
+					while (first + 1 < Statement.size() && Is(Statement[first], "template") && Is(Statement[first + 1], "<"))
+					{
+						first = FindClosingAngle(first + 1) + 1;
+						StatementSpecifiers = StatementSpecifiers | Specifier::Template;
+					}
+
+					if (first >= Statement.size())
+					{
+						return StatementType::Other;
+					}
+
+					const Token& firstToken(Statement[first]);
+
+					if (Is(firstToken, "namespace") || (Is(firstToken, "inline") && first + 1 < Statement.size() && Is(Statement[first + 1], "namespace")))
+					{
+						/* namespace { */
+						if (Is(Statement.back(), "namespace"))
+						{
+							StatementSpecifiers = StatementSpecifiers | Specifier::Internal;
+						}
+
+						return bHasBody ? StatementType::Namespace : StatementType::Other;
+					}
+
+					if (Is(firstToken, "extern") && first + 1 < Statement.size() && Statement[first + 1].Type == TokenType::Literal && bHasBody && Statement.size() == first + 2)
+					{
+						return StatementType::Namespace;
+					}
+
+					/* An explicit instantiation (template class A<int>;), everything else here does not declare anything exportable */
+					if (Is(firstToken, "template") || Is(firstToken, "typedef") || Is(firstToken, "using") || Is(firstToken, "friend") ||
+						Is(firstToken, "static_assert") || Is(firstToken, "enum") || Is(firstToken, "union") || Is(firstToken, "concept") || Is(firstToken, "return"))
+					{
+						return StatementType::Other;
+					}
+
+					if (bHasBody && (Is(firstToken, "class") || Is(firstToken, "struct")) && AnalyzeClass(first))
+					{
+						return StatementType::Class;
+					}
+
+					/* extern "C" void Function(); the linkage has to stay in front */
+					if (Is(firstToken, "extern") && first + 2 < Statement.size() && Statement[first + 1].Type == TokenType::Literal)
+					{
+						first += 2;
+					}
+
+					return AnalyzeFunction(first, bHasBody) ? StatementType::Function : StatementType::Other;
+				}
+
+				/* class Name final : public Base {, Statement[first] is the class key */
+				bool AnalyzeClass(const size_t first)
+				{
+					size_t name(Statement.size());
+
+					for (size_t i(first + 1); i < Statement.size(); ++i)
+					{
+						const Token& token(Statement[i]);
+
+						if (Is(token, ":"))
+						{
+							break;
+						}
+						else if (Is(token, "(") || Is(token, "["))
+						{
+							/* alignas(16), __declspec(...), [[deprecated]] */
+							i = FindClosing(i);
+						}
+						else if (token.Type == TokenType::Identifier && !Is(token, "final") && !IsNeverAName(token))
+						{
+							name = i;
+						}
+						else if (token.Type != TokenType::Identifier && !Is(token, "::"))
+						{
+							/* struct Point* Make() { is a function returning a pointer, not a class */
+							return false;
+						}
+					}
+
+					if (name == Statement.size())
+					{
+						/* Anonymous structs are not worth exporting */
+						return false;
+					}
+
+					ClassName = GetText(Statement[name]);
+
+					Declarations.push_back(Declaration{ Is(Statement[first], "class") ? DeclarationType::Class : DeclarationType::Struct,
+						Statement[first].Begin, Statement.back().End, Statement[name].Begin, Statement[name].End, Statement[first].End, GetClassDepth(), true, StatementSpecifiers });
+
+					return true;
+				}
+
+				bool AnalyzeFunction(const size_t first, const bool bHasBody)
+				{
+					size_t angleDepth{};
+					size_t nameBegin(Statement.size());
+					size_t parameters(Statement.size());
+
+					for (size_t i(first); i < Statement.size(); ++i)
+					{
+						const Token& token(Statement[i]);
+
+						if (Is(token, "template"))
+						{
+							/* Behind a macro (EXPORT template<class T> void F();) it is still a template */
+							return false;
+						}
+
+						if (token.Type != TokenType::Punctuation && !Is(token, "operator"))
+						{
+							continue;
+						}
+
+						if (Is(token, "operator"))
+						{
+							/* The name runs up to the parameters: operator+, operator new[], operator() and conversion operators */
+							nameBegin = i;
+
+							size_t j(i + 1);
+
+							if (j + 1 < Statement.size() && Is(Statement[j], "(") && Is(Statement[j + 1], ")"))
+							{
+								j += 2;
+							}
+
+							while (j < Statement.size() && !Is(Statement[j], "("))
+							{
+								++j;
+							}
+
+							parameters = j;
+							break;
+						}
+
+						const char c(Text[token.Begin]);
+
+						if (c == '<' && i > first && (Statement[i - 1].Type == TokenType::Identifier || Is(Statement[i - 1], ">")))
+						{
+							++angleDepth;
+						}
+						else if (c == '>' && angleDepth > 0)
+						{
+							--angleDepth;
+						}
+						else if (c == '=' && angleDepth == 0)
+						{
+							/* int i = Get(); is a variable */
+							return false;
+						}
+						else if ((c == '(' || c == '[') && angleDepth == 0)
+						{
+							if (c == '(' && i > first && Statement[i - 1].Type == TokenType::Identifier && !IsNeverAName(Statement[i - 1]))
+							{
+								nameBegin = i - 1;
+								parameters = i;
+								break;
+							}
+
+							/* __declspec(...), a parenthesised declarator or an array size */
+							i = FindClosing(i);
+						}
+					}
+
+					if (parameters >= Statement.size())
+					{
+						return false;
+					}
+
+					/* ~Name() */
+					if (nameBegin > first && Is(Statement[nameBegin - 1], "~"))
+					{
+						--nameBegin;
+					}
+
+					/* void A::B() is the definition of something declared elsewhere */
+					if (nameBegin > first && Is(Statement[nameBegin - 1], "::"))
+					{
+						return false;
+					}
+
+					const size_t nameIndex(Is(Statement[nameBegin], "~") ? nameBegin + 1 : nameBegin);
+
+					/* Without a return type this has to be a constructor or destructor, otherwise it is most likely a macro */
+					if (nameBegin == first && (Scopes.empty() || Scopes.back().Type != ScopeType::Class || GetText(Statement[nameIndex]) != Scopes.back().ClassName))
+					{
+						return false;
+					}
+
+					/* Everything up to a ctor initializer, = default, = 0 or the end: const, override, noexcept, -> Type */
+					size_t last(FindClosing(parameters));
+
+					if (last >= Statement.size())
+					{
+						return false;
+					}
+
+					for (size_t i(last + 1); i < Statement.size() && !Is(Statement[i], ":") && !Is(Statement[i], "="); ++i)
+					{
+						if (Is(Statement[i], "(") || Is(Statement[i], "["))
+						{
+							i = FindClosing(i);
+
+							if (i >= Statement.size())
+							{
+								break;
+							}
+						}
+
+						last = i;
+					}
+
+					Specifier specifiers(StatementSpecifiers);
+
+					for (size_t i(first); i < nameBegin; ++i)
+					{
+						if (Is(Statement[i], "inline"))
+						{
+							specifiers = specifiers | Specifier::Inline;
+						}
+						else if (Is(Statement[i], "static"))
+						{
+							specifiers = specifiers | Specifier::Static;
+						}
+						else if (Is(Statement[i], "constexpr") || Is(Statement[i], "consteval"))
+						{
+							specifiers = specifiers | Specifier::Constexpr;
+						}
+						else if (Is(Statement[i], "virtual"))
+						{
+							specifiers = specifiers | Specifier::Virtual;
+						}
+					}
+
+					/* = default, = delete or = 0 */
+					if (last + 2 < Statement.size() && Is(Statement[last + 1], "="))
+					{
+						if (Is(Statement[last + 2], "default") || Is(Statement[last + 2], "delete"))
+						{
+							specifiers = specifiers | Specifier::Defaulted;
+						}
+						else if (Is(Statement[last + 2], "0"))
+						{
+							specifiers = specifiers | Specifier::PureVirtual;
+						}
+					}
+
+					Declarations.push_back(Declaration{ DeclarationType::Function, Statement[first].Begin, Statement[last].End,
+						Statement[nameIndex].Begin, Statement[parameters - 1].End, Statement[first].Begin, GetClassDepth(), bHasBody, specifiers });
+
+					return true;
+				}
+
+				std::string_view Text;
+				Lexer TextLexer;
+				std::vector<Declaration>& Declarations;
+
+				std::vector<Token> Statement{};
+				std::vector<Scope> Scopes{};
+				std::string_view ClassName{};
+				Specifier StatementSpecifiers{}; /* of the statement AnalyzeStatement() looked at last */
+				size_t Nesting{}; /* of (), [] and {} inside the current statement */
+				bool bIsInInitializerList{};
+				bool bIsInTail{};
+			};
+		}
+
+		void ParseDeclarations(const std::string_view text, std::vector<Declaration>& declarations)
+		{
+			Parser parser(text, declarations);
+			parser.Parse();
+		}
+	}
+}
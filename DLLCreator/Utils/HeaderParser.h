@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint> /* uint8_t, uint16_t, uint32_t */
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace Cpp
+	{
+		enum class DeclarationType : uint8_t
+		{
+			Class = 0,
+			Struct = 1,
+			Function = 2
+		};
+
+		/* What a declaration is marked with, or inherits from where it is declared, as a bitmask */
+		enum class Specifier : uint16_t
+		{
+			None = 0,
+			Inline = 1 << 0,
+			Static = 1 << 1,
+			Constexpr = 1 << 2, /* also consteval */
+			Virtual = 1 << 3,
+			Template = 1 << 4, /* a template, or a member of a class template */
+			Internal = 1 << 5, /* inside of an anonymous namespace */
+			Defaulted = 1 << 6, /* = default or = delete */
+			PureVirtual = 1 << 7 /* = 0 */
+		};
+
+		constexpr Specifier operator|(const Specifier a, const Specifier b)
+		{
+			return static_cast<Specifier>(static_cast<uint16_t>(a) | static_cast<uint16_t>(b));
+		}
+
+		constexpr Specifier operator&(const Specifier a, const Specifier b)
+		{
+			return static_cast<Specifier>(static_cast<uint16_t>(a) & static_cast<uint16_t>(b));
+		}
+
+		constexpr bool HasAnySpecifier(const Specifier specifiers, const Specifier mask)
+		{
+			return (specifiers & mask) != Specifier::None;
+		}
+
+		/* A declaration found in a header, as byte offsets into the parsed text */
+		struct Declaration final
+		{
+			DeclarationType Type;
+			size_t Begin; /* the first token, after any leading [[attributes]] */
+			size_t End; /* one past the last token before the body, initializer or ';' */
+			size_t NameBegin;
+			size_t NameEnd;
+			size_t KeywordEnd; /* one past 'class' or 'struct', Begin for functions */
+			uint32_t Depth; /* the number of classes this declaration is nested in */
+			bool bIsDefinition; /* has a body */
+			Specifier Specifiers;
+		};
+
+		/* Finds class and struct definitions and the declarations of functions, in one linear pass over text.
+		Comments, string literals and preprocessor lines are skipped, namespaces, extern "C" blocks and classes are walked into,
+		function bodies, enums and initializers are not. Templates and everything inside of a class template get Specifier::Template. Out-of-class definitions of members (void A::B() {}) are left out.
+		This is no compiler: macros are not expanded, so a macro that hides a ';' or a brace will confuse it.
+		Declarations are appended to declarations in the order they appear in */
+		void ParseDeclarations(const std::string_view text, std::vector<Declaration>& declarations);
+	}
+}
@@ -0,0 +1,216 @@
+#include "IncludeParser.h"
+
+#include <algorithm> /* std::min, std::find, std::remove */
+#include <cctype> /* std::isalnum */
+
+namespace Utils
+{
+	namespace Cpp
+	{
+		namespace
+		{
+			constexpr bool IsBlank(const char c)
+			{
+				return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+			}
+
+			/* Returns where the first character after the blanks from pos on is */
+			size_t SkipBlanks(const std::string_view line, size_t pos)
+			{
+				while (pos < line.size() && IsBlank(line[pos]))
+				{
+					++pos;
+				}
+
+				return pos;
+			}
+
+			/* Walks over a line of code, returns true if a block comment starts in it that does not end in it.
+			String and character literals are skipped, so a comment opener inside of one does not count */
+			bool OpensBlockComment(const std::string_view line, size_t pos)
+			{
+				while (pos < line.size())
+				{
+					const char c(line[pos]);
+
+					if (c == '"' || c == '\'')
+					{
+						/* To the closing quote, escapes included */
+						for (++pos; pos < line.size() && line[pos] != c; ++pos)
+						{
+							if (line[pos] == '\\')
+							{
+								++pos;
+							}
+						}
+
+						++pos;
+					}
+					else if (c == '/' && pos + 1 < line.size() && line[pos + 1] == '/')
+					{
+						return false;
+					}
+					else if (c == '/' && pos + 1 < line.size() && line[pos + 1] == '*')
+					{
+						const size_t end(line.find("*/", pos + 2));
+
+						if (end == std::string_view::npos)
+						{
+							return true;
+						}
+
+						pos = end + 2;
+					}
+					else
+					{
+						++pos;
+					}
+				}
+
+				return false;
+			}
+
+			/* Calls onDirective(directive, arguments, depth) for every preprocessor directive of text, with the name of the directive,
+			the rest of its line from the first character after the blanks, and the number of #if blocks around it */
+			template<typename OnDirective>
+			void ForEachDirective(const std::string_view text, const OnDirective& onDirective)
+			{
+				size_t depth{}; /* of #if blocks */
+				bool bIsInBlockComment{};
+
+				for (size_t lineStart{}; lineStart < text.size();)
+				{
+					const size_t lineEnd(std::min(text.find('\n', lineStart), text.size()));
+					const std::string_view line(text.substr(lineStart, lineEnd - lineStart));
+					lineStart = lineEnd + 1;
+
+					size_t pos{};
+
+					if (bIsInBlockComment)
+					{
+						const size_t end(line.find("*/"));
+
+						if (end == std::string_view::npos)
+						{
+							continue;
+						}
+
+						pos = end + 2;
+						bIsInBlockComment = false;
+					}
+
+					pos = SkipBlanks(line, pos);
+
+					/* Comments in front of a directive: / * guard * / #include <x> */
+					while (line.substr(pos, 2) == "/*")
+					{
+						const size_t end(line.find("*/", pos + 2));
+
+						if (end == std::string_view::npos)
+						{
+							bIsInBlockComment = true;
+							break;
+						}
+
+						pos = SkipBlanks(line, end + 2);
+					}
+
+					if (bIsInBlockComment || pos >= line.size())
+					{
+						continue;
+					}
+
+					if (line[pos] != '#')
+					{
+						bIsInBlockComment = OpensBlockComment(line, pos);
+						continue;
+					}
+
+					pos = SkipBlanks(line, pos + 1);
+
+					size_t nameEnd(pos);
+					while (nameEnd < line.size() && line[nameEnd] >= 'a' && line[nameEnd] <= 'z')
+					{
+						++nameEnd;
+					}
+
+					const std::string_view directive(line.substr(pos, nameEnd - pos));
+
+					onDirective(directive, line.substr(SkipBlanks(line, nameEnd)), depth);
+
+					if (directive == "if" || directive == "ifdef" || directive == "ifndef")
+					{
+						++depth;
+					}
+					else if (directive == "endif" && depth > 0)
+					{
+						--depth;
+					}
+
+					bIsInBlockComment = OpensBlockComment(line, nameEnd);
+				}
+			}
+
+			size_t GetIdentifierLength(const std::string_view text)
+			{
+				size_t length{};
+
+				while (length < text.size() && (std::isalnum(static_cast<unsigned char>(text[length])) || text[length] == '_'))
+				{
+					++length;
+				}
+
+				return length;
+			}
+		}
+
+		void ParseIncludes(const std::string_view text, std::vector<IncludeDirective>& includes)
+		{
+			bool bHasDefined{};
+
+			ForEachDirective(text, [&includes, &bHasDefined](const std::string_view directive, const std::string_view arguments, const size_t depth)
+				{
+					if (directive == "include" && !arguments.empty() && (arguments.front() == '<' || arguments.front() == '"'))
+					{
+						const char closing(arguments.front() == '<' ? '>' : '"');
+						const size_t end(arguments.find(closing, 1));
+
+						if (end != std::string_view::npos && end > 1)
+						{
+							includes.push_back(IncludeDirective{ arguments.substr(1, end - 1), closing == '>', depth > 0, bHasDefined });
+						}
+					}
+					else if (directive == "define" || directive == "undef")
+					{
+						bHasDefined = true;
+					}
+				});
+		}
+
+		void FindLeakedMacros(const std::string_view text, std::vector<std::string_view>& macros)
+		{
+			const size_t firstMacro(macros.size());
+			std::string_view guard{};
+
+			ForEachDirective(text, [&macros, &guard, firstMacro](const std::string_view directive, const std::string_view arguments, const size_t)
+				{
+					const std::string_view name(arguments.substr(0, GetIdentifierLength(arguments)));
+
+					/* #ifndef X right before #define X is an include guard, it leaks on purpose */
+					if (directive == "define" && !name.empty() && name != guard)
+					{
+						if (std::find(macros.cbegin() + firstMacro, macros.cend(), name) == macros.cend())
+						{
+							macros.push_back(name);
+						}
+					}
+					else if (directive == "undef")
+					{
+						macros.erase(std::remove(macros.begin() + firstMacro, macros.end(), name), macros.end());
+					}
+
+					guard = directive == "ifndef" ? name : std::string_view{};
+				});
+		}
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace Cpp
+	{
+		/* An #include directive, as a view into the parsed text */
+		struct IncludeDirective final
+		{
+			std::string_view Path; /* between the angle brackets or the quotes */
+			bool bIsAngled; /* <path> instead of "path" */
+			bool bIsConditional; /* inside of an #if, #ifdef or #ifndef */
+			bool bFollowsDefine; /* a #define or #undef comes before it, which may change what it means */
+		};
+
+		/* Finds the #include directives of text in one pass over its lines, comments are skipped.
+		Like ParseDeclarations() this is no preprocessor: macros are not expanded, so #include MACRO is left out,
+		and conditions are not evaluated. Includes are appended to includes in the order they appear in */
+		void ParseIncludes(const std::string_view text, std::vector<IncludeDirective>& includes);
+
+		/* Appends the macros text #defines and does not #undef again further down to macros, as views into text.
+		In a source file those leak into whatever comes after it when sources get compiled together.
+		Include guards (#ifndef X followed by #define X) are left out */
+		void FindLeakedMacros(const std::string_view text, std::vector<std::string_view>& macros);
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint> /* uint64_t */
+#include <string> /* std::string */
+
+namespace Utils
+{
+	/* Hands out job slots to builds running at the same time, so together they never run more compiles than it has slots.
+	It speaks the GNU make jobserver protocol, which make 4.4 and Ninja 1.13 and up join when MAKEFLAGS points them at it:
+	a named pipe (fifo) holding one byte per slot on POSIX, a named semaphore on Windows.
+	Every build may run one job without taking a slot, so N jobs shared by C builds need N - C slots.
+	The platform specific parts live in JobServerPosix.cpp and JobServerWin32.cpp */
+	class JobServer final
+	{
+	public:
+		JobServer() = default;
+		/* Removes the fifo or semaphore, builds still using it have to be done by then */
+		~JobServer();
+
+		JobServer(const JobServer&) = delete;
+		JobServer(JobServer&&) noexcept = delete;
+		JobServer& operator=(const JobServer&) = delete;
+		JobServer& operator=(JobServer&&) noexcept = delete;
+
+		/* nrOfSlots has to be at least 1, returns false and fills in error if the fifo or semaphore could not be created */
+		bool Create(const size_t nrOfSlots, std::string& error);
+		bool IsCreated() const { return !MakeFlags.empty(); }
+
+		/* What MAKEFLAGS has to be set to for a build to join, empty until Create() succeeded */
+		const std::string& GetMakeFlags() const { return MakeFlags; }
+
+	private:
+#ifdef _WIN32
+		void* Semaphore{}; /* HANDLE */
+#else
+		int Fifo{ -1 }; /* kept open for reading and writing, so the fifo never reads as closed while builds come and go */
+		std::string FifoPath{};
+#endif
+		std::string MakeFlags{};
+	};
+
+	/* Bytes of physical memory that can be taken without anything getting swapped out, 0 if that can not be found out.
+	On Linux this respects the memory limit of the cgroup this process runs in, so a container is not mistaken for its host */
+	uint64_t GetAvailableMemory();
+}
@@ -0,0 +1,132 @@
+#ifndef _WIN32
+
+#include "JobServer.h"
+
+#include <algorithm> /* std::min */
+#include <assert.h> /* assert() */
+#include <atomic> /* std::atomic */
+#include <cerrno> /* errno */
+#include <cstdlib> /* std::strtoull */
+#include <cstring> /* std::strerror */
+#include <filesystem> /* std::filesystem::temp_directory_path */
+#include <fstream> /* std::ifstream */
+
+/* POSIX specific includes */
+#include <fcntl.h> /* open(), O_RDWR, O_CLOEXEC */
+#include <sys/stat.h> /* mkfifo() */
+#include <unistd.h> /* write(), close(), unlink(), getpid(), sysconf() */
+
+namespace Utils
+{
+	namespace
+	{
+		/* Tells apart the jobservers of one process */
+		std::atomic<uint32_t> NrOfCreatedJobServers{};
+
+		/* The number in the first line of path that follows key, or 0 if there is none */
+		uint64_t ReadNumber(const char* pPath, const std::string& key)
+		{
+			std::ifstream file(pPath);
+
+			for (std::string line{}; std::getline(file, line);)
+			{
+				if (line.compare(0, key.size(), key) == 0)
+				{
+					return std::strtoull(line.c_str() + key.size(), nullptr, 10);
+				}
+			}
+
+			return 0;
+		}
+	}
+
+	JobServer::~JobServer()
+	{
+		if (IsCreated())
+		{
+			close(Fifo);
+			unlink(FifoPath.c_str());
+		}
+	}
+
+	bool JobServer::Create(const size_t nrOfSlots, std::string& error)
+	{
+		assert(!IsCreated() && "JobServer::Create() > The jobserver already exists!");
+		assert(nrOfSlots > 0 && "JobServer::Create() > A jobserver needs at least one slot!");
+
+		std::error_code directoryError{};
+		const std::filesystem::path directory(std::filesystem::temp_directory_path(directoryError));
+
+		if (directoryError)
+		{
+			error = "could not find the temporary folder: " + directoryError.message();
+			return false;
+		}
+
+		const std::string path((directory / ("DLLCreator-" + std::to_string(getpid()) + "-" + std::to_string(NrOfCreatedJobServers++) + ".jobserver")).string());
+
+		/* Left behind by an earlier process with the same id */
+		unlink(path.c_str());
+
+		if (mkfifo(path.c_str(), 0600) != 0)
+		{
+			error = "could not create " + path + ": " + std::strerror(errno);
+			return false;
+		}
+
+		/* Never blocks on Linux and macOS, where it counts as both a reader and a writer */
+		const int fifo(open(path.c_str(), O_RDWR | O_CLOEXEC));
+
+		if (fifo < 0)
+		{
+			error = "could not open " + path + ": " + std::strerror(errno);
+			unlink(path.c_str());
+			return false;
+		}
+
+		/* Far less than the pipe buffer, so it all goes in at once */
+		const std::string slots(nrOfSlots, '+');
+
+		if (write(fifo, slots.data(), slots.size()) != static_cast<ssize_t>(slots.size()))
+		{
+			error = "could not fill " + path + ": " + std::strerror(errno);
+			close(fifo);
+			unlink(path.c_str());
+			return false;
+		}
+
+		Fifo = fifo;
+		FifoPath = path;
+		MakeFlags = "-j" + std::to_string(nrOfSlots + 1) + " --jobserver-auth=fifo:" + path;
+
+		return true;
+	}
+
+	uint64_t GetAvailableMemory()
+	{
+		/* What the kernel thinks can be allocated without swapping, page cache that can be dropped included */
+		uint64_t available(ReadNumber("/proc/meminfo", "MemAvailable:") * 1024);
+
+		if (available == 0)
+		{
+			const long nrOfPages(sysconf(_SC_PHYS_PAGES));
+			const long pageSize(sysconf(_SC_PAGE_SIZE));
+
+			if (nrOfPages > 0 && pageSize > 0)
+			{
+				available = static_cast<uint64_t>(nrOfPages) * static_cast<uint64_t>(pageSize);
+			}
+		}
+
+		/* A cgroup v2 limit, "max" reads as 0 */
+		if (const uint64_t limit(ReadNumber("/sys/fs/cgroup/memory.max", "")); limit > 0)
+		{
+			const uint64_t used(ReadNumber("/sys/fs/cgroup/memory.current", ""));
+			available = std::min(available, limit > used ? limit - used : 0);
+		}
+
+		return available;
+	}
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifdef _WIN32
+
+#include "JobServer.h"
+
+#include <assert.h> /* assert() */
+#include <atomic> /* std::atomic */
+
+/* Windows specific includes */
+#define WIN32_LEAN_AND_MEAN /* Exclude rarely-used stuff from Windows headers */
+#include <Windows.h> /* CreateSemaphoreA(), GlobalMemoryStatusEx() */
+
+namespace Utils
+{
+	namespace
+	{
+		/* Tells apart the jobservers of one process */
+		std::atomic<uint32_t> NrOfCreatedJobServers{};
+	}
+
+	JobServer::~JobServer()
+	{
+		if (IsCreated())
+		{
+			CloseHandle(Semaphore);
+		}
+	}
+
+	bool JobServer::Create(const size_t nrOfSlots, std::string& error)
+	{
+		assert(!IsCreated() && "JobServer::Create() > The jobserver already exists!");
+		assert(nrOfSlots > 0 && "JobServer::Create() > A jobserver needs at least one slot!");
+
+		const std::string name("DLLCreator-" + std::to_string(GetCurrentProcessId()) + "-" + std::to_string(NrOfCreatedJobServers++) + "-jobserver");
+		const LONG count(static_cast<LONG>(nrOfSlots));
+
+		/* Every slot starts out free */
+		const HANDLE semaphore(CreateSemaphoreA(nullptr, count, count, name.c_str()));
+
+		if (semaphore == nullptr)
+		{
+			error = "could not create the semaphore " + name + " (error " + std::to_string(GetLastError()) + ")";
+			return false;
+		}
+
+		Semaphore = semaphore;
+		MakeFlags = "-j" + std::to_string(nrOfSlots + 1) + " --jobserver-auth=" + name;
+
+		return true;
+	}
+
+	uint64_t GetAvailableMemory()
+	{
+		MEMORYSTATUSEX status{};
+		status.dwLength = sizeof(status);
+
+		return GlobalMemoryStatusEx(&status) ? static_cast<uint64_t>(status.ullAvailPhys) : 0;
+	}
+}
+
+#endif
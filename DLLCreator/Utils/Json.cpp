@@ -0,0 +1,661 @@
+#include "Json.h"
+
+#include <assert.h> /* assert() */
+#include <cmath> /* std::floor, std::isfinite */
+#include <cstdlib> /* std::strtod */
+#include <cstdio> /* std::snprintf */
+
+namespace Utils
+{
+	namespace Json
+	{
+		namespace
+		{
+			class Parser final
+			{
+			public:
+				explicit Parser(const std::string_view text) : Text{ text } {}
+
+				bool ParseDocument(Value& value, std::string& error)
+				{
+					SkipWhitespace();
+
+					if (!ParseValue(value, 0))
+					{
+						error = "line " + std::to_string(GetLineNumber()) + ": " + Error;
+						return false;
+					}
+
+					SkipWhitespace();
+
+					if (Position != Text.size())
+					{
+						error = "line " + std::to_string(GetLineNumber()) + ": unexpected characters after the document";
+						return false;
+					}
+
+					return true;
+				}
+
+			private:
+				/* Protects against stack overflows on hostile input */
+				constexpr inline static size_t MaxDepth{ 256 };
+
+				bool Fail(const char* pError)
+				{
+					Error = pError;
+					return false;
+				}
+
+				size_t GetLineNumber() const
+				{
+					size_t line{ 1 };
+					for (size_t i{}; i < Position && i < Text.size(); ++i)
+					{
+						if (Text[i] == '\n')
+						{
+							++line;
+						}
+					}
+
+					return line;
+				}
+
+				void SkipWhitespace()
+				{
+					while (Position < Text.size() &&
+						(Text[Position] == ' ' || Text[Position] == '\t' || Text[Position] == '\n' || Text[Position] == '\r'))
+					{
+						++Position;
+					}
+				}
+
+				bool Consume(const std::string_view literal)
+				{
+					if (Text.substr(Position, literal.size()) == literal)
+					{
+						Position += literal.size();
+						return true;
+					}
+
+					return false;
+				}
+
+				bool ParseValue(Value& value, const size_t depth)
+				{
+					if (depth > MaxDepth)
+					{
+						return Fail("document is nested too deeply");
+					}
+
+					if (Position >= Text.size())
+					{
+						return Fail("unexpected end of document");
+					}
+
+					switch (Text[Position])
+					{
+					case '{':
+						return ParseObject(value, depth);
+					case '[':
+						return ParseArray(value, depth);
+					case '"':
+					{
+						std::string string{};
+						if (!ParseString(string))
+						{
+							return false;
+						}
+
+						value = Value::MakeString(std::move(string));
+						return true;
+					}
+					case 't':
+						if (Consume("true"))
+						{
+							value = Value::MakeBoolean(true);
+							return true;
+						}
+						break;
+					case 'f':
+						if (Consume("false"))
+						{
+							value = Value::MakeBoolean(false);
+							return true;
+						}
+						break;
+					case 'n':
+						if (Consume("null"))
+						{
+							value = Value{};
+							return true;
+						}
+						break;
+					default:
+						if (Text[Position] == '-' || (Text[Position] >= '0' && Text[Position] <= '9'))
+						{
+							return ParseNumber(value);
+						}
+						break;
+					}
+
+					return Fail("unexpected character");
+				}
+
+				bool ParseObject(Value& value, const size_t depth)
+				{
+					++Position; /* '{' */
+					value = Value::MakeObject();
+
+					SkipWhitespace();
+					if (Position < Text.size() && Text[Position] == '}')
+					{
+						++Position;
+						return true;
+					}
+
+					while (true)
+					{
+						SkipWhitespace();
+
+						if (Position >= Text.size() || Text[Position] != '"')
+						{
+							return Fail("expected a string as object key");
+						}
+
+						std::string key{};
+						if (!ParseString(key))
+						{
+							return false;
+						}
+
+						SkipWhitespace();
+						if (Position >= Text.size() || Text[Position] != ':')
+						{
+							return Fail("expected ':' after object key");
+						}
+						++Position;
+
+						SkipWhitespace();
+
+						Value member{};
+						if (!ParseValue(member, depth + 1))
+						{
+							return false;
+						}
+
+						value.Set(key, std::move(member));
+
+						SkipWhitespace();
+						if (Position < Text.size() && Text[Position] == ',')
+						{
+							++Position;
+							continue;
+						}
+
+						if (Position < Text.size() && Text[Position] == '}')
+						{
+							++Position;
+							return true;
+						}
+
+						return Fail("expected ',' or '}' in object");
+					}
+				}
+
+				bool ParseArray(Value& value, const size_t depth)
+				{
+					++Position; /* '[' */
+					value = Value::MakeArray();
+
+					SkipWhitespace();
+					if (Position < Text.size() && Text[Position] == ']')
+					{
+						++Position;
+						return true;
+					}
+
+					while (true)
+					{
+						SkipWhitespace();
+
+						Value element{};
+						if (!ParseValue(element, depth + 1))
+						{
+							return false;
+						}
+
+						value.Append(std::move(element));
+
+						SkipWhitespace();
+						if (Position < Text.size() && Text[Position] == ',')
+						{
+							++Position;
+							continue;
+						}
+
+						if (Position < Text.size() && Text[Position] == ']')
+						{
+							++Position;
+							return true;
+						}
+
+						return Fail("expected ',' or ']' in array");
+					}
+				}
+
+				bool ParseHex(uint32_t& codePoint)
+				{
+					if (Position + 4 > Text.size())
+					{
+						return Fail("incomplete \\u escape");
+					}
+
+					codePoint = 0;
+					for (size_t i{}; i < 4; ++i)
+					{
+						const char c(Text[Position++]);
+						codePoint <<= 4;
+
+						if (c >= '0' && c <= '9')
+						{
+							codePoint |= static_cast<uint32_t>(c - '0');
+						}
+						else if (c >= 'a' && c <= 'f')
+						{
+							codePoint |= static_cast<uint32_t>(c - 'a' + 10);
+						}
+						else if (c >= 'A' && c <= 'F')
+						{
+							codePoint |= static_cast<uint32_t>(c - 'A' + 10);
+						}
+						else
+						{
+							return Fail("invalid \\u escape");
+						}
+					}
+
+					return true;
+				}
+
+				static void AppendUTF8(std::string& string, const uint32_t codePoint)
+				{
+					if (codePoint < 0x80)
+					{
+						string.push_back(static_cast<char>(codePoint));
+					}
+					else if (codePoint < 0x800)
+					{
+						string.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+						string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+					}
+					else if (codePoint < 0x10000)
+					{
+						string.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+						string.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+						string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+					}
+					else
+					{
+						string.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+						string.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+						string.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+						string.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+					}
+				}
+
+				bool ParseString(std::string& string)
+				{
+					++Position; /* '"' */
+
+					while (Position < Text.size())
+					{
+						const char c(Text[Position++]);
+
+						if (c == '"')
+						{
+							return true;
+						}
+
+						if (static_cast<unsigned char>(c) < 0x20)
+						{
+							return Fail("control character in string");
+						}
+
+						if (c != '\\')
+						{
+							string.push_back(c);
+							continue;
+						}
+
+						if (Position >= Text.size())
+						{
+							break;
+						}
+
+						switch (Text[Position++])
+						{
+						case '"': string.push_back('"'); break;
+						case '\\': string.push_back('\\'); break;
+						case '/': string.push_back('/'); break;
+						case 'b': string.push_back('\b'); break;
+						case 'f': string.push_back('\f'); break;
+						case 'n': string.push_back('\n'); break;
+						case 'r': string.push_back('\r'); break;
+						case 't': string.push_back('\t'); break;
+						case 'u':
+						{
+							uint32_t codePoint{};
+							if (!ParseHex(codePoint))
+							{
+								return false;
+							}
+
+							/* Surrogate pair */
+							if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+							{
+								uint32_t lowSurrogate{};
+								if (!Consume("\\u") || !ParseHex(lowSurrogate) || lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+								{
+									return Fail("invalid surrogate pair");
+								}
+
+								codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+							}
+
+							AppendUTF8(string, codePoint);
+							break;
+						}
+						default:
+							return Fail("invalid escape sequence");
+						}
+					}
+
+					return Fail("unterminated string");
+				}
+
+				bool ParseNumber(Value& value)
+				{
+					const size_t begin(Position);
+
+					if (Text[Position] == '-')
+					{
+						++Position;
+					}
+
+					const auto skipDigits([this]()->size_t
+						{
+							const size_t digitsBegin(Position);
+							while (Position < Text.size() && Text[Position] >= '0' && Text[Position] <= '9')
+							{
+								++Position;
+							}
+
+							return Position - digitsBegin;
+						});
+
+					if (skipDigits() == 0)
+					{
+						return Fail("invalid number");
+					}
+
+					if (Position < Text.size() && Text[Position] == '.')
+					{
+						++Position;
+						if (skipDigits() == 0)
+						{
+							return Fail("invalid number");
+						}
+					}
+
+					if (Position < Text.size() && (Text[Position] == 'e' || Text[Position] == 'E'))
+					{
+						++Position;
+						if (Position < Text.size() && (Text[Position] == '+' || Text[Position] == '-'))
+						{
+							++Position;
+						}
+
+						if (skipDigits() == 0)
+						{
+							return Fail("invalid number");
+						}
+					}
+
+					/* strtod needs a null terminated string */
+					const std::string number(Text.substr(begin, Position - begin));
+					value = Value::MakeNumber(std::strtod(number.c_str(), nullptr));
+
+					return true;
+				}
+
+				std::string_view Text;
+				size_t Position{};
+				const char* Error{ "" };
+			};
+
+			void WriteString(std::string& output, const std::string& string)
+			{
+				output.push_back('"');
+
+				for (const char c : string)
+				{
+					switch (c)
+					{
+					case '"': output.append("\\\""); break;
+					case '\\': output.append("\\\\"); break;
+					case '\b': output.append("\\b"); break;
+					case '\f': output.append("\\f"); break;
+					case '\n': output.append("\\n"); break;
+					case '\r': output.append("\\r"); break;
+					case '\t': output.append("\\t"); break;
+					default:
+						if (static_cast<unsigned char>(c) < 0x20)
+						{
+							char buffer[8]{};
+							std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+							output.append(buffer);
+						}
+						else
+						{
+							output.push_back(c);
+						}
+						break;
+					}
+				}
+
+				output.push_back('"');
+			}
+
+			void WriteValue(std::string& output, const Value& value, const size_t indentation)
+			{
+				switch (value.GetType())
+				{
+				case Value::Type::Null:
+					output.append("null");
+					break;
+				case Value::Type::Boolean:
+					output.append(value.GetBoolean() ? "true" : "false");
+					break;
+				case Value::Type::Number:
+				{
+					const double number(value.GetNumber());
+
+					/* Integers are by far the most common numbers we write, keep them readable */
+					if (std::isfinite(number) && std::floor(number) == number && std::abs(number) < 1e15)
+					{
+						output.append(std::to_string(static_cast<long long>(number)));
+					}
+					else
+					{
+						char buffer[32]{};
+						std::snprintf(buffer, sizeof(buffer), "%.17g", number);
+						output.append(buffer);
+					}
+					break;
+				}
+				case Value::Type::String:
+					WriteString(output, value.GetString());
+					break;
+				case Value::Type::Array:
+				{
+					if (value.GetArray().empty())
+					{
+						output.append("[]");
+						break;
+					}
+
+					output.append("[\n");
+					for (size_t i{}; i < value.GetArray().size(); ++i)
+					{
+						output.append(indentation + 1, '\t');
+						WriteValue(output, value.GetArray()[i], indentation + 1);
+						output.append(i + 1 < value.GetArray().size() ? ",\n" : "\n");
+					}
+					output.append(indentation, '\t');
+					output.push_back(']');
+					break;
+				}
+				case Value::Type::Object:
+				{
+					if (value.GetObject().empty())
+					{
+						output.append("{}");
+						break;
+					}
+
+					output.append("{\n");
+					for (size_t i{}; i < value.GetObject().size(); ++i)
+					{
+						output.append(indentation + 1, '\t');
+						WriteString(output, value.GetObject()[i].first);
+						output.append(": ");
+						WriteValue(output, value.GetObject()[i].second, indentation + 1);
+						output.append(i + 1 < value.GetObject().size() ? ",\n" : "\n");
+					}
+					output.append(indentation, '\t');
+					output.push_back('}');
+					break;
+				}
+				}
+			}
+		}
+
+		Value Value::MakeBoolean(const bool bValue)
+		{
+			Value value{};
+			value.ValueType = Type::Boolean;
+			value.bBoolean = bValue;
+			return value;
+		}
+
+		Value Value::MakeNumber(const double number)
+		{
+			Value value{};
+			value.ValueType = Type::Number;
+			value.Number = number;
+			return value;
+		}
+
+		Value Value::MakeString(std::string string)
+		{
+			Value value{};
+			value.ValueType = Type::String;
+			value.String = std::move(string);
+			return value;
+		}
+
+		Value Value::MakeArray()
+		{
+			Value value{};
+			value.ValueType = Type::Array;
+			return value;
+		}
+
+		Value Value::MakeObject()
+		{
+			Value value{};
+			value.ValueType = Type::Object;
+			return value;
+		}
+
+		bool Value::GetBoolean(const bool bFallback) const
+		{
+			return ValueType == Type::Boolean ? bBoolean : bFallback;
+		}
+
+		double Value::GetNumber(const double fallback) const
+		{
+			return ValueType == Type::Number ? Number : fallback;
+		}
+
+		const std::string& Value::GetString() const
+		{
+			/* String is always empty when this is not a string */
+			return String;
+		}
+
+		const Value::Array& Value::GetArray() const
+		{
+			return ArrayValues;
+		}
+
+		const Value::Object& Value::GetObject() const
+		{
+			return ObjectValues;
+		}
+
+		const Value* Value::Find(const std::string_view key) const
+		{
+			for (const auto& [memberKey, member] : ObjectValues)
+			{
+				if (memberKey == key)
+				{
+					return &member;
+				}
+			}
+
+			return nullptr;
+		}
+
+		Value& Value::Append(Value value)
+		{
+			assert(ValueType == Type::Array && "Json::Value::Append() > Value is not an array!");
+
+			ArrayValues.push_back(std::move(value));
+			return ArrayValues.back();
+		}
+
+		Value& Value::Set(const std::string_view key, Value value)
+		{
+			assert(ValueType == Type::Object && "Json::Value::Set() > Value is not an object!");
+
+			for (auto& [memberKey, member] : ObjectValues)
+			{
+				if (memberKey == key)
+				{
+					member = std::move(value);
+					return member;
+				}
+			}
+
+			ObjectValues.emplace_back(std::string(key), std::move(value));
+			return ObjectValues.back().second;
+		}
+
+		bool Parse(const std::string_view text, Value& value, std::string& error)
+		{
+			Parser parser(text);
+			return parser.ParseDocument(value, error);
+		}
+
+		std::string Write(const Value& value)
+		{
+			std::string output{};
+			WriteValue(output, value, 0);
+			output.push_back('\n');
+
+			return output;
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint> /* uint8_t */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <utility> /* std::pair */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace Json
+	{
+		/* Just enough JSON for the files this tool reads and writes itself, objects keep their key order */
+		class Value final
+		{
+		public:
+			enum class Type : uint8_t
+			{
+				Null = 0,
+				Boolean = 1,
+				Number = 2,
+				String = 3,
+				Array = 4,
+				Object = 5
+			};
+
+			using Array = std::vector<Value>;
+			using Object = std::vector<std::pair<std::string, Value>>;
+
+			Value() = default;
+
+			static Value MakeBoolean(const bool bValue);
+			static Value MakeNumber(const double value);
+			static Value MakeString(std::string value);
+			static Value MakeArray();
+			static Value MakeObject();
+
+			Type GetType() const { return ValueType; }
+			bool IsNull() const { return ValueType == Type::Null; }
+			bool IsBoolean() const { return ValueType == Type::Boolean; }
+			bool IsNumber() const { return ValueType == Type::Number; }
+			bool IsString() const { return ValueType == Type::String; }
+			bool IsArray() const { return ValueType == Type::Array; }
+			bool IsObject() const { return ValueType == Type::Object; }
+
+			/* The getters return the fallback when the value is of a different type */
+			bool GetBoolean(const bool bFallback = false) const;
+			double GetNumber(const double fallback = 0.0) const;
+			const std::string& GetString() const; /* empty string if this is not a string */
+			const Array& GetArray() const; /* empty array if this is not an array */
+			const Object& GetObject() const; /* empty object if this is not an object */
+
+			/* Returns nullptr if this is not an object or the key does not exist */
+			const Value* Find(const std::string_view key) const;
+
+			/* Only valid on arrays and objects respectively */
+			Value& Append(Value value);
+			Value& Set(const std::string_view key, Value value);
+
+		private:
+			Type ValueType{ Type::Null };
+			bool bBoolean{};
+			double Number{};
+			std::string String{};
+			Array ArrayValues{};
+			Object ObjectValues{};
+		};
+
+		/* Returns false and fills in error (with line number) if text is not valid JSON */
+		bool Parse(const std::string_view text, Value& value, std::string& error);
+
+		/* Pretty prints value with tabs, so written files diff nicely */
+		std::string Write(const Value& value);
+	}
+}
@@ -0,0 +1,54 @@
+#include "LineIndex.h"
+#include "ByteSearch.h" /* FindByte */
+
+#include <algorithm> /* std::upper_bound */
+#include <assert.h> /* assert() */
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			/* Appends i + 1 for every '\n' at i in text */
+			void AddLineStarts(const std::basic_string_view<BYTE> text, std::vector<size_t>& lineStarts)
+			{
+				for (size_t newLine(FindByte(text, '\n')); newLine != NotFound; newLine = FindByte(text, '\n', newLine + 1))
+				{
+					lineStarts.push_back(newLine + 1);
+				}
+			}
+		}
+
+		LineIndex::LineIndex(const std::basic_string_view<BYTE> text)
+		{
+			Build(text);
+		}
+
+		void LineIndex::Build(const std::basic_string_view<BYTE> text)
+		{
+			Text = text;
+			LineStarts.clear();
+
+			if (!text.empty())
+			{
+				LineStarts.push_back(0);
+				AddLineStarts(text, LineStarts);
+
+				/* A trailing '\n' ends the last line, it does not start a new one */
+				if (LineStarts.back() == text.size())
+				{
+					LineStarts.pop_back();
+				}
+			}
+		}
+
+		size_t LineIndex::FindLine(const size_t offset) const
+		{
+			assert(offset < Text.size() && "LineIndex::FindLine() > offset is out of bounds!");
+
+			/* The last line that starts at or before offset */
+			return static_cast<size_t>(std::upper_bound(LineStarts.cbegin(), LineStarts.cend(), offset) - LineStarts.cbegin()) - 1;
+		}
+	}
+}
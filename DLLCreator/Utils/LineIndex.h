@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Utils.h" /* BYTE */
+
+#include <string_view> /* std::basic_string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace IO
+	{
+		/* The offset of every line in a text, found in one vectorized pass, so lines can be sliced out as views without scanning again.
+		A line includes its '\n' (and a '\r' in front of it), a '\n' at the very end of the text does not start another, empty, line.
+		The index only keeps a view of the text, the text has to outlive it */
+		class LineIndex final
+		{
+		public:
+			LineIndex() = default;
+			explicit LineIndex(const std::basic_string_view<BYTE> text);
+
+			void Build(const std::basic_string_view<BYTE> text);
+
+			size_t GetNumberOfLines() const { return LineStarts.size(); }
+			size_t GetLineStart(const size_t line) const { return LineStarts[line]; }
+			/* One past the '\n' that ends line, or the end of the text for the last line */
+			size_t GetLineEnd(const size_t line) const { return line + 1 < LineStarts.size() ? LineStarts[line + 1] : Text.size(); }
+			std::basic_string_view<BYTE> GetLine(const size_t line) const { return Text.substr(GetLineStart(line), GetLineEnd(line) - GetLineStart(line)); }
+
+			/* The line that contains offset, which has to be inside the text */
+			size_t FindLine(const size_t offset) const;
+
+			std::basic_string_view<BYTE> GetText() const { return Text; }
+
+		private:
+			std::basic_string_view<BYTE> Text{};
+			std::vector<size_t> LineStarts{};
+		};
+	}
+}
@@ -0,0 +1,32 @@
+#include "Process.h"
+
+namespace Utils
+{
+	void Process::FlushLines(const std::function<void(const std::string_view line)>& onLine, const bool bIsLastChunk)
+	{
+		size_t lineBegin{};
+
+		for (size_t lineEnd(Pending.find('\n')); lineEnd != std::string::npos; lineEnd = Pending.find('\n', lineBegin))
+		{
+			std::string_view line(std::string_view(Pending).substr(lineBegin, lineEnd - lineBegin));
+
+			/* Windows line endings */
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.remove_suffix(1);
+			}
+
+			onLine(line);
+			lineBegin = lineEnd + 1;
+		}
+
+		Pending.erase(0, lineBegin);
+
+		/* A last line without a line ending */
+		if (bIsLastChunk && !Pending.empty())
+		{
+			onLine(Pending);
+			Pending.clear();
+		}
+	}
+}
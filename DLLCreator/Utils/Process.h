@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono> /* std::chrono::steady_clock */
+#include <functional> /* std::function */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	/* A program running next to this one, started without a shell so nothing in its arguments gets interpreted.
+	Its standard output and standard error both go into one pipe, which Wait() reads line by line.
+	The platform specific parts live in ProcessPosix.cpp (posix_spawn) and ProcessWin32.cpp (CreateProcess) */
+	class Process final
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Result final
+		{
+			bool bTimedOut{}; /* killed, together with everything it started, because it ran too long */
+			int ExitCode{ -1 }; /* -1 if it timed out or was killed by a signal */
+			Clock::duration Duration{}; /* from Start() until it exited */
+		};
+
+		Process() = default;
+		/* A process that was never waited for gets killed */
+		~Process();
+
+		Process(const Process&) = delete;
+		Process(Process&&) noexcept = delete;
+		Process& operator=(const Process&) = delete;
+		Process& operator=(Process&&) noexcept = delete;
+
+		/* Starts arguments[0], looked up in PATH, with the rest of arguments as its arguments, in workingDirectory (empty for the current one).
+		It gets the environment of this process, with the "NAME=value" entries of environment added or replacing the ones with the same name.
+		Returns right away, false and fills in error if it could not be started */
+		bool Start(const std::vector<std::string>& arguments, const std::string& workingDirectory, const std::vector<std::string>& environment, std::string& error);
+
+		/* Passes every line the process writes to onLine, without the line ending and on the calling thread, until it exits.
+		A process that is still running after timeout (zero for no limit) gets killed */
+		Result Wait(const std::function<void(const std::string_view line)>& onLine, const Clock::duration timeout = Clock::duration::zero());
+
+		bool IsStarted() const { return bIsStarted; }
+
+	private:
+		/* Hands every complete line in Pending to onLine, whatever is left is the start of the next line */
+		void FlushLines(const std::function<void(const std::string_view line)>& onLine, const bool bIsLastChunk);
+		void Kill();
+
+#ifdef _WIN32
+		void* ProcessHandle{}; /* HANDLE */
+		void* JobHandle{}; /* HANDLE, the job object everything the process starts ends up in, so it can all be killed at once */
+		void* OutputPipe{}; /* HANDLE */
+#else
+		int ProcessId{ -1 }; /* also the id of the process group everything it starts ends up in */
+		int OutputPipe{ -1 };
+#endif
+		std::string Pending{};
+		Clock::time_point StartTime{};
+		bool bIsStarted{};
+	};
+
+	/* The full path of the program Process::Start() would run for name, empty if it is not in PATH.
+	On Windows the extensions in PATHEXT are tried as well, so "ninja" finds ninja.exe */
+	std::string FindProgram(const std::string& name);
+}
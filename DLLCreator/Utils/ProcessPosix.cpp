@@ -0,0 +1,290 @@
+#ifndef _WIN32
+
+#include "Process.h"
+
+#include <algorithm> /* std::min, std::any_of */
+#include <assert.h> /* assert() */
+#include <cerrno> /* errno, EINTR, EAGAIN */
+#include <cstdlib> /* std::getenv */
+#include <cstring> /* std::strerror, std::strncmp */
+#include <filesystem> /* std::filesystem::is_regular_file */
+#include <mutex> /* std::mutex, std::lock_guard */
+
+/* POSIX specific includes */
+#include <fcntl.h> /* fcntl(), O_NONBLOCK, FD_CLOEXEC */
+#include <poll.h> /* poll() */
+#include <signal.h> /* kill(), SIGKILL */
+#include <spawn.h> /* posix_spawnp(), posix_spawn_file_actions_addchdir_np() */
+#include <sys/wait.h> /* waitpid() */
+#include <unistd.h> /* pipe(), read(), close(), access() */
+
+extern char** environ;
+
+namespace Utils
+{
+	namespace
+	{
+		/* Held while a pipe exists that is not close-on-exec yet, so a process started on another thread can never inherit it.
+		An inherited write end would keep the pipe open until that other process exits */
+		std::mutex SpawnMutex{};
+
+		/* Reads whatever is in the pipe right now, returns false once every writer has closed it */
+		bool ReadAvailable(const int pipe, std::string& pending)
+		{
+			char buffer[4096];
+
+			while (true)
+			{
+				const ssize_t readBytes(read(pipe, buffer, sizeof(buffer)));
+
+				if (readBytes > 0)
+				{
+					pending.append(buffer, static_cast<size_t>(readBytes));
+				}
+				else if (readBytes < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				else
+				{
+					return readBytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+				}
+			}
+		}
+	}
+
+	Process::~Process()
+	{
+		if (bIsStarted)
+		{
+			Kill();
+			waitpid(ProcessId, nullptr, 0);
+			close(OutputPipe);
+		}
+	}
+
+	bool Process::Start(const std::vector<std::string>& arguments, const std::string& workingDirectory, const std::vector<std::string>& environment, std::string& error)
+	{
+		assert(!bIsStarted && "Process::Start() > The process is already running!");
+		assert(!arguments.empty() && "Process::Start() > There is no program to start!");
+
+		std::vector<char*> argumentPointers{};
+		for (const std::string& argument : arguments)
+		{
+			argumentPointers.push_back(const_cast<char*>(argument.c_str()));
+		}
+		argumentPointers.push_back(nullptr);
+
+		/* The environment of this process, minus whatever environment replaces */
+		std::vector<char*> environmentPointers{};
+		if (!environment.empty())
+		{
+			for (char** pEntry{ environ }; *pEntry != nullptr; ++pEntry)
+			{
+				const bool bIsReplaced(std::any_of(environment.cbegin(), environment.cend(), [pEntry](const std::string& entry)->bool
+					{
+						const size_t nameLength(entry.find('=') + 1);
+						return std::strncmp(*pEntry, entry.c_str(), nameLength) == 0;
+					}));
+
+				if (!bIsReplaced)
+				{
+					environmentPointers.push_back(*pEntry);
+				}
+			}
+
+			for (const std::string& entry : environment)
+			{
+				environmentPointers.push_back(const_cast<char*>(entry.c_str()));
+			}
+
+			environmentPointers.push_back(nullptr);
+		}
+
+		const std::lock_guard<std::mutex> lock(SpawnMutex);
+
+		int pipeEnds[2]{};
+
+		if (pipe(pipeEnds) != 0)
+		{
+			error = std::string("could not create a pipe: ") + std::strerror(errno);
+			return false;
+		}
+
+		fcntl(pipeEnds[0], F_SETFD, FD_CLOEXEC);
+		fcntl(pipeEnds[1], F_SETFD, FD_CLOEXEC);
+
+		/* Both output streams go into the write end, nothing can be typed into it */
+		posix_spawn_file_actions_t actions{};
+		posix_spawn_file_actions_init(&actions);
+		posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+		posix_spawn_file_actions_adddup2(&actions, pipeEnds[1], STDOUT_FILENO);
+		posix_spawn_file_actions_adddup2(&actions, pipeEnds[1], STDERR_FILENO);
+
+		if (!workingDirectory.empty())
+		{
+			/* glibc 2.29, musl 1.1.24 and macOS 10.15 have it */
+			posix_spawn_file_actions_addchdir_np(&actions, workingDirectory.c_str());
+		}
+
+		/* A process group of its own, so a timeout kills whatever it started along with it */
+		posix_spawnattr_t attributes{};
+		posix_spawnattr_init(&attributes);
+		posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+		posix_spawnattr_setpgroup(&attributes, 0);
+
+		pid_t processId{};
+		const int spawnError(posix_spawnp(&processId, argumentPointers[0], &actions, &attributes, argumentPointers.data(),
+			environment.empty() ? environ : environmentPointers.data()));
+
+		posix_spawnattr_destroy(&attributes);
+		posix_spawn_file_actions_destroy(&actions);
+		close(pipeEnds[1]);
+
+		if (spawnError != 0)
+		{
+			close(pipeEnds[0]);
+			error = "could not start " + arguments[0] + ": " + std::strerror(spawnError);
+			return false;
+		}
+
+		/* Wait() polls, reading must never block */
+		fcntl(pipeEnds[0], F_SETFL, fcntl(pipeEnds[0], F_GETFL) | O_NONBLOCK);
+
+		ProcessId = processId;
+		OutputPipe = pipeEnds[0];
+		StartTime = Clock::now();
+		bIsStarted = true;
+
+		return true;
+	}
+
+	Process::Result Process::Wait(const std::function<void(const std::string_view line)>& onLine, const Clock::duration timeout)
+	{
+		assert(bIsStarted && "Process::Wait() > The process was never started!");
+
+		/* How long to wait for output before checking on the process, it can exit while something it started keeps the pipe open */
+		constexpr int pollInterval{ 100 };
+
+		const bool bHasTimeout(timeout > Clock::duration::zero());
+		bool bIsPipeOpen(true);
+		int status{};
+		Result result{};
+
+		while (true)
+		{
+			int waitTime(pollInterval);
+
+			if (bHasTimeout)
+			{
+				const auto remaining(std::chrono::duration_cast<std::chrono::milliseconds>(StartTime + timeout - Clock::now()).count());
+				waitTime = static_cast<int>(std::max<long long>(std::min<long long>(remaining, pollInterval), 0));
+			}
+
+			if (bIsPipeOpen)
+			{
+				pollfd pollEntry{ OutputPipe, POLLIN, 0 };
+
+				if (poll(&pollEntry, 1, waitTime) > 0)
+				{
+					bIsPipeOpen = ReadAvailable(OutputPipe, Pending);
+					FlushLines(onLine, false);
+				}
+			}
+			else if (!bHasTimeout)
+			{
+				/* Everything got read and there is no hurry, only the exit is left */
+				while (waitpid(ProcessId, &status, 0) < 0 && errno == EINTR)
+				{
+				}
+
+				result.ExitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+				break;
+			}
+
+			if (waitpid(ProcessId, &status, WNOHANG) == ProcessId)
+			{
+				/* Whatever it wrote before it exited */
+				if (bIsPipeOpen)
+				{
+					ReadAvailable(OutputPipe, Pending);
+				}
+
+				result.ExitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+				break;
+			}
+
+			if (bHasTimeout && Clock::now() >= StartTime + timeout)
+			{
+				Kill();
+				waitpid(ProcessId, &status, 0);
+
+				result.bTimedOut = true;
+				break;
+			}
+
+			/* Everything got read, only the exit is left, checked every millisecond until the timeout */
+			if (!bIsPipeOpen)
+			{
+				poll(nullptr, 0, std::min(waitTime, 1));
+			}
+		}
+
+		FlushLines(onLine, true);
+		result.Duration = Clock::now() - StartTime;
+
+		close(OutputPipe);
+		OutputPipe = -1;
+		ProcessId = -1;
+		bIsStarted = false;
+
+		return result;
+	}
+
+	void Process::Kill()
+	{
+		/* The whole process group */
+		kill(-ProcessId, SIGKILL);
+	}
+
+	std::string FindProgram(const std::string& name)
+	{
+		/* A path is not looked up */
+		if (name.find('/') != std::string::npos)
+		{
+			return access(name.c_str(), X_OK) == 0 ? name : std::string{};
+		}
+
+		const char* const pPath(std::getenv("PATH"));
+
+		if (pPath == nullptr)
+		{
+			return {};
+		}
+
+		std::string_view directories(pPath);
+
+		while (true)
+		{
+			const size_t end(directories.find(':'));
+			const std::string_view directory(directories.substr(0, end));
+
+			/* An empty entry is the current folder */
+			const std::string candidate((directory.empty() ? std::string(".") : std::string(directory)) + "/" + name);
+
+			if (std::error_code error{}; access(candidate.c_str(), X_OK) == 0 && std::filesystem::is_regular_file(candidate, error))
+			{
+				return candidate;
+			}
+
+			if (end == std::string_view::npos)
+			{
+				return {};
+			}
+
+			directories.remove_prefix(end + 1);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,372 @@
+#ifdef _WIN32
+
+#include "Process.h"
+
+#include <algorithm> /* std::min, std::max, std::any_of */
+#include <assert.h> /* assert() */
+#include <cstdlib> /* std::getenv */
+#include <cstring> /* std::strlen */
+#include <filesystem> /* std::filesystem::is_regular_file */
+#include <mutex> /* std::mutex, std::lock_guard */
+
+/* Windows specific includes */
+#define WIN32_LEAN_AND_MEAN /* Exclude rarely-used stuff from Windows headers */
+#include <Windows.h> /* CreateProcessA(), CreatePipe(), PeekNamedPipe(), CreateJobObjectA(), TerminateJobObject(), GetEnvironmentStringsA() */
+
+#undef max
+#undef min
+
+namespace Utils
+{
+	namespace
+	{
+		/* Held while the write end of a pipe is inheritable, so a process started on another thread can never inherit it.
+		An inherited write end would keep the pipe open until that other process exits */
+		std::mutex SpawnMutex{};
+
+		/* The quoting the C runtime of the started program undoes, so every argument arrives exactly as it was given */
+		void AppendArgument(std::string& commandLine, const std::string& argument)
+		{
+			if (!commandLine.empty())
+			{
+				commandLine.push_back(' ');
+			}
+
+			if (!argument.empty() && argument.find_first_of(" \t\n\v\"") == std::string::npos)
+			{
+				commandLine.append(argument);
+				return;
+			}
+
+			commandLine.push_back('"');
+
+			for (size_t i{}; ; ++i)
+			{
+				size_t nrOfBackslashes{};
+
+				while (i < argument.size() && argument[i] == '\\')
+				{
+					++nrOfBackslashes;
+					++i;
+				}
+
+				if (i == argument.size())
+				{
+					/* Backslashes right before the closing quote have to be escaped */
+					commandLine.append(nrOfBackslashes * 2, '\\');
+					break;
+				}
+				else if (argument[i] == '"')
+				{
+					commandLine.append(nrOfBackslashes * 2 + 1, '\\');
+					commandLine.push_back('"');
+				}
+				else
+				{
+					commandLine.append(nrOfBackslashes, '\\');
+					commandLine.push_back(argument[i]);
+				}
+			}
+
+			commandLine.push_back('"');
+		}
+
+		/* The environment block of this process, minus whatever environment replaces, plus environment.
+		Names are case insensitive on Windows */
+		std::string MakeEnvironmentBlock(const std::vector<std::string>& environment)
+		{
+			std::string block{};
+
+			if (char* const pStrings = GetEnvironmentStringsA())
+			{
+				for (const char* pEntry{ pStrings }; *pEntry != '\0'; pEntry += std::strlen(pEntry) + 1)
+				{
+					const bool bIsReplaced(std::any_of(environment.cbegin(), environment.cend(), [pEntry](const std::string& entry)->bool
+						{
+							const size_t nameLength(entry.find('=') + 1);
+							return _strnicmp(pEntry, entry.c_str(), nameLength) == 0;
+						}));
+
+					if (!bIsReplaced)
+					{
+						block.append(pEntry);
+						block.push_back('\0');
+					}
+				}
+
+				FreeEnvironmentStringsA(pStrings);
+			}
+
+			for (const std::string& entry : environment)
+			{
+				block.append(entry);
+				block.push_back('\0');
+			}
+
+			/* The block ends with an empty entry */
+			block.push_back('\0');
+
+			return block;
+		}
+
+		/* Reads whatever is in the pipe right now, returns false once every writer has closed it */
+		bool ReadAvailable(const HANDLE pipe, std::string& pending)
+		{
+			char buffer[4096];
+
+			while (true)
+			{
+				DWORD availableBytes{};
+
+				if (!PeekNamedPipe(pipe, nullptr, 0, nullptr, &availableBytes, nullptr))
+				{
+					return false;
+				}
+
+				if (availableBytes == 0)
+				{
+					return true;
+				}
+
+				DWORD readBytes{};
+
+				if (!::ReadFile(pipe, buffer, std::min<DWORD>(availableBytes, sizeof(buffer)), &readBytes, nullptr))
+				{
+					return false;
+				}
+
+				pending.append(buffer, readBytes);
+			}
+		}
+	}
+
+	Process::~Process()
+	{
+		if (bIsStarted)
+		{
+			Kill();
+			WaitForSingleObject(ProcessHandle, INFINITE);
+
+			CloseHandle(OutputPipe);
+			CloseHandle(ProcessHandle);
+			CloseHandle(JobHandle);
+		}
+	}
+
+	bool Process::Start(const std::vector<std::string>& arguments, const std::string& workingDirectory, const std::vector<std::string>& environment, std::string& error)
+	{
+		assert(!bIsStarted && "Process::Start() > The process is already running!");
+		assert(!arguments.empty() && "Process::Start() > There is no program to start!");
+
+		std::string commandLine{};
+		for (const std::string& argument : arguments)
+		{
+			AppendArgument(commandLine, argument);
+		}
+
+		std::string environmentBlock(environment.empty() ? std::string{} : MakeEnvironmentBlock(environment));
+
+		/* Everything the process starts ends up in the job as well, so a timeout can kill all of it */
+		const HANDLE job(CreateJobObjectA(nullptr, nullptr));
+
+		if (job == nullptr)
+		{
+			error = "could not create a job object (error " + std::to_string(GetLastError()) + ")";
+			return false;
+		}
+
+		const std::lock_guard<std::mutex> lock(SpawnMutex);
+
+		SECURITY_ATTRIBUTES inheritable{ sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+		HANDLE readPipe{}, writePipe{};
+
+		if (!CreatePipe(&readPipe, &writePipe, &inheritable, 0))
+		{
+			error = "could not create a pipe (error " + std::to_string(GetLastError()) + ")";
+			CloseHandle(job);
+			return false;
+		}
+
+		/* Only the write end goes to the process, nothing can be typed into it */
+		SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0);
+		const HANDLE nul(CreateFileA("NUL", GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, &inheritable, OPEN_EXISTING, 0, nullptr));
+
+		STARTUPINFOA startupInfo{};
+		startupInfo.cb = sizeof(startupInfo);
+		startupInfo.dwFlags = STARTF_USESTDHANDLES;
+		startupInfo.hStdInput = nul;
+		startupInfo.hStdOutput = writePipe;
+		startupInfo.hStdError = writePipe;
+
+		PROCESS_INFORMATION processInfo{};
+
+		/* Suspended until it is in the job, so nothing it starts can escape it */
+		const BOOL bCreated(CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, TRUE, CREATE_SUSPENDED | CREATE_NO_WINDOW,
+			environment.empty() ? nullptr : environmentBlock.data(),
+			workingDirectory.empty() ? nullptr : workingDirectory.c_str(), &startupInfo, &processInfo));
+		const DWORD createError(GetLastError());
+
+		CloseHandle(writePipe);
+
+		if (nul != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(nul);
+		}
+
+		if (!bCreated)
+		{
+			CloseHandle(readPipe);
+			CloseHandle(job);
+			error = "could not start " + arguments[0] + " (error " + std::to_string(createError) + ")";
+			return false;
+		}
+
+		AssignProcessToJobObject(job, processInfo.hProcess);
+		ResumeThread(processInfo.hThread);
+		CloseHandle(processInfo.hThread);
+
+		ProcessHandle = processInfo.hProcess;
+		JobHandle = job;
+		OutputPipe = readPipe;
+		StartTime = Clock::now();
+		bIsStarted = true;
+
+		return true;
+	}
+
+	Process::Result Process::Wait(const std::function<void(const std::string_view line)>& onLine, const Clock::duration timeout)
+	{
+		assert(bIsStarted && "Process::Wait() > The process was never started!");
+
+		/* Anonymous pipes can not be waited on, so the pipe gets checked this often */
+		constexpr DWORD pollInterval{ 10 };
+
+		const bool bHasTimeout(timeout > Clock::duration::zero());
+		bool bIsPipeOpen(true);
+		Result result{};
+
+		while (true)
+		{
+			if (bIsPipeOpen)
+			{
+				bIsPipeOpen = ReadAvailable(OutputPipe, Pending);
+				FlushLines(onLine, false);
+			}
+
+			DWORD waitTime(pollInterval);
+
+			if (bHasTimeout)
+			{
+				const auto remaining(std::chrono::duration_cast<std::chrono::milliseconds>(StartTime + timeout - Clock::now()).count());
+				waitTime = static_cast<DWORD>(std::max<long long>(std::min<long long>(remaining, pollInterval), 0));
+			}
+
+			if (WaitForSingleObject(ProcessHandle, waitTime) == WAIT_OBJECT_0)
+			{
+				/* Whatever it wrote before it exited, something it started may keep the pipe open so there is no waiting for the end of it */
+				if (bIsPipeOpen)
+				{
+					ReadAvailable(OutputPipe, Pending);
+				}
+
+				DWORD exitCode{};
+				result.ExitCode = GetExitCodeProcess(ProcessHandle, &exitCode) ? static_cast<int>(exitCode) : -1;
+				break;
+			}
+
+			if (bHasTimeout && Clock::now() >= StartTime + timeout)
+			{
+				Kill();
+				WaitForSingleObject(ProcessHandle, INFINITE);
+
+				result.bTimedOut = true;
+				break;
+			}
+		}
+
+		FlushLines(onLine, true);
+		result.Duration = Clock::now() - StartTime;
+
+		CloseHandle(OutputPipe);
+		CloseHandle(ProcessHandle);
+		CloseHandle(JobHandle);
+		OutputPipe = ProcessHandle = JobHandle = nullptr;
+		bIsStarted = false;
+
+		return result;
+	}
+
+	void Process::Kill()
+	{
+		/* The whole job */
+		TerminateJobObject(JobHandle, 1);
+	}
+
+	std::string FindProgram(const std::string& name)
+	{
+		const auto isProgram([](const std::string& path)->bool
+			{
+				std::error_code error{};
+				return std::filesystem::is_regular_file(path, error);
+			});
+
+		const auto split([](const char* const pList, const char* const pDefault)->std::vector<std::string>
+			{
+				std::vector<std::string> entries{};
+				std::string_view list(pList != nullptr ? pList : pDefault);
+
+				while (!list.empty())
+				{
+					const size_t end(std::min(list.find(';'), list.size()));
+
+					if (end > 0)
+					{
+						entries.emplace_back(list.substr(0, end));
+					}
+
+					list.remove_prefix(std::min(end + 1, list.size()));
+				}
+
+				return entries;
+			});
+
+		const std::vector<std::string> extensions(split(std::getenv("PATHEXT"), ".COM;.EXE;.BAT;.CMD"));
+
+		/* A name that already has an extension is tried as is first */
+		const auto findIn([&](const std::string& path)->std::string
+			{
+				if (std::filesystem::path(path).has_extension() && isProgram(path))
+				{
+					return path;
+				}
+
+				for (const std::string& extension : extensions)
+				{
+					if (isProgram(path + extension))
+					{
+						return path + extension;
+					}
+				}
+
+				return {};
+			});
+
+		/* A path is not looked up */
+		if (name.find_first_of("/\\") != std::string::npos)
+		{
+			return findIn(name);
+		}
+
+		for (const std::string& directory : split(std::getenv("PATH"), ""))
+		{
+			if (std::string program(findIn(directory + "\\" + name)); !program.empty())
+			{
+				return program;
+			}
+		}
+
+		return {};
+	}
+}
+
+#endif
@@ -0,0 +1,439 @@
+#include "SymbolReader.h"
+#include "ByteSearch.h" /* FindByte() */
+
+#include <cstdint> /* uint16_t, uint32_t, uint64_t */
+
+namespace Utils
+{
+	namespace IO
+	{
+		namespace
+		{
+			using ByteView = std::basic_string_view<BYTE>;
+
+			/* Every offset and size in these files comes from the file itself, so nothing is read without checking it fits first */
+			bool Fits(const ByteView data, const uint64_t offset, const uint64_t size)
+			{
+				return offset <= data.size() && size <= data.size() - offset;
+			}
+
+			uint16_t ReadLE16(const BYTE* const pData)
+			{
+				return static_cast<uint16_t>(pData[0] | pData[1] << 8);
+			}
+
+			uint32_t ReadLE32(const BYTE* const pData)
+			{
+				return static_cast<uint32_t>(pData[0]) | static_cast<uint32_t>(pData[1]) << 8 | static_cast<uint32_t>(pData[2]) << 16 | static_cast<uint32_t>(pData[3]) << 24;
+			}
+
+			uint64_t ReadLE64(const BYTE* const pData)
+			{
+				return static_cast<uint64_t>(ReadLE32(pData)) | static_cast<uint64_t>(ReadLE32(pData + 4)) << 32;
+			}
+
+			uint32_t ReadBE32(const BYTE* const pData)
+			{
+				return static_cast<uint32_t>(pData[0]) << 24 | static_cast<uint32_t>(pData[1]) << 16 | static_cast<uint32_t>(pData[2]) << 8 | static_cast<uint32_t>(pData[3]);
+			}
+
+			uint64_t ReadBE64(const BYTE* const pData)
+			{
+				return static_cast<uint64_t>(ReadBE32(pData)) << 32 | static_cast<uint64_t>(ReadBE32(pData + 4));
+			}
+
+			/* The '\0' terminated string at offset, or everything up to the end of data if it is not terminated */
+			std::string_view ReadString(const ByteView data, const uint64_t offset)
+			{
+				if (offset >= data.size())
+				{
+					return {};
+				}
+
+				const size_t end(FindByte(data, 0, static_cast<size_t>(offset)));
+				const size_t length((end == NotFound ? data.size() : end) - static_cast<size_t>(offset));
+
+				return std::string_view(reinterpret_cast<const char*>(data.data() + offset), length);
+			}
+
+			/* The space padded decimal numbers of an archive member header */
+			bool ReadDecimal(const BYTE* pField, const size_t fieldSize, uint64_t& value)
+			{
+				value = 0;
+				size_t i{};
+
+				for (; i < fieldSize && pField[i] >= '0' && pField[i] <= '9'; ++i)
+				{
+					value = value * 10 + (pField[i] - '0');
+				}
+
+				return i > 0;
+			}
+
+			/* ELF, little endian only: every symbol table section, with the string table it links to */
+			bool ReadELF(const ByteView data, std::vector<std::string_view>& symbols)
+			{
+				constexpr uint32_t symbolTableType{ 2 }; /* SHT_SYMTAB */
+				constexpr uint8_t sectionType{ 3 }, fileType{ 4 }; /* STT_SECTION, STT_FILE */
+				constexpr uint8_t globalBinding{ 1 }, weakBinding{ 2 }, uniqueBinding{ 10 }; /* STB_GLOBAL, STB_WEAK, STB_GNU_UNIQUE */
+
+				if (data.size() < 52 || data[0] != 0x7F || data[1] != 'E' || data[2] != 'L' || data[3] != 'F' || data[5] != 1)
+				{
+					return false;
+				}
+
+				const bool b64Bit(data[4] == 2);
+
+				if (!b64Bit && data[4] != 1)
+				{
+					return false;
+				}
+
+				if (b64Bit && data.size() < 64)
+				{
+					return false;
+				}
+
+				const uint64_t sectionTable(b64Bit ? ReadLE64(data.data() + 0x28) : ReadLE32(data.data() + 0x20));
+				const uint16_t sectionSize(ReadLE16(data.data() + (b64Bit ? 0x3A : 0x2E)));
+				const uint16_t nrOfSections(ReadLE16(data.data() + (b64Bit ? 0x3C : 0x30)));
+
+				if (sectionSize < (b64Bit ? 64 : 40) || !Fits(data, sectionTable, static_cast<uint64_t>(sectionSize) * nrOfSections))
+				{
+					return false;
+				}
+
+				const auto getSection([&](const uint32_t index, uint64_t& offset, uint64_t& size)->const BYTE*
+					{
+						const BYTE* pSection(data.data() + sectionTable + static_cast<uint64_t>(sectionSize) * index);
+
+						offset = b64Bit ? ReadLE64(pSection + 0x18) : ReadLE32(pSection + 0x10);
+						size = b64Bit ? ReadLE64(pSection + 0x20) : ReadLE32(pSection + 0x14);
+
+						return pSection;
+					});
+
+				for (uint32_t i{}; i < nrOfSections; ++i)
+				{
+					uint64_t offset{}, size{};
+					const BYTE* pSection(getSection(i, offset, size));
+
+					if (ReadLE32(pSection + 4) != symbolTableType)
+					{
+						continue;
+					}
+
+					const uint32_t link(ReadLE32(pSection + (b64Bit ? 0x28 : 0x18)));
+					const uint64_t symbolSize(b64Bit ? 24 : 16);
+
+					uint64_t stringsOffset{}, stringsSize{};
+
+					if (link >= nrOfSections || !Fits(data, offset, size))
+					{
+						continue;
+					}
+
+					getSection(link, stringsOffset, stringsSize);
+
+					if (!Fits(data, stringsOffset, stringsSize))
+					{
+						continue;
+					}
+
+					const ByteView strings(data.substr(static_cast<size_t>(stringsOffset), static_cast<size_t>(stringsSize)));
+
+					for (uint64_t symbol(offset); symbol + symbolSize <= offset + size; symbol += symbolSize)
+					{
+						const BYTE* pSymbol(data.data() + symbol);
+						const uint8_t info(b64Bit ? pSymbol[4] : pSymbol[12]);
+						const uint16_t sectionIndex(ReadLE16(pSymbol + (b64Bit ? 6 : 14)));
+						const uint8_t binding(info >> 4), type(info & 0xF);
+
+						/* Defined, visible to other objects, and neither a section nor a file name */
+						if (sectionIndex != 0 && (binding == globalBinding || binding == weakBinding || binding == uniqueBinding) && type != sectionType && type != fileType)
+						{
+							if (const std::string_view name(ReadString(strings, ReadLE32(pSymbol))); !name.empty())
+							{
+								symbols.push_back(name);
+							}
+						}
+					}
+				}
+
+				return true;
+			}
+
+			/* COFF objects as MSVC writes them, /bigobj objects, and the short import objects of import libraries */
+			bool ReadCOFF(const ByteView data, std::vector<std::string_view>& symbols)
+			{
+				constexpr BYTE bigObjectClass[16]{ 0xC7, 0xA1, 0xBA, 0xD1, 0xEE, 0xBA, 0xA9, 0x4B, 0xAF, 0x20, 0xFA, 0xF6, 0x6A, 0xA4, 0xDC, 0xB8 };
+				constexpr uint8_t externalClass{ 2 }; /* IMAGE_SYM_CLASS_EXTERNAL */
+
+				if (data.size() < 20)
+				{
+					return false;
+				}
+
+				uint64_t symbolTable{}, nrOfSymbols{}, symbolSize{ 18 };
+				bool bIsBigObject{};
+
+				if (ReadLE16(data.data()) == 0 && ReadLE16(data.data() + 2) == 0xFFFF)
+				{
+					/* An import object is its header followed by the name of the symbol and the name of the .dll */
+					if (ReadLE16(data.data() + 4) == 0)
+					{
+						if (const std::string_view name(ReadString(data, 20)); !name.empty())
+						{
+							symbols.push_back(name);
+						}
+
+						return true;
+					}
+
+					if (data.size() < 56 || ByteView(data.data() + 12, 16) != ByteView(bigObjectClass, 16))
+					{
+						return false;
+					}
+
+					bIsBigObject = true;
+					symbolTable = ReadLE32(data.data() + 48);
+					nrOfSymbols = ReadLE32(data.data() + 52);
+					symbolSize = 20;
+				}
+				else
+				{
+					/* Random bytes are not an object file */
+					switch (ReadLE16(data.data()))
+					{
+					case 0x014C: /* x86 */
+					case 0x8664: /* x64 */
+					case 0x01C0: /* ARM */
+					case 0x01C4: /* ARMv7 */
+					case 0xAA64: /* ARM64 */
+					case 0xA641: /* ARM64EC */
+					case 0xA64E: /* ARM64X */
+						break;
+					default:
+						return false;
+					}
+
+					symbolTable = ReadLE32(data.data() + 8);
+					nrOfSymbols = ReadLE32(data.data() + 12);
+				}
+
+				if (!Fits(data, symbolTable, nrOfSymbols * symbolSize))
+				{
+					return false;
+				}
+
+				/* The string table for the long names starts with its own size */
+				const uint64_t stringsOffset(symbolTable + nrOfSymbols * symbolSize);
+				ByteView strings{};
+
+				if (Fits(data, stringsOffset, 4) && Fits(data, stringsOffset, ReadLE32(data.data() + stringsOffset)))
+				{
+					strings = data.substr(static_cast<size_t>(stringsOffset), ReadLE32(data.data() + stringsOffset));
+				}
+
+				for (uint64_t i{}; i < nrOfSymbols; ++i)
+				{
+					const BYTE* pSymbol(data.data() + symbolTable + i * symbolSize);
+
+					const int32_t section(bIsBigObject ? static_cast<int32_t>(ReadLE32(pSymbol + 12)) : static_cast<int16_t>(ReadLE16(pSymbol + 12)));
+					const uint8_t storageClass(pSymbol[bIsBigObject ? 18 : 16]);
+					const uint8_t nrOfAuxiliarySymbols(pSymbol[bIsBigObject ? 19 : 17]);
+
+					if (storageClass == externalClass && section > 0)
+					{
+						std::string_view name{};
+
+						/* Names of up to 8 characters are stored in place, longer ones in the string table */
+						if (ReadLE32(pSymbol) == 0)
+						{
+							name = ReadString(strings, ReadLE32(pSymbol + 4));
+						}
+						else
+						{
+							name = ReadString(ByteView(pSymbol, 8), 0);
+						}
+
+						if (!name.empty())
+						{
+							symbols.push_back(name);
+						}
+					}
+
+					i += nrOfAuxiliarySymbols;
+				}
+
+				return true;
+			}
+
+			bool ReadObject(const ByteView data, std::vector<std::string_view>& symbols)
+			{
+				return ReadELF(data, symbols) || ReadCOFF(data, symbols);
+			}
+
+			/* The symbol index of GNU archives and the first linker member of .lib files: a big endian count, as many member offsets
+			and then as many '\0' terminated names. The 64 bit version has 8 byte counts and offsets */
+			void ReadGNUIndex(const ByteView index, const bool b64Bit, std::vector<std::string_view>& symbols)
+			{
+				const uint64_t fieldSize(b64Bit ? 8 : 4);
+
+				if (index.size() < fieldSize)
+				{
+					return;
+				}
+
+				const uint64_t nrOfSymbols(b64Bit ? ReadBE64(index.data()) : ReadBE32(index.data()));
+
+				if (nrOfSymbols > index.size() / fieldSize)
+				{
+					return;
+				}
+
+				uint64_t name(fieldSize + nrOfSymbols * fieldSize);
+
+				for (uint64_t i{}; i < nrOfSymbols && name < index.size(); ++i)
+				{
+					const std::string_view symbol(ReadString(index, name));
+					name += symbol.size() + 1;
+
+					if (!symbol.empty())
+					{
+						symbols.push_back(symbol);
+					}
+				}
+			}
+
+			/* __.SYMDEF of BSD and macOS archives: the size of an array of (name offset, member offset) pairs, the array,
+			then the size of the names and the names, all little endian */
+			void ReadBSDIndex(const ByteView index, const bool b64Bit, std::vector<std::string_view>& symbols)
+			{
+				const uint64_t fieldSize(b64Bit ? 8 : 4);
+				const auto readField([b64Bit](const BYTE* pField)->uint64_t
+					{
+						return b64Bit ? ReadLE64(pField) : ReadLE32(pField);
+					});
+
+				if (!Fits(index, 0, fieldSize))
+				{
+					return;
+				}
+
+				const uint64_t entriesSize(readField(index.data()));
+
+				if (!Fits(index, fieldSize, entriesSize) || !Fits(index, fieldSize + entriesSize, fieldSize))
+				{
+					return;
+				}
+
+				const uint64_t namesOffset(fieldSize * 2 + entriesSize);
+				const uint64_t namesSize(readField(index.data() + fieldSize + entriesSize));
+
+				if (!Fits(index, namesOffset, namesSize))
+				{
+					return;
+				}
+
+				const ByteView names(index.substr(static_cast<size_t>(namesOffset), static_cast<size_t>(namesSize)));
+
+				for (uint64_t entry(fieldSize); entry + fieldSize * 2 <= fieldSize + entriesSize; entry += fieldSize * 2)
+				{
+					if (const std::string_view symbol(ReadString(names, readField(index.data() + entry))); !symbol.empty())
+					{
+						symbols.push_back(symbol);
+					}
+				}
+			}
+
+			/* An ar archive: "!<arch>\n" followed by members, each with a 60 byte header and padded to an even size */
+			void ReadArchive(const ByteView data, std::vector<std::string_view>& symbols)
+			{
+				constexpr size_t headerSize{ 60 };
+
+				bool bHasIndex{};
+				uint64_t member{ 8 };
+
+				while (Fits(data, member, headerSize))
+				{
+					const BYTE* pHeader(data.data() + member);
+					uint64_t size{};
+
+					if (pHeader[58] != '`' || pHeader[59] != '\n' || !ReadDecimal(pHeader + 48, 10, size) || !Fits(data, member + headerSize, size))
+					{
+						return;
+					}
+
+					std::string_view name(reinterpret_cast<const char*>(pHeader), 16);
+					name = name.substr(0, name.find_last_not_of(' ') + 1);
+
+					ByteView contents(data.substr(static_cast<size_t>(member + headerSize), static_cast<size_t>(size)));
+					member += headerSize + size + (size & 1);
+
+					/* BSD puts long names in front of the contents: #1/<length> */
+					if (name.substr(0, 3) == "#1/")
+					{
+						uint64_t nameSize{};
+
+						if (!ReadDecimal(pHeader + 3, 13, nameSize) || nameSize > contents.size())
+						{
+							return;
+						}
+
+						name = ReadString(contents.substr(0, static_cast<size_t>(nameSize)), 0);
+						contents.remove_prefix(static_cast<size_t>(nameSize));
+					}
+
+					if (name == "/" || name == "/SYM64/")
+					{
+						/* A .lib has a second linker member with the same names, only the first is needed */
+						if (!bHasIndex)
+						{
+							ReadGNUIndex(contents, name == "/SYM64/", symbols);
+						}
+
+						bHasIndex = true;
+					}
+					else if (name.substr(0, 9) == "__.SYMDEF")
+					{
+						if (!bHasIndex)
+						{
+							ReadBSDIndex(contents, name.substr(0, 12) == "__.SYMDEF_64", symbols);
+						}
+
+						bHasIndex = true;
+					}
+					else if (name == "//" || name.substr(0, 2) == "/<")
+					{
+						/* The long names, and the symbols of the x64 half of an ARM64EC library */
+						continue;
+					}
+					else if (bHasIndex)
+					{
+						/* The index lists the symbols of every member, and always comes first */
+						return;
+					}
+					else
+					{
+						/* Anything else in an archive, like a resource or a text file, is just skipped */
+						ReadObject(contents, symbols);
+					}
+				}
+			}
+		}
+
+		bool ReadDefinedSymbols(const std::basic_string_view<BYTE> data, std::vector<std::string_view>& symbols)
+		{
+			constexpr std::string_view archiveMagic("!<arch>\n");
+
+			if (data.size() >= archiveMagic.size() && std::string_view(reinterpret_cast<const char*>(data.data()), archiveMagic.size()) == archiveMagic)
+			{
+				ReadArchive(data, symbols);
+				return true;
+			}
+
+			return ReadObject(data, symbols);
+		}
+	}
+}
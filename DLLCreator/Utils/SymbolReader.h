@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Utils.h" /* BYTE */
+
+#include <string_view> /* std::string_view, std::basic_string_view */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace IO
+	{
+		/* Appends the defined external symbols of a static library (.lib, .a) or object file (.obj, .o) in data to symbols,
+		as views into data, so data has to outlive them. Mapping the file with MapFile() is the fastest way in.
+		Archives are read through the symbol index the librarian puts in front of them, which keeps the rest of the file untouched,
+		only an archive without one has the symbol tables of its members read. Members and object files can be COFF
+		(bigobj and import objects included) or little endian ELF. Returns false if data is none of these */
+		bool ReadDefinedSymbols(const std::basic_string_view<BYTE> data, std::vector<std::string_view>& symbols);
+	}
+}
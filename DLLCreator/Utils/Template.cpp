@@ -0,0 +1,33 @@
+#include "Template.h"
+
+#include <assert.h> /* assert() */
+
+namespace Utils
+{
+	void Template::Render(const std::initializer_list<std::string_view> values, std::string& output) const
+	{
+		assert(values.size() == NrOfSlots && "Template::Render() > Every slot needs exactly one value!");
+
+		const std::string_view* const pValues(values.begin());
+
+		/* Size the buffer once, then only append */
+		size_t size{};
+		for (const TemplateChunk& chunk : Chunks)
+		{
+			size += chunk.Literal.size() + (chunk.Slot != NoTemplateSlot ? pValues[chunk.Slot].size() : 0);
+		}
+
+		output.clear();
+		output.reserve(size);
+
+		for (const TemplateChunk& chunk : Chunks)
+		{
+			output.append(chunk.Literal);
+
+			if (chunk.Slot != NoTemplateSlot)
+			{
+				output.append(pValues[chunk.Slot]);
+			}
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array> /* std::array */
+#include <initializer_list> /* std::initializer_list */
+#include <span> /* std::span */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+
+namespace Utils
+{
+	/* Literal text, followed by a slot (unless it is the last chunk) */
+	struct TemplateChunk final
+	{
+		std::string_view Literal;
+		size_t Slot;
+	};
+
+	inline constexpr size_t NoTemplateSlot{ static_cast<size_t>(-1) };
+
+	/* Returns the position of whichever slot name comes first from searchPos on, npos if there is none.
+	This only runs at compile time, so it does not need to be clever */
+	constexpr size_t FindNextTemplateSlot(const std::string_view text, const size_t searchPos, const std::span<const std::string_view> slotNames, size_t& slot)
+	{
+		size_t earliest{ std::string_view::npos };
+
+		for (size_t i{}; i < slotNames.size(); ++i)
+		{
+			if (const size_t pos(text.find(slotNames[i], searchPos)); pos < earliest)
+			{
+				earliest = pos;
+				slot = i;
+			}
+		}
+
+		return earliest;
+	}
+
+	/* The size of the array ParseTemplate() needs */
+	constexpr size_t CountTemplateChunks(const std::string_view text, const std::span<const std::string_view> slotNames)
+	{
+		size_t nrOfChunks{ 1 };
+		size_t slot{};
+
+		for (size_t pos(FindNextTemplateSlot(text, 0, slotNames, slot)); pos != std::string_view::npos; pos = FindNextTemplateSlot(text, pos + slotNames[slot].size(), slotNames, slot))
+		{
+			++nrOfChunks;
+		}
+
+		return nrOfChunks;
+	}
+
+	/* Splits text into literal chunks and slots, every occurrence of slotNames[i] (e.g. "<PROJECT_NAME>") becomes slot i.
+	Anything that looks like a placeholder but is not in slotNames stays literal text. The chunks point into text */
+	template<size_t NrOfChunks>
+	constexpr std::array<TemplateChunk, NrOfChunks> ParseTemplate(const std::string_view text, const std::span<const std::string_view> slotNames)
+	{
+		std::array<TemplateChunk, NrOfChunks> chunks{};
+
+		size_t literalBegin{};
+		size_t chunk{};
+		size_t slot{};
+
+		for (size_t pos(FindNextTemplateSlot(text, 0, slotNames, slot)); pos != std::string_view::npos; pos = FindNextTemplateSlot(text, literalBegin, slotNames, slot))
+		{
+			chunks[chunk++] = TemplateChunk{ text.substr(literalBegin, pos - literalBegin), slot };
+			literalBegin = pos + slotNames[slot].size();
+		}
+
+		/* Whatever follows the last slot */
+		chunks[chunk] = TemplateChunk{ text.substr(literalBegin), NoTemplateSlot };
+
+		return chunks;
+	}
+
+	/* A parsed template, so rendering is a single pass of appends.
+	It only refers to the chunks made by ParseTemplate(), which normally live in a constexpr array */
+	class Template final
+	{
+	public:
+		constexpr Template(const std::span<const TemplateChunk> chunks, const size_t nrOfSlots)
+			: Chunks{ chunks }
+			, NrOfSlots{ nrOfSlots }
+		{}
+
+		/* values[i] is substituted for slot i, values.size() has to match the number of slot names.
+		output is overwritten but keeps its capacity, so reusing the same buffer avoids allocating per render */
+		void Render(const std::initializer_list<std::string_view> values, std::string& output) const;
+
+		constexpr size_t GetNumberOfSlots() const { return NrOfSlots; }
+
+	private:
+		std::span<const TemplateChunk> Chunks;
+		size_t NrOfSlots;
+	};
+}
@@ -0,0 +1,119 @@
+#include "ByteSearch.h"
+
+#include <cstdio> /* std::printf */
+#include <random> /* std::mt19937 */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+
+/* Checks FindByte(), FindSubstring() and FindByteUnbounded() against std::string_view::find() on every kernel this machine can run.
+Texts come from a small alphabet so there are plenty of partial and full matches, and every offset is tried, including those past the end */
+
+namespace
+{
+	size_t Failures{};
+
+	void Check(const char* const pWhat, const size_t expected, const size_t actual, const size_t size, const size_t offset)
+	{
+		if (expected != actual)
+		{
+			++Failures;
+			std::printf("  %s: size %zu, offset %zu, expected %zu, got %zu\n", pWhat, size, offset, expected, actual);
+		}
+	}
+
+	std::string RandomText(std::mt19937& random, const size_t size)
+	{
+		std::uniform_int_distribution<int> letter('a', 'd');
+
+		std::string text(size, '\0');
+		for (char& c : text)
+		{
+			c = static_cast<char>(letter(random));
+		}
+
+		return text;
+	}
+
+	void TestFindByte(std::mt19937& random)
+	{
+		for (size_t size{}; size <= 130; ++size)
+		{
+			const std::string text(RandomText(random, size));
+			const std::string_view view(text);
+
+			for (const char value : { 'a', 'd', 'z' })
+			{
+				for (size_t offset{}; offset <= size + 1; ++offset)
+				{
+					Check("FindByte", view.find(value, offset), Utils::IO::FindByte(view, value, offset), size, offset);
+				}
+			}
+		}
+	}
+
+	void TestFindSubstring(std::mt19937& random)
+	{
+		for (size_t size{}; size <= 100; size += 3)
+		{
+			const std::string text(RandomText(random, size));
+			const std::string_view view(text);
+
+			for (size_t needleSize{}; needleSize <= 40; ++needleSize)
+			{
+				/* One needle that is known to occur, and one that usually only matches in part */
+				const std::string present(needleSize <= size ? text.substr(size - needleSize) : RandomText(random, needleSize));
+				const std::string partial(RandomText(random, needleSize));
+
+				for (const std::string_view needle : { std::string_view(present), std::string_view(partial) })
+				{
+					for (size_t offset{}; offset <= size + 1; ++offset)
+					{
+						Check("FindSubstring", view.find(needle, offset), Utils::IO::FindSubstring(view, needle, offset), size, offset);
+					}
+				}
+			}
+		}
+	}
+
+	void TestFindByteUnbounded(std::mt19937& random)
+	{
+		/* Every start alignment, with the value at every distance up to a few blocks */
+		for (size_t start{}; start < 32; ++start)
+		{
+			for (size_t length{}; length <= 80; ++length)
+			{
+				std::string text(RandomText(random, start + length));
+				text.push_back('\0');
+
+				const std::string_view view(text.data() + start, length + 1);
+				Check("FindByteUnbounded", view.find('\0'), Utils::IO::FindByteUnbounded(reinterpret_cast<const BYTE*>(view.data()), '\0'), length, start);
+			}
+		}
+	}
+}
+
+int main()
+{
+	std::printf("Default kernel: %s\n", Utils::IO::GetByteSearchKernelName());
+
+	for (const char* const pKernel : { "Scalar", "SSE2", "AVX2" })
+	{
+		if (!Utils::IO::UseByteSearchKernel(pKernel))
+		{
+			std::printf("%s: not available, skipped\n", pKernel);
+			continue;
+		}
+
+		const size_t failuresBefore(Failures);
+
+		/* The same seed for every kernel, so they all see the same texts */
+		std::mt19937 random(42);
+		TestFindByte(random);
+		TestFindSubstring(random);
+		TestFindByteUnbounded(random);
+
+		std::printf("%s: %s\n", pKernel, Failures == failuresBefore ? "passed" : "FAILED");
+	}
+
+	return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include "HeaderParser.h"
+
+#include <cstdio> /* std::printf */
+#include <iterator> /* std::size */
+#include <string> /* std::string */
+#include <string_view> /* std::string_view */
+#include <vector> /* std::vector */
+
+/* Checks which names ParseDeclarations() reports, mostly around bodies it skips: what follows the '}' has to be found again */
+
+namespace
+{
+	struct TestCase final
+	{
+		const char* pText;
+		const char* pExpected; /* the reported names, separated by spaces */
+	};
+
+	const TestCase TestCases[]
+	{
+		/* Out-of-class definitions are not reported, but end at their '}' */
+		{ "class A { public: void f(); };\ninline void A::f() {}\nint Foo();\nint Bar();", "A f Foo Bar" },
+		{ "void Engine::Run() {}\nstatic int Dup() { return 1; }", "Dup" },
+		{ "Engine::Engine() : Value{ 0 }, Other(1) {}\nint Foo();", "Foo" },
+		{ "template<int N = 3> void A<N>::f() {}\nint Foo();", "Foo" },
+		{ "A& A::operator=(const A& other) { return *this; }\nint Foo();", "Foo" },
+		{ "void A::f() const noexcept {}\nvoid A::g() -> void {}\nint Foo();", "Foo" },
+
+		/* Whatever follows the '}' of a class, enum or initializer belongs to the same declaration */
+		{ "struct S { int x; } s, Hidden();\nint Foo();", "S Foo" },
+		{ "enum E { One, Two } e;\nint Foo();", "Foo" },
+		{ "int i{ 0 }, Hidden();\nint Foo();", "Foo" },
+		{ "int x = Get() + S{ 1 }.y, Hidden();\nint Foo();", "Foo" },
+		{ "auto f = [](int i) { return i; };\nint Foo();", "Foo" }
+	};
+
+	std::string ReportedNames(const std::string_view text)
+	{
+		std::vector<Utils::Cpp::Declaration> declarations{};
+		Utils::Cpp::ParseDeclarations(text, declarations);
+
+		std::string names{};
+		for (const Utils::Cpp::Declaration& declaration : declarations)
+		{
+			if (!names.empty())
+			{
+				names += ' ';
+			}
+
+			names += text.substr(declaration.NameBegin, declaration.NameEnd - declaration.NameBegin);
+		}
+
+		return names;
+	}
+}
+
+int main()
+{
+	size_t failures{};
+
+	for (const TestCase& testCase : TestCases)
+	{
+		const std::string names(ReportedNames(testCase.pText));
+
+		if (names != testCase.pExpected)
+		{
+			++failures;
+			std::printf("FAILED:\n%s\n  expected \"%s\", got \"%s\"\n", testCase.pText, testCase.pExpected, names.c_str());
+		}
+	}
+
+	std::printf("%zu of %zu passed\n", std::size(TestCases) - failures, std::size(TestCases));
+	return failures == 0 ? 0 : 1;
+}
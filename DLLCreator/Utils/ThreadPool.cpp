@@ -0,0 +1,94 @@
+#include "ThreadPool.h"
+
+#include <algorithm> /* std::max */
+#include <utility> /* std::move */
+
+namespace Utils
+{
+	ThreadPool::ThreadPool(size_t nrOfThreads)
+	{
+		if (nrOfThreads == 0)
+		{
+			/* hardware_concurrency() is allowed to return 0 when it does not know */
+			nrOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+
+		Workers.reserve(nrOfThreads);
+
+		for (size_t i{}; i < nrOfThreads; ++i)
+		{
+			Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(Mutex);
+			bIsStopping = true;
+		}
+
+		JobAvailable.notify_all();
+
+		for (std::thread& worker : Workers)
+		{
+			worker.join();
+		}
+	}
+
+	void ThreadPool::Submit(std::function<void()> job)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(Mutex);
+			Jobs.push_back(std::move(job));
+			++NrOfUnfinishedJobs;
+		}
+
+		JobAvailable.notify_one();
+	}
+
+	void ThreadPool::Wait()
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		AllJobsDone.wait(lock, [this]()->bool
+			{
+				return NrOfUnfinishedJobs == 0;
+			});
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job{};
+
+			{
+				std::unique_lock<std::mutex> lock(Mutex);
+				JobAvailable.wait(lock, [this]()->bool
+					{
+						return bIsStopping || !Jobs.empty();
+					});
+
+				/* Only stop once the queue has been drained, so no submitted job gets lost */
+				if (Jobs.empty())
+				{
+					return;
+				}
+
+				job = std::move(Jobs.front());
+				Jobs.pop_front();
+			}
+
+			job();
+
+			{
+				const std::lock_guard<std::mutex> lock(Mutex);
+
+				if (--NrOfUnfinishedJobs == 0)
+				{
+					AllJobsDone.notify_all();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable> /* std::condition_variable */
+#include <cstddef> /* size_t */
+#include <deque> /* std::deque */
+#include <functional> /* std::function */
+#include <mutex> /* std::mutex */
+#include <thread> /* std::thread */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	/* Fixed amount of worker threads pulling jobs from one queue. Jobs run in submission order,
+	but finish in any order, so jobs should write their results into a slot they own */
+	class ThreadPool final
+	{
+	public:
+		/* 0 threads means one per hardware thread */
+		explicit ThreadPool(size_t nrOfThreads = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) noexcept = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+		void Submit(std::function<void()> job);
+
+		/* Blocks until every submitted job has finished */
+		void Wait();
+
+		size_t GetNumberOfThreads() const { return Workers.size(); }
+
+	private:
+		void WorkerLoop();
+
+		std::vector<std::thread> Workers{};
+		std::deque<std::function<void()>> Jobs{};
+		std::mutex Mutex{};
+		std::condition_variable JobAvailable{};
+		std::condition_variable AllJobsDone{};
+		size_t NrOfUnfinishedJobs{};
+		bool bIsStopping{};
+	};
+}
@@ -0,0 +1,148 @@
+#include "Trace.h"
+
+#include <algorithm> /* std::min_element, std::find, std::count_if */
+#include <utility> /* std::move, std::pair */
+
+namespace Utils
+{
+	namespace Trace
+	{
+		void Recorder::Enable(std::string processName)
+		{
+			const std::lock_guard<std::mutex> lock(Mutex);
+
+			ProcessNames[0] = std::move(processName);
+			bEnabled = true;
+		}
+
+		void Recorder::AddEvent(std::string name, const char* pCategory, const Clock::time_point begin, const Clock::time_point end, Json::Value args)
+		{
+			if (!bEnabled)
+			{
+				return;
+			}
+
+			const std::lock_guard<std::mutex> lock(Mutex);
+
+			Events.push_back(Event{ std::move(name), pCategory, begin, end, std::this_thread::get_id(), 0, std::move(args) });
+		}
+
+		void Recorder::Append(const Recorder& other)
+		{
+			if (!bEnabled)
+			{
+				return;
+			}
+
+			const std::scoped_lock lock(Mutex, other.Mutex);
+
+			const uint32_t firstProcess(static_cast<uint32_t>(ProcessNames.size()));
+			ProcessNames.insert(ProcessNames.end(), other.ProcessNames.cbegin(), other.ProcessNames.cend());
+
+			for (const Event& event : other.Events)
+			{
+				Events.push_back(event);
+				Events.back().Process += firstProcess;
+			}
+		}
+
+		std::string Recorder::WriteChromeTrace() const
+		{
+			using namespace Json;
+
+			const std::lock_guard<std::mutex> lock(Mutex);
+
+			Value events(Value::MakeArray());
+
+			for (size_t i{}; i < ProcessNames.size(); ++i)
+			{
+				if (ProcessNames[i].empty())
+				{
+					continue;
+				}
+
+				Value args(Value::MakeObject());
+				args.Set("name", Value::MakeString(ProcessNames[i]));
+
+				Value metadata(Value::MakeObject());
+				metadata.Set("name", Value::MakeString("process_name"));
+				metadata.Set("ph", Value::MakeString("M"));
+				metadata.Set("pid", Value::MakeNumber(static_cast<double>(i)));
+				metadata.Set("args", std::move(args));
+
+				events.Append(std::move(metadata));
+			}
+
+			if (!Events.empty())
+			{
+				const Clock::time_point start(std::min_element(Events.cbegin(), Events.cend(), [](const Event& a, const Event& b)->bool
+					{
+						return a.Begin < b.Begin;
+					})->Begin);
+
+				const auto toMicroseconds([](const Clock::duration duration)->double
+					{
+						return std::chrono::duration<double, std::micro>(duration).count();
+					});
+
+				/* Threads get numbered per process in the order they show up, the ids of the runtime mean nothing to a reader */
+				std::vector<std::pair<uint32_t, std::thread::id>> threads{};
+
+				for (const Event& event : Events)
+				{
+					const size_t threadIndex(std::find(threads.cbegin(), threads.cend(), std::make_pair(event.Process, event.Thread)) - threads.cbegin());
+
+					if (threadIndex == threads.size())
+					{
+						threads.emplace_back(event.Process, event.Thread);
+					}
+
+					/* The threads of the same process that showed up before this one */
+					const size_t thread(std::count_if(threads.cbegin(), threads.cbegin() + threadIndex, [&event](const std::pair<uint32_t, std::thread::id>& other)
+						{
+							return other.first == event.Process;
+						}));
+
+					/* A complete event, with its duration */
+					Value traceEvent(Value::MakeObject());
+					traceEvent.Set("name", Value::MakeString(event.Name));
+					traceEvent.Set("cat", Value::MakeString(event.pCategory));
+					traceEvent.Set("ph", Value::MakeString("X"));
+					traceEvent.Set("ts", Value::MakeNumber(toMicroseconds(event.Begin - start)));
+					traceEvent.Set("dur", Value::MakeNumber(toMicroseconds(event.End - event.Begin)));
+					traceEvent.Set("pid", Value::MakeNumber(static_cast<double>(event.Process)));
+					traceEvent.Set("tid", Value::MakeNumber(static_cast<double>(thread)));
+
+					if (event.Args.IsObject())
+					{
+						traceEvent.Set("args", event.Args);
+					}
+
+					events.Append(std::move(traceEvent));
+				}
+			}
+
+			Value trace(Value::MakeObject());
+			trace.Set("traceEvents", std::move(events));
+			trace.Set("displayTimeUnit", Value::MakeString("ms"));
+
+			return Write(trace);
+		}
+
+		ScopedTimer::ScopedTimer(Recorder& recorder, std::string name, const char* pCategory, Clock::duration& total)
+			: TraceRecorder(recorder)
+			, Name(std::move(name))
+			, pCategory(pCategory)
+			, Total(total)
+			, Begin(Clock::now())
+		{}
+
+		ScopedTimer::~ScopedTimer()
+		{
+			const Clock::time_point end(Clock::now());
+
+			Total += end - Begin;
+			TraceRecorder.AddEvent(std::move(Name), pCategory, Begin, end);
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Json.h" /* Json::Value */
+
+#include <chrono> /* std::chrono::steady_clock */
+#include <cstdint> /* uint32_t */
+#include <mutex> /* std::mutex */
+#include <string> /* std::string */
+#include <thread> /* std::thread::id */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	namespace Trace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		/* Timed events of a run, written out in the Chrome trace event format, which chrome://tracing and ui.perfetto.dev open.
+		A recorder starts out disabled and drops every event, so the timing code can stay in place when nobody asked for a trace */
+		class Recorder final
+		{
+		public:
+			Recorder() = default;
+
+			Recorder(const Recorder&) = delete;
+			Recorder& operator=(const Recorder&) = delete;
+
+			/* processName is what the trace calls the events of this recorder */
+			void Enable(std::string processName);
+			bool IsEnabled() const { return bEnabled; }
+
+			/* Safe to call from any thread, the event is put on the track of the calling thread.
+			args is shown next to the event, it has to be an object (or null for none) */
+			void AddEvent(std::string name, const char* pCategory, const Clock::time_point begin, const Clock::time_point end, Json::Value args = {});
+
+			/* Every event of other becomes part of this trace, with other as a process of its own */
+			void Append(const Recorder& other);
+
+			/* Times are in microseconds since the first event */
+			std::string WriteChromeTrace() const;
+
+		private:
+			struct Event final
+			{
+				std::string Name;
+				const char* pCategory;
+				Clock::time_point Begin;
+				Clock::time_point End;
+				std::thread::id Thread;
+				uint32_t Process; /* into ProcessNames */
+				Json::Value Args;
+			};
+
+			std::vector<std::string> ProcessNames{ std::string{} };
+			std::vector<Event> Events{};
+			mutable std::mutex Mutex{};
+			bool bEnabled{};
+		};
+
+		/* Adds the time between its construction and destruction to total, and records it as an event if recorder is enabled */
+		class ScopedTimer final
+		{
+		public:
+			ScopedTimer(Recorder& recorder, std::string name, const char* pCategory, Clock::duration& total);
+			~ScopedTimer();
+
+			ScopedTimer(const ScopedTimer&) = delete;
+			ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		private:
+			Recorder& TraceRecorder;
+			std::string Name;
+			const char* pCategory;
+			Clock::duration& Total;
+			Clock::time_point Begin;
+		};
+	}
+}
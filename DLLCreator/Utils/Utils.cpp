@@ -1,7 +1,14 @@
 #include "Utils.h"
+#include "ByteSearch.h" /* FindByte, FindSubstring, FindByteUnbounded */
 
 #include <iostream> /* std::cin */
 #include <assert.h> /* assert() */
+#include <limits> /* std::numeric_limits */
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN /* Exclude rarely-used stuff from Windows headers */
+#include <Windows.h> /* for ClearConsole() */
+#endif
 
 #undef max
 
@@ -52,6 +59,7 @@ namespace Utils
 		/* MSDN: https://docs.microsoft.com/en-us/windows/console/scrolling-a-screen-buffer-s-contents */
 		void ClearConsole()
 		{
+#ifdef _WIN32
 			COORD topLeft = { 0, 0 };
 			HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
 			CONSOLE_SCREEN_BUFFER_INFO screen;
@@ -65,6 +73,10 @@ namespace Utils
 				screen.dwSize.X * screen.dwSize.Y, topLeft, &written
 			);
 			SetConsoleCursorPosition(console, topLeft);
+#else
+			/* Erase the screen and move the cursor to the top left corner */
+			std::cout << "\x1B[2J\x1B[H" << std::flush;
+#endif
 		}
 
 		std::string ReadUserInput()
@@ -83,143 +95,76 @@ namespace Utils
 			return input == wantedInput;
 		}
 
-		int StringCompare(const char* const pString, const char* const pOtherString, const char delimiter)
+		namespace
 		{
-			assert(pString != nullptr);
-			assert(pOtherString != nullptr);
+			template<typename Char>
+			bool IsStringEnd(const Char c, const char delimiter)
+			{
+				return c == Char{} || c == static_cast<Char>(delimiter);
+			}
 
-			int counter{};
-			while (true)
+			/* Stops at the first difference or at the end of either string, so neither string is read past its end */
+			template<typename Char>
+			int CompareStrings(const Char* const pString, const Char* const pOtherString, const char delimiter)
 			{
-				if (pString[counter] != '\0' && pString[counter] != delimiter)
+				assert(pString != nullptr && "Utils::IO::StringCompare() > pString is a nullptr");
+				assert(pOtherString != nullptr && "Utils::IO::StringCompare() > pOtherString is a nullptr");
+
+				for (size_t i{};; ++i)
 				{
-					if (pOtherString[counter] == '\0' || pOtherString[counter] == delimiter)
-					{
-						return 1;
-					}
+					const bool bIsEnd(IsStringEnd(pString[i], delimiter));
+					const bool bIsOtherEnd(IsStringEnd(pOtherString[i], delimiter));
 
-					if (pOtherString[counter] > pString[counter])
+					if (bIsEnd || bIsOtherEnd)
 					{
-						return -1;
+						return bIsEnd == bIsOtherEnd ? 0 : (bIsEnd ? -1 : 1);
 					}
 
-					if (pString[counter] > pOtherString[counter])
+					if (pString[i] != pOtherString[i])
 					{
-						return 1;
+						return static_cast<BYTE>(pString[i]) > static_cast<BYTE>(pOtherString[i]) ? 1 : -1;
 					}
 				}
+			}
 
-				++counter;
+			const BYTE* AsBytes(const char* const pString)
+			{
+				return reinterpret_cast<const BYTE*>(pString);
 			}
+		}
 
-			return 0;
+		int StringCompare(const char* const pString, const char* const pOtherString, const char delimiter)
+		{
+			return CompareStrings(pString, pOtherString, delimiter);
 		}
 
 		int StringCompare(const BYTE* const pString, const BYTE* const pOtherString, const char delimiter)
 		{
-			assert(pString != nullptr);
-			assert(pOtherString != nullptr);
-
-			int counter{};
-			while (true)
-			{
-				if (pString[counter] != '\0' && pString[counter] != delimiter)
-				{
-					if (pOtherString[counter] == '\0' || pOtherString[counter] == delimiter)
-					{
-						return 1;
-					}
-
-					if (pOtherString[counter] > pString[counter])
-					{
-						return -1;
-					}
-
-					if (pString[counter] > pOtherString[counter])
-					{
-						return 1;
-					}
-				}
-
-				++counter;
-			}
-
-			return 0;
+			return CompareStrings(pString, pOtherString, delimiter);
 		}
 
-		/* https://stackoverflow.com/questions/18680118/own-implementation-of-stdstringfind-brute-force-search */
 		bool StringContains(const char* const pString, const char* const pOtherString, const char delimiter)
 		{
-			assert(pString != nullptr);
-			assert(pOtherString != nullptr);
-
-			size_t stringLen = StringLength(pString, delimiter);
-			size_t otherStringLen = StringLength(pOtherString, delimiter);
-
-			for (size_t i = 0; i <= stringLen - otherStringLen; ++i)
-			{
-				size_t j{};
-				while (j < otherStringLen && pString[i + j] == pOtherString[j])
-				{
-					++j;
-				}
-
-				/* match found */
-				if (j == otherStringLen)
-				{
-					return true;
-				}
-			}
-
-			return false;
+			return StringContains(AsBytes(pString), AsBytes(pOtherString), static_cast<BYTE>(delimiter));
 		}
 
 		bool StringContains(const BYTE* const pString, const BYTE* const pOtherString, const BYTE delimiter)
 		{
-			assert(pString != nullptr);
-			assert(pOtherString != nullptr);
-
-			size_t stringLen = StringLength(pString, delimiter);
-			size_t otherStringLen = StringLength(pOtherString, delimiter);
+			assert(pString != nullptr && "Utils::IO::StringContains() > pString is a nullptr");
+			assert(pOtherString != nullptr && "Utils::IO::StringContains() > pOtherString is a nullptr");
 
-			for (size_t i = 0; i <= stringLen - otherStringLen; ++i)
-			{
-				size_t j{};
-				while (j < otherStringLen && pString[i + j] == pOtherString[j])
-				{
-					++j;
-				}
-
-				/* match found */
-				if (j == otherStringLen)
-				{
-					return true;
-				}
-			}
-
-			return false;
+			/* A longer pOtherString is simply not found */
+			return FindSubstring(pString, StringLength(pString, delimiter), pOtherString, StringLength(pOtherString, delimiter)) != NotFound;
 		}
 
 		size_t StringLength(const char* const pString, const char delimiter)
 		{
-			size_t counter{};
-			while (pString[counter] != delimiter)
-			{
-				++counter;
-			}
-
-			return counter;
+			return FindByteUnbounded(AsBytes(pString), static_cast<BYTE>(delimiter));
 		}
 
 		size_t StringLength(const BYTE* const pString, const BYTE delimiter)
 		{
-			size_t counter{};
-			while (pString[counter] != delimiter)
-			{
-				++counter;
-			}
-
-			return counter;
+			return FindByteUnbounded(pString, delimiter);
 		}
 
 		bool StringCopy(char* pDest, const char* pSource, const size_t count)
@@ -257,46 +202,16 @@ namespace Utils
 			assert(pDest != nullptr && "Utils::IO::StringFind() > pDest is a nullptr");
 			assert(pOtherString != nullptr && "Utils::IO::StringFind() > pOtherString is a nullptr");
 
-			const size_t strLen(StringLength(pDest, delimiter));
-			const size_t otherStrLen(StringLength(pOtherString, delimiter));
-
-			assert(strLen >= otherStrLen && "Utils::IO::StringFind() > pDest must be larger or equal to pOtherString!");
-
-			for (size_t i{}; i < strLen; ++i)
-			{
-				if (pDest[i] != delimiter)
-				{
-					if (pDest[i] == pOtherString[i])
-					{
-						if (StringCompare(pDest, pOtherString, delimiter) == 0)
-						{
-							return static_cast<DWORD>(i);
-						}
-					}
-				}
-			}
-
-			return std::numeric_limits<DWORD>::max();
+			const size_t index(FindSubstring(pDest, StringLength(pDest, delimiter), pOtherString, StringLength(pOtherString, delimiter)));
+			return index != NotFound ? static_cast<DWORD>(index) : std::numeric_limits<DWORD>::max();
 		}
 
 		DWORD StringFind(const BYTE* pDest, const BYTE charToFind, const BYTE delimiter)
 		{
 			assert(pDest != nullptr && "Utils::IO::StringFind() > pDest is a nullptr");
 
-			const size_t strLen(StringLength(pDest, delimiter));
-
-			for (size_t i{}; i < strLen; ++i)
-			{
-				if (pDest[i] != delimiter)
-				{
-					if (pDest[i] == charToFind)
-					{
-						return static_cast<DWORD>(i);
-					}
-				}
-			}
-
-			return std::numeric_limits<DWORD>::max();
+			const size_t index(FindByte(pDest, StringLength(pDest, delimiter), charToFind));
+			return index != NotFound ? static_cast<DWORD>(index) : std::numeric_limits<DWORD>::max();
 		}
 	}
 }
\ No newline at end of file
@@ -1,12 +1,12 @@
 #pragma once
 
-/* This has to be placed in the header sadly enough */
-#define WIN32_LEAN_AND_MEAN /* Exclude rarely-used stuff from Windows headers */
-#include <Windows.h> /* for ClearConsole() */
-
 #include <string> /* std::string */
 #include <memory> /* std::unique_ptr */
 
+/* These used to come from <Windows.h>, which is now only included by the Windows specific translation units */
+typedef unsigned char BYTE;
+typedef unsigned long DWORD;
+
 namespace Utils
 {
 	namespace IO
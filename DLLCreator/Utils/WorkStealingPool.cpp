@@ -0,0 +1,153 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm> /* std::max */
+#include <utility> /* std::move */
+
+namespace Utils
+{
+	namespace
+	{
+		/* Lets Submit() know whether it is called from one of the workers, and which one */
+		thread_local const WorkStealingPool* pCurrentPool{};
+		thread_local size_t CurrentWorker{};
+	}
+
+	WorkStealingPool::WorkStealingPool(size_t nrOfThreads)
+	{
+		if (nrOfThreads == 0)
+		{
+			/* hardware_concurrency() is allowed to return 0 when it does not know */
+			nrOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+
+		Queues.reserve(nrOfThreads);
+		Workers.reserve(nrOfThreads);
+
+		for (size_t i{}; i < nrOfThreads; ++i)
+		{
+			Queues.push_back(std::make_unique<Queue>());
+		}
+
+		/* Every queue has to exist before the first worker starts stealing */
+		for (size_t i{}; i < nrOfThreads; ++i)
+		{
+			Workers.emplace_back(&WorkStealingPool::WorkerLoop, this, i);
+		}
+	}
+
+	WorkStealingPool::~WorkStealingPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(Mutex);
+			bIsStopping = true;
+		}
+
+		JobAvailable.notify_all();
+
+		for (std::thread& worker : Workers)
+		{
+			worker.join();
+		}
+	}
+
+	void WorkStealingPool::Submit(std::function<void()> job)
+	{
+		const size_t queue(pCurrentPool == this ? CurrentWorker : NextQueue++ % Queues.size());
+
+		NrOfUnfinishedJobs.fetch_add(1);
+
+		{
+			/* Counted under the lock the workers sleep on, so a worker can not miss the wake-up.
+			Counting before pushing means the count never drops below the real number of queued jobs */
+			const std::lock_guard<std::mutex> lock(Mutex);
+			NrOfQueuedJobs.fetch_add(1);
+		}
+
+		{
+			const std::lock_guard<std::mutex> lock(Queues[queue]->Mutex);
+			Queues[queue]->Jobs.push_back(std::move(job));
+		}
+
+		JobAvailable.notify_one();
+	}
+
+	void WorkStealingPool::Wait()
+	{
+		std::unique_lock<std::mutex> lock(Mutex);
+		AllJobsDone.wait(lock, [this]()->bool
+			{
+				return NrOfUnfinishedJobs.load() == 0;
+			});
+	}
+
+	void WorkStealingPool::WorkerLoop(const size_t worker)
+	{
+		pCurrentPool = this;
+		CurrentWorker = worker;
+
+		while (true)
+		{
+			std::function<void()> job{};
+
+			if (!TryPop(worker, job))
+			{
+				std::unique_lock<std::mutex> lock(Mutex);
+				JobAvailable.wait(lock, [this]()->bool
+					{
+						return bIsStopping || NrOfQueuedJobs.load() != 0;
+					});
+
+				/* Only stop once every queue has been drained, so no submitted job gets lost */
+				if (bIsStopping && NrOfQueuedJobs.load() == 0)
+				{
+					return;
+				}
+
+				continue;
+			}
+
+			job();
+
+			if (NrOfUnfinishedJobs.fetch_sub(1) == 1)
+			{
+				/* Take the lock so Wait() can not check the count and go to sleep in between */
+				const std::lock_guard<std::mutex> lock(Mutex);
+				AllJobsDone.notify_all();
+			}
+		}
+	}
+
+	bool WorkStealingPool::TryPop(const size_t worker, std::function<void()>& job)
+	{
+		/* Own queue first, newest job first: those are the ones whose data is still in the cache */
+		{
+			Queue& queue(*Queues[worker]);
+			const std::lock_guard<std::mutex> lock(queue.Mutex);
+
+			if (!queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				NrOfQueuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		/* Steal the oldest job of another worker, those tend to be the big ones (close to the root of the tree) */
+		for (size_t i{ 1 }; i < Queues.size(); ++i)
+		{
+			Queue& queue(*Queues[(worker + i) % Queues.size()]);
+			const std::lock_guard<std::mutex> lock(queue.Mutex);
+
+			if (!queue.Jobs.empty())
+			{
+				job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				NrOfQueuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic> /* std::atomic */
+#include <condition_variable> /* std::condition_variable */
+#include <cstddef> /* size_t */
+#include <deque> /* std::deque */
+#include <functional> /* std::function */
+#include <memory> /* std::unique_ptr */
+#include <mutex> /* std::mutex */
+#include <thread> /* std::thread */
+#include <vector> /* std::vector */
+
+namespace Utils
+{
+	/* Worker threads that each own a queue. Meant for jobs that spawn more jobs (e.g. one job per folder of a tree):
+	a job submitted from a worker goes on that worker's own queue, which it works through newest first,
+	while idle workers steal the oldest jobs of the others. Unlike ThreadPool, jobs run in no particular order */
+	class WorkStealingPool final
+	{
+	public:
+		/* 0 threads means one per hardware thread */
+		explicit WorkStealingPool(size_t nrOfThreads = 0);
+		~WorkStealingPool();
+
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool(WorkStealingPool&&) noexcept = delete;
+		WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+		WorkStealingPool& operator=(WorkStealingPool&&) noexcept = delete;
+
+		/* Can be called from any thread, including from inside a job */
+		void Submit(std::function<void()> job);
+
+		/* Blocks until every submitted job has finished, including the jobs those jobs submitted.
+		Must not be called from inside a job */
+		void Wait();
+
+		size_t GetNumberOfThreads() const { return Workers.size(); }
+
+	private:
+		struct Queue final
+		{
+			std::mutex Mutex{};
+			std::deque<std::function<void()>> Jobs{};
+		};
+
+		void WorkerLoop(const size_t worker);
+		bool TryPop(const size_t worker, std::function<void()>& job);
+
+		std::vector<std::unique_ptr<Queue>> Queues{};
+		std::vector<std::thread> Workers{};
+		std::mutex Mutex{}; /* only guards sleeping and waking up, never a queue */
+		std::condition_variable JobAvailable{};
+		std::condition_variable AllJobsDone{};
+		std::atomic<size_t> NrOfQueuedJobs{};
+		std::atomic<size_t> NrOfUnfinishedJobs{};
+		std::atomic<size_t> NextQueue{}; /* spreads jobs submitted from outside the pool */
+		bool bIsStopping{};
+	};
+}
@@ -1,12 +1,125 @@
 #include "DLLCreator/DLLCreator.h"
+#include "DLLCreator/Solution.h"
+#include "Utils/FileIO.h"
+#include "Utils/Trace.h"
 
 #include <iostream>
-#include <vld.h>
 #include <filesystem> 
+#include <algorithm> /* std::max */
+#include <cstdlib> /* std::atoi */
+
+/* Visual Leak Detector is only available on Windows */
+#if defined(_WIN32) && __has_include(<vld.h>)
+#include <vld.h>
+#endif
 
 int main(int argc, char* argv[])
 {
-	if (argc >= 2)
+	/* Every written file gets flushed to disk once, at the end of the run, unless asked not to */
+	bool bSyncWrites(true);
+	/* Where the Chrome trace of the run goes, nowhere unless asked for */
+	std::string tracePath{};
+	/* How many compile jobs the CMake builds may run, 0 lets the cores and the memory decide */
+	size_t nrOfBuildJobs{};
+
+	/* These work with every command line, at the end of it and in any order */
+	while (argc >= 2)
+	{
+		if (std::string(argv[argc - 1]) == "--no-sync")
+		{
+			bSyncWrites = false;
+			--argc;
+		}
+		else if (argc >= 3 && std::string(argv[argc - 2]) == "--trace")
+		{
+			tracePath = argv[argc - 1];
+			argc -= 2;
+		}
+		else if (argc >= 3 && std::string(argv[argc - 2]) == "--build-jobs")
+		{
+			nrOfBuildJobs = static_cast<size_t>(std::max(std::atoi(argv[argc - 1]), 0));
+			argc -= 2;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	Utils::Trace::Recorder trace{};
+	Utils::Trace::Clock::duration syncTime{};
+
+	if (!tracePath.empty())
+	{
+		trace.Enable("DLLCreator");
+	}
+
+	int exitCode{};
+
+	if (argc >= 3 && std::string(argv[1]) == "--manifest")
+	{
+		DLL::Manifest manifest{};
+		std::string error{};
+
+		if (!DLL::Manifest::Load(argv[2], manifest, error))
+		{
+			std::cout << "Could not load the manifest: " << error << "\n";
+			return 1;
+		}
+
+		std::cout << "INPUT: " << manifest.RootPath << "\n";
+		std::cout << "OUTPUT: " << manifest.OutputPath << "\n";
+
+		DLL::DLLCreator dll(manifest);
+		const DLL::BuildSettings build(nrOfBuildJobs, 1);
+
+		if (trace.IsEnabled())
+		{
+			dll.EnableTrace();
+		}
+
+		if (!dll.Convert(build))
+		{
+			exitCode = 1;
+		}
+
+		trace.Append(dll.GetTrace());
+	}
+	else if (argc >= 3 && std::string(argv[1]) == "--solution")
+	{
+		DLL::Solution solution{};
+		std::string error{};
+
+		if (!DLL::Solution::Load(argv[2], solution, error))
+		{
+			std::cout << "Could not load the solution: " << error << "\n";
+			return 1;
+		}
+
+		size_t nrOfThreads{}, nrOfCMakeRuns{};
+
+		for (int i{ 3 }; i + 1 < argc; i += 2)
+		{
+			const size_t value(static_cast<size_t>(std::max(std::atoi(argv[i + 1]), 0)));
+
+			if (std::string(argv[i]) == "--jobs")
+			{
+				nrOfThreads = value;
+			}
+			else if (std::string(argv[i]) == "--cmake-jobs")
+			{
+				nrOfCMakeRuns = value;
+			}
+		}
+
+		std::cout << "INPUT: " << argv[2] << "\n";
+
+		if (!solution.Convert(nrOfThreads, nrOfCMakeRuns, nrOfBuildJobs, trace))
+		{
+			exitCode = 1;
+		}
+	}
+	else if (argc >= 2)
 	{
 		std::string input{};
 		std::string output{};
@@ -42,8 +155,19 @@ int main(int argc, char* argv[])
 		std::cout << "OUTPUT: " << output << "\n";
 
 		DLL::DLLCreator dll(input, output);
+		const DLL::BuildSettings build(nrOfBuildJobs, 1);
 
-		dll.Convert();
+		if (trace.IsEnabled())
+		{
+			dll.EnableTrace();
+		}
+
+		if (!dll.Convert(build))
+		{
+			exitCode = 1;
+		}
+
+		trace.Append(dll.GetTrace());
 	}
 	else
 	{
@@ -51,5 +175,34 @@ int main(int argc, char* argv[])
 		std::cout << "DLLCreator.exe -I -O\n";
 		std::cout << "-I is the path to the Visual Studio root folder to be converted.\n";
 		std::cout << "-O is the optional path to the output folder\n";
+		std::cout << "\nOr, to convert without any questions being asked:\n";
+		std::cout << "DLLCreator.exe --manifest <PATH-TO-MANIFEST>\n";
+		std::cout << "The manifest is a JSON file containing every answer, see README.txt\n";
+		std::cout << "\nOr, to convert every project of a solution at once:\n";
+		std::cout << "DLLCreator.exe --solution <PATH-TO-SLN-OR-FOLDER> --jobs <NUMBER-OF-THREADS> --cmake-jobs <NUMBER-OF-CMAKE-RUNS>\n";
+		std::cout << "Every project uses the DLLCreator.json manifest next to its .vcxproj, --jobs and --cmake-jobs are optional\n";
+		std::cout << "\n--no-sync at the end of any command line skips flushing the written files to disk\n";
+		std::cout << "--trace <PATH-TO-JSON> at the end of any command line writes a Chrome trace of the conversion, see README.txt\n";
+		std::cout << "--build-jobs <NUMBER-OF-JOBS> at the end of any command line is how many compile jobs the CMake builds may run together\n";
 	}
+
+	if (bSyncWrites)
+	{
+		const Utils::Trace::ScopedTimer timer(trace, "Sync", "io", syncTime);
+
+		if (!Utils::IO::SyncWrittenFiles())
+		{
+			std::cout << "Not every written file could be flushed to disk\n";
+			exitCode = 1;
+		}
+	}
+
+	/* Written last so the flush is part of it, the trace itself is never flushed */
+	if (trace.IsEnabled() && !Utils::IO::WriteFile(tracePath, trace.WriteChromeTrace()))
+	{
+		std::cout << "Could not write the trace to " << tracePath << "\n";
+		exitCode = 1;
+	}
+
+	return exitCode;
 }
\ No newline at end of file